@@ -0,0 +1,129 @@
+// acceleration_curve.cpp
+// Implementation for pointer acceleration curves
+
+#include "acceleration_curve.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+float samplePoints(const std::vector<AccelerationPoint>& points, float x) {
+    // The curve starts at the origin and stays flat after the last point
+    float previous_input = 0.0f;
+    float previous_output = 0.0f;
+    for (const AccelerationPoint& point : points) {
+        if (x <= point.input) {
+            float span = point.input - previous_input;
+            if (span <= 0.0f) {
+                return point.output;
+            }
+            return previous_output + (point.output - previous_output) * (x - previous_input) / span;
+        }
+        previous_input = point.input;
+        previous_output = point.output;
+    }
+    return previous_output;
+}
+
+float bezierComponent(float p1, float p2, float t) {
+    float u = 1.0f - t;
+    return 3.0f * u * u * t * p1 + 3.0f * u * t * t * p2 + t * t * t;
+}
+
+float sampleBezier(const AccelerationCurve& curve, float x) {
+    // x(t) is monotonic while both control x values are in 0..1, so bisect for t
+    float x1 = std::clamp(curve.control1_x, 0.0f, 1.0f);
+    float x2 = std::clamp(curve.control2_x, 0.0f, 1.0f);
+    float low = 0.0f;
+    float high = 1.0f;
+    for (int i = 0; i < 24; ++i) {
+        float mid = (low + high) * 0.5f;
+        if (bezierComponent(x1, x2, mid) < x) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return bezierComponent(curve.control1_y, curve.control2_y, (low + high) * 0.5f);
+}
+
+} // namespace
+
+AccelerationLut compileAccelerationCurve(const AccelerationCurve& curve) {
+    AccelerationLut lut;
+    for (int i = 0; i < kAccelerationLutSize; ++i) {
+        float x = static_cast<float>(i) / (kAccelerationLutSize - 1);
+        float y = x;
+        switch (curve.type) {
+            case AccelerationCurveType::POWER:
+                y = std::pow(x, std::max(curve.exponent, 0.1f));
+                break;
+            case AccelerationCurveType::POINTS:
+                if (!curve.points.empty()) {
+                    y = samplePoints(curve.points, x);
+                }
+                break;
+            case AccelerationCurveType::BEZIER:
+                y = sampleBezier(curve, x);
+                break;
+            case AccelerationCurveType::LINEAR:
+                break;
+        }
+        lut.speed[i] = std::clamp(y, 0.0f, 1.0f);
+    }
+    lut.ramp_time = std::max(curve.ramp_time, 0.0f);
+    lut.ramp_gain = std::max(curve.ramp_gain, 0.0f);
+    return lut;
+}
+
+const char* accelerationCurveTypeName(AccelerationCurveType type) {
+    switch (type) {
+        case AccelerationCurveType::POWER: return "power";
+        case AccelerationCurveType::POINTS: return "points";
+        case AccelerationCurveType::BEZIER: return "bezier";
+        default: return "linear";
+    }
+}
+
+AccelerationCurveType parseAccelerationCurveType(const std::string& name) {
+    if (name == "power") return AccelerationCurveType::POWER;
+    if (name == "points") return AccelerationCurveType::POINTS;
+    if (name == "bezier") return AccelerationCurveType::BEZIER;
+    return AccelerationCurveType::LINEAR;
+}
+
+bool parseAccelerationPoints(const std::string& text, std::vector<AccelerationPoint>& points) {
+    std::vector<AccelerationPoint> parsed;
+    const char* cursor = text.c_str();
+    while (true) {
+        while (*cursor == ' ') ++cursor;
+        if (*cursor == '\0') break;
+        char* end;
+        float input = std::strtof(cursor, &end);
+        if (end == cursor || *end != ':') return false;
+        cursor = end + 1;
+        float output = std::strtof(cursor, &end);
+        if (end == cursor || (*end != ' ' && *end != '\0')) return false;
+        cursor = end;
+        if (!std::isfinite(input) || !std::isfinite(output)) return false;
+        if (parsed.size() >= static_cast<size_t>(kAccelerationMaxPoints)) return false;
+        parsed.push_back({std::clamp(input, 0.0f, 1.0f), std::clamp(output, 0.0f, 1.0f)});
+    }
+    std::sort(parsed.begin(), parsed.end(),
+              [](const AccelerationPoint& a, const AccelerationPoint& b) { return a.input < b.input; });
+    points = std::move(parsed);
+    return true;
+}
+
+std::string formatAccelerationPoints(const std::vector<AccelerationPoint>& points) {
+    std::string text;
+    char buffer[32];
+    for (const AccelerationPoint& point : points) {
+        std::snprintf(buffer, sizeof(buffer), "%g:%g", point.input, point.output);
+        if (!text.empty()) text += ' ';
+        text += buffer;
+    }
+    return text;
+}
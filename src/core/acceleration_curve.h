@@ -0,0 +1,47 @@
+// acceleration_curve.h
+// Pointer acceleration curves compiled to lookup tables.
+// Curves are sampled once when a mapping is loaded; per-frame evaluation is a
+// table lookup and a linear interpolation, and the UI previews the same table.
+
+#pragma once
+
+#include "types.h"
+#include <string>
+#include <vector>
+
+// Samples over deflection 0..1; entry i is the speed at i / (kAccelerationLutSize - 1)
+constexpr int kAccelerationLutSize = 65;
+
+struct AccelerationLut {
+    float speed[kAccelerationLutSize];
+    float ramp_time;   // Seconds at full tilt to reach ramp_gain; 0 if there is no ramp
+    float ramp_gain;
+
+    // Speed (0..1 of full speed) for a deflection in 0..1
+    float evaluate(float deflection) const {
+        if (deflection <= 0.0f) return speed[0];
+        if (deflection >= 1.0f) return speed[kAccelerationLutSize - 1];
+        float position = deflection * (kAccelerationLutSize - 1);
+        int index = static_cast<int>(position);
+        float fraction = position - index;
+        return speed[index] + (speed[index + 1] - speed[index]) * fraction;
+    }
+
+    // Speed multiplier after holding the stick at full tilt for held_time seconds
+    float rampMultiplier(float held_time) const {
+        if (ramp_time <= 0.0f) return 1.0f;
+        float progress = held_time >= ramp_time ? 1.0f : held_time / ramp_time;
+        return 1.0f + (ramp_gain - 1.0f) * progress;
+    }
+};
+
+// Samples the curve into a table
+AccelerationLut compileAccelerationCurve(const AccelerationCurve& curve);
+
+const char* accelerationCurveTypeName(AccelerationCurveType type);
+AccelerationCurveType parseAccelerationCurveType(const std::string& name);
+
+// Points are written as "input:output" pairs separated by spaces, e.g. "0.5:0.2 1:1".
+// Parsing fails on malformed text or more than kAccelerationMaxPoints points.
+bool parseAccelerationPoints(const std::string& text, std::vector<AccelerationPoint>& points);
+std::string formatAccelerationPoints(const std::vector<AccelerationPoint>& points);
@@ -0,0 +1,348 @@
+// action_registry.h
+// Compile-time registry of every action a button can be mapped to.
+// Each entry ties the name used in mappings.json to its enum value, display
+// label and platform key codes. Name lookup goes through a perfect hash built
+// at compile time, so it costs one hash and one string compare for any key count.
+
+#pragma once
+
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+enum class ActionCategory {
+    MOUSE,
+    KEYBOARD,
+    MEDIA
+};
+
+struct ActionInfo {
+    std::string_view name;     // Name in mappings.json
+    std::string_view label;    // Label shown in the UI
+    ActionCategory category;
+    MouseClickType click_type;
+    KeyboardKeyType key_type;
+    uint16_t win_code;         // Windows virtual-key code
+    uint16_t linux_code;       // Linux input event code (KEY_* / BTN_*)
+};
+
+// Entries of each category are listed in UI order.
+inline constexpr ActionInfo kActions[] = {
+    {"mouse_left_click", "Left Click", ActionCategory::MOUSE, MouseClickType::LEFT_CLICK, KeyboardKeyType::NONE, 0x01, 272},
+    {"mouse_right_click", "Right Click", ActionCategory::MOUSE, MouseClickType::RIGHT_CLICK, KeyboardKeyType::NONE, 0x02, 273},
+    {"mouse_middle_click", "Middle Click", ActionCategory::MOUSE, MouseClickType::MIDDLE_CLICK, KeyboardKeyType::NONE, 0x04, 274},
+    {"mouse_back_click", "Back Button", ActionCategory::MOUSE, MouseClickType::BACK_CLICK, KeyboardKeyType::NONE, 0x05, 275},
+    {"mouse_forward_click", "Forward Button", ActionCategory::MOUSE, MouseClickType::FORWARD_CLICK, KeyboardKeyType::NONE, 0x06, 276},
+    {"keyboard_enter", "Enter", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::ENTER, 0x0D, 28},
+    {"keyboard_escape", "Escape", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::ESCAPE, 0x1B, 1},
+    {"keyboard_tab", "Tab", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::TAB, 0x09, 15},
+    {"keyboard_space", "Space", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::SPACE, 0x20, 57},
+    {"keyboard_up", "Up", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::UP, 0x26, 103},
+    {"keyboard_down", "Down", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::DOWN, 0x28, 108},
+    {"keyboard_left", "Left", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::LEFT, 0x25, 105},
+    {"keyboard_right", "Right", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::RIGHT, 0x27, 106},
+    {"keyboard_alt", "Alt", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::ALT, 0x12, 56},
+    {"keyboard_ctrl", "Ctrl", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::CTRL, 0x11, 29},
+    {"keyboard_shift", "Shift", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::SHIFT, 0x10, 42},
+    {"keyboard_f1", "F1", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F1, 0x70, 59},
+    {"keyboard_f2", "F2", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F2, 0x71, 60},
+    {"keyboard_f3", "F3", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F3, 0x72, 61},
+    {"keyboard_f4", "F4", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F4, 0x73, 62},
+    {"keyboard_f5", "F5", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F5, 0x74, 63},
+    {"keyboard_f6", "F6", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F6, 0x75, 64},
+    {"keyboard_f7", "F7", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F7, 0x76, 65},
+    {"keyboard_f8", "F8", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F8, 0x77, 66},
+    {"keyboard_f9", "F9", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F9, 0x78, 67},
+    {"keyboard_f10", "F10", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F10, 0x79, 68},
+    {"keyboard_f11", "F11", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F11, 0x7A, 87},
+    {"keyboard_f12", "F12", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F12, 0x7B, 88},
+    {"keyboard_f13", "F13", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F13, 0x7C, 183},
+    {"keyboard_f14", "F14", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F14, 0x7D, 184},
+    {"keyboard_f15", "F15", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F15, 0x7E, 185},
+    {"keyboard_f16", "F16", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F16, 0x7F, 186},
+    {"keyboard_f17", "F17", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F17, 0x80, 187},
+    {"keyboard_f18", "F18", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F18, 0x81, 188},
+    {"keyboard_f19", "F19", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F19, 0x82, 189},
+    {"keyboard_f20", "F20", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F20, 0x83, 190},
+    {"keyboard_f21", "F21", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F21, 0x84, 191},
+    {"keyboard_f22", "F22", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F22, 0x85, 192},
+    {"keyboard_f23", "F23", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F23, 0x86, 193},
+    {"keyboard_f24", "F24", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F24, 0x87, 194},
+    {"keyboard_a", "A", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::A, 0x41, 30},
+    {"keyboard_b", "B", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::B, 0x42, 48},
+    {"keyboard_c", "C", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::C, 0x43, 46},
+    {"keyboard_d", "D", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::D, 0x44, 32},
+    {"keyboard_e", "E", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::E, 0x45, 18},
+    {"keyboard_f", "F", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::F, 0x46, 33},
+    {"keyboard_g", "G", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::G, 0x47, 34},
+    {"keyboard_h", "H", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::H, 0x48, 35},
+    {"keyboard_i", "I", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::I, 0x49, 23},
+    {"keyboard_j", "J", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::J, 0x4A, 36},
+    {"keyboard_k", "K", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::K, 0x4B, 37},
+    {"keyboard_l", "L", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::L, 0x4C, 38},
+    {"keyboard_m", "M", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::M, 0x4D, 50},
+    {"keyboard_n", "N", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::N, 0x4E, 49},
+    {"keyboard_o", "O", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::O, 0x4F, 24},
+    {"keyboard_p", "P", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::P, 0x50, 25},
+    {"keyboard_q", "Q", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::Q, 0x51, 16},
+    {"keyboard_r", "R", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::R, 0x52, 19},
+    {"keyboard_s", "S", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::S, 0x53, 31},
+    {"keyboard_t", "T", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::T, 0x54, 20},
+    {"keyboard_u", "U", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::U, 0x55, 22},
+    {"keyboard_v", "V", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::V, 0x56, 47},
+    {"keyboard_w", "W", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::W, 0x57, 17},
+    {"keyboard_x", "X", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::X, 0x58, 45},
+    {"keyboard_y", "Y", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::Y, 0x59, 21},
+    {"keyboard_z", "Z", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::Z, 0x5A, 44},
+    {"keyboard_0", "0", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::DIGIT_0, 0x30, 11},
+    {"keyboard_1", "1", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::DIGIT_1, 0x31, 2},
+    {"keyboard_2", "2", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::DIGIT_2, 0x32, 3},
+    {"keyboard_3", "3", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::DIGIT_3, 0x33, 4},
+    {"keyboard_4", "4", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::DIGIT_4, 0x34, 5},
+    {"keyboard_5", "5", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::DIGIT_5, 0x35, 6},
+    {"keyboard_6", "6", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::DIGIT_6, 0x36, 7},
+    {"keyboard_7", "7", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::DIGIT_7, 0x37, 8},
+    {"keyboard_8", "8", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::DIGIT_8, 0x38, 9},
+    {"keyboard_9", "9", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::DIGIT_9, 0x39, 10},
+    {"keyboard_minus", "-", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::MINUS, 0xBD, 12},
+    {"keyboard_equal", "=", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::EQUAL, 0xBB, 13},
+    {"keyboard_left_bracket", "[", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::LEFT_BRACKET, 0xDB, 26},
+    {"keyboard_right_bracket", "]", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::RIGHT_BRACKET, 0xDD, 27},
+    {"keyboard_backslash", "\\", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::BACKSLASH, 0xDC, 43},
+    {"keyboard_semicolon", ";", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::SEMICOLON, 0xBA, 39},
+    {"keyboard_apostrophe", "'", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::APOSTROPHE, 0xDE, 40},
+    {"keyboard_grave", "`", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::GRAVE, 0xC0, 41},
+    {"keyboard_comma", ",", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::COMMA, 0xBC, 51},
+    {"keyboard_period", ".", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::PERIOD, 0xBE, 52},
+    {"keyboard_slash", "/", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::SLASH, 0xBF, 53},
+    {"keyboard_backspace", "Backspace", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::BACKSPACE, 0x08, 14},
+    {"keyboard_delete", "Delete", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::DEL, 0x2E, 111},
+    {"keyboard_insert", "Insert", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::INSERT, 0x2D, 110},
+    {"keyboard_home", "Home", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::HOME, 0x24, 102},
+    {"keyboard_end", "End", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::END, 0x23, 107},
+    {"keyboard_page_up", "Page Up", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::PAGE_UP, 0x21, 104},
+    {"keyboard_page_down", "Page Down", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::PAGE_DOWN, 0x22, 109},
+    {"keyboard_caps_lock", "Caps Lock", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::CAPS_LOCK, 0x14, 58},
+    {"keyboard_num_lock", "Num Lock", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUM_LOCK, 0x90, 69},
+    {"keyboard_scroll_lock", "Scroll Lock", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::SCROLL_LOCK, 0x91, 70},
+    {"keyboard_print_screen", "Print Screen", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::PRINT_SCREEN, 0x2C, 99},
+    {"keyboard_pause", "Pause", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::PAUSE, 0x13, 119},
+    {"keyboard_menu", "Menu", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::MENU, 0x5D, 127},
+    {"keyboard_left_meta", "Left Win/Super", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::LEFT_META, 0x5B, 125},
+    {"keyboard_right_meta", "Right Win/Super", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::RIGHT_META, 0x5C, 126},
+    {"keyboard_right_alt", "Right Alt", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::RIGHT_ALT, 0xA5, 100},
+    {"keyboard_right_ctrl", "Right Ctrl", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::RIGHT_CTRL, 0xA3, 97},
+    {"keyboard_right_shift", "Right Shift", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::RIGHT_SHIFT, 0xA1, 54},
+    {"keyboard_numpad_0", "Numpad 0", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_0, 0x60, 82},
+    {"keyboard_numpad_1", "Numpad 1", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_1, 0x61, 79},
+    {"keyboard_numpad_2", "Numpad 2", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_2, 0x62, 80},
+    {"keyboard_numpad_3", "Numpad 3", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_3, 0x63, 81},
+    {"keyboard_numpad_4", "Numpad 4", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_4, 0x64, 75},
+    {"keyboard_numpad_5", "Numpad 5", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_5, 0x65, 76},
+    {"keyboard_numpad_6", "Numpad 6", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_6, 0x66, 77},
+    {"keyboard_numpad_7", "Numpad 7", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_7, 0x67, 71},
+    {"keyboard_numpad_8", "Numpad 8", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_8, 0x68, 72},
+    {"keyboard_numpad_9", "Numpad 9", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_9, 0x69, 73},
+    {"keyboard_numpad_add", "Numpad +", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_ADD, 0x6B, 78},
+    {"keyboard_numpad_subtract", "Numpad -", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_SUBTRACT, 0x6D, 74},
+    {"keyboard_numpad_multiply", "Numpad *", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_MULTIPLY, 0x6A, 55},
+    {"keyboard_numpad_divide", "Numpad /", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_DIVIDE, 0x6F, 98},
+    {"keyboard_numpad_decimal", "Numpad .", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_DECIMAL, 0x6E, 83},
+    {"keyboard_numpad_enter", "Numpad Enter", ActionCategory::KEYBOARD, MouseClickType::NONE, KeyboardKeyType::NUMPAD_ENTER, 0x0D, 96},
+    {"media_volume_up", "Volume Up", ActionCategory::MEDIA, MouseClickType::NONE, KeyboardKeyType::VOLUME_UP, 0xAF, 115},
+    {"media_volume_down", "Volume Down", ActionCategory::MEDIA, MouseClickType::NONE, KeyboardKeyType::VOLUME_DOWN, 0xAE, 114},
+    {"media_volume_mute", "Mute", ActionCategory::MEDIA, MouseClickType::NONE, KeyboardKeyType::VOLUME_MUTE, 0xAD, 113},
+    {"media_play_pause", "Play/Pause", ActionCategory::MEDIA, MouseClickType::NONE, KeyboardKeyType::MEDIA_PLAY_PAUSE, 0xB3, 164},
+    {"media_next", "Next Track", ActionCategory::MEDIA, MouseClickType::NONE, KeyboardKeyType::MEDIA_NEXT, 0xB0, 163},
+    {"media_previous", "Previous Track", ActionCategory::MEDIA, MouseClickType::NONE, KeyboardKeyType::MEDIA_PREVIOUS, 0xB1, 165},
+    {"media_stop", "Stop", ActionCategory::MEDIA, MouseClickType::NONE, KeyboardKeyType::MEDIA_STOP, 0xB2, 166},
+    {"media_browser_back", "Browser Back", ActionCategory::MEDIA, MouseClickType::NONE, KeyboardKeyType::BROWSER_BACK, 0xA6, 158},
+    {"media_browser_forward", "Browser Forward", ActionCategory::MEDIA, MouseClickType::NONE, KeyboardKeyType::BROWSER_FORWARD, 0xA7, 159},
+    {"media_browser_refresh", "Browser Refresh", ActionCategory::MEDIA, MouseClickType::NONE, KeyboardKeyType::BROWSER_REFRESH, 0xA8, 173},
+    {"media_browser_home", "Browser Home", ActionCategory::MEDIA, MouseClickType::NONE, KeyboardKeyType::BROWSER_HOME, 0xAC, 172},
+};
+
+inline constexpr size_t kActionCount = sizeof(kActions) / sizeof(kActions[0]);
+
+namespace action_registry_detail {
+
+// FNV-1a over the name; computed once per lookup
+constexpr uint32_t hashName(std::string_view name) {
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Re-mixes a name hash with a bucket seed to pick a slot
+constexpr uint32_t slotHash(uint32_t hash, uint32_t seed) {
+    hash ^= seed * 0x9E3779B9u;
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+constexpr size_t kBucketCount = 64;
+constexpr size_t kSlotCount = 256;
+constexpr size_t kMaxBucketSize = 16;
+constexpr uint8_t kEmptySlot = 0xFF;
+static_assert(kActionCount < kEmptySlot, "Action index must fit in a slot");
+
+// Hash-and-displace table: a name's bucket picks a seed, and the seeded hash
+// picks a slot holding the action index. Buckets are placed largest first.
+struct PerfectHash {
+    uint16_t seeds[kBucketCount] = {};
+    uint8_t slots[kSlotCount] = {};
+    bool valid = false;
+};
+
+constexpr PerfectHash buildPerfectHash() {
+    PerfectHash table;
+    for (size_t i = 0; i < kSlotCount; ++i) {
+        table.slots[i] = kEmptySlot;
+    }
+
+    // Group action indices by bucket (counting sort)
+    size_t bucket_sizes[kBucketCount] = {};
+    size_t bucket_of[kActionCount] = {};
+    uint32_t hashes[kActionCount] = {};
+    for (size_t i = 0; i < kActionCount; ++i) {
+        hashes[i] = hashName(kActions[i].name);
+        bucket_of[i] = hashes[i] % kBucketCount;
+        ++bucket_sizes[bucket_of[i]];
+    }
+    size_t bucket_start[kBucketCount + 1] = {};
+    for (size_t b = 0; b < kBucketCount; ++b) {
+        bucket_start[b + 1] = bucket_start[b] + bucket_sizes[b];
+    }
+    size_t members[kActionCount] = {};
+    size_t filled[kBucketCount] = {};
+    for (size_t i = 0; i < kActionCount; ++i) {
+        members[bucket_start[bucket_of[i]] + filled[bucket_of[i]]++] = i;
+    }
+
+    size_t order[kBucketCount] = {};
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        order[i] = i;
+    }
+    for (size_t i = 1; i < kBucketCount; ++i) {
+        for (size_t j = i; j > 0 && bucket_sizes[order[j]] > bucket_sizes[order[j - 1]]; --j) {
+            size_t tmp = order[j];
+            order[j] = order[j - 1];
+            order[j - 1] = tmp;
+        }
+    }
+
+    for (size_t b = 0; b < kBucketCount && bucket_sizes[order[b]] > 0; ++b) {
+        const size_t bucket = order[b];
+        const size_t first = bucket_start[bucket];
+        const size_t size = bucket_sizes[bucket];
+        if (size > kMaxBucketSize) return table;
+        bool placed = false;
+        for (uint32_t seed = 1; seed < 0xFFFF && !placed; ++seed) {
+            size_t chosen[kMaxBucketSize] = {};
+            bool fits = true;
+            for (size_t m = 0; m < size && fits; ++m) {
+                size_t slot = slotHash(hashes[members[first + m]], seed) % kSlotCount;
+                fits = table.slots[slot] == kEmptySlot;
+                for (size_t k = 0; k < m && fits; ++k) {
+                    fits = chosen[k] != slot;
+                }
+                chosen[m] = slot;
+            }
+            if (!fits) continue;
+            for (size_t m = 0; m < size; ++m) {
+                table.slots[chosen[m]] = static_cast<uint8_t>(members[first + m]);
+            }
+            table.seeds[bucket] = static_cast<uint16_t>(seed);
+            placed = true;
+        }
+        if (!placed) return table;
+    }
+    table.valid = true;
+    return table;
+}
+
+inline constexpr PerfectHash kNameHash = buildPerfectHash();
+static_assert(kNameHash.valid, "Action names do not fit the perfect hash table");
+
+// Reverse tables: enum value -> registry index
+struct EnumIndex {
+    uint8_t keys[static_cast<size_t>(KeyboardKeyType::COUNT)] = {};
+    uint8_t mouse[static_cast<size_t>(MouseClickType::FORWARD_CLICK) + 1] = {};
+};
+
+constexpr EnumIndex buildEnumIndex() {
+    EnumIndex index;
+    for (auto& k : index.keys) k = kEmptySlot;
+    for (auto& m : index.mouse) m = kEmptySlot;
+    for (size_t i = 0; i < kActionCount; ++i) {
+        if (kActions[i].click_type != MouseClickType::NONE) {
+            index.mouse[static_cast<size_t>(kActions[i].click_type)] = static_cast<uint8_t>(i);
+        } else {
+            index.keys[static_cast<size_t>(kActions[i].key_type)] = static_cast<uint8_t>(i);
+        }
+    }
+    return index;
+}
+
+inline constexpr EnumIndex kEnumIndex = buildEnumIndex();
+
+} // namespace action_registry_detail
+
+// Looks up an action by its mappings.json name. Returns nullptr for unknown names and "none".
+constexpr const ActionInfo* findAction(std::string_view name) {
+    using namespace action_registry_detail;
+    uint32_t hash = hashName(name);
+    uint32_t seed = kNameHash.seeds[hash % kBucketCount];
+    uint8_t index = kNameHash.slots[slotHash(hash, seed) % kSlotCount];
+    if (index == kEmptySlot || kActions[index].name != name) {
+        return nullptr;
+    }
+    return &kActions[index];
+}
+
+// Registry entry for a key or mouse button, or nullptr for NONE
+constexpr const ActionInfo* findAction(KeyboardKeyType key) {
+    using namespace action_registry_detail;
+    size_t value = static_cast<size_t>(key);
+    if (value >= sizeof(kEnumIndex.keys) || kEnumIndex.keys[value] == kEmptySlot) {
+        return nullptr;
+    }
+    return &kActions[kEnumIndex.keys[value]];
+}
+
+constexpr const ActionInfo* findAction(MouseClickType click) {
+    using namespace action_registry_detail;
+    size_t value = static_cast<size_t>(click);
+    if (value >= sizeof(kEnumIndex.mouse) || kEnumIndex.mouse[value] == kEmptySlot) {
+        return nullptr;
+    }
+    return &kActions[kEnumIndex.mouse[value]];
+}
+
+// Registry entry for a button action (mouse takes precedence), or nullptr if it does nothing
+constexpr const ActionInfo* findAction(const ButtonAction& action) {
+    return action.click_type != MouseClickType::NONE ? findAction(action.click_type) : findAction(action.key_type);
+}
+
+// Registry entries of one category, in UI order
+inline std::vector<const ActionInfo*> actionsInCategory(ActionCategory category) {
+    std::vector<const ActionInfo*> actions;
+    for (const auto& action : kActions) {
+        if (action.category == category) {
+            actions.push_back(&action);
+        }
+    }
+    return actions;
+}
+
+static_assert(findAction(std::string_view("keyboard_f12")) == findAction(KeyboardKeyType::F12), "Registry lookup mismatch");
+static_assert(findAction(std::string_view("none")) == nullptr, "\"none\" must not be a registered action");
@@ -0,0 +1,17 @@
+// clock.cpp
+// Implementation for the system clock
+
+#include "clock.h"
+#include <SDL3/SDL.h>
+
+namespace {
+class SdlClock : public Clock {
+public:
+    uint64_t nowNs() const override { return SDL_GetTicksNS(); }
+};
+}
+
+std::shared_ptr<Clock> systemClock() {
+    static const std::shared_ptr<Clock> clock = std::make_shared<SdlClock>();
+    return clock;
+}
@@ -0,0 +1,41 @@
+// clock.h
+// Monotonic time source for the core. All timing in the polling loop reads
+// the injected clock, so a simulated clock can drive it exactly.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+constexpr uint64_t kNsPerMs = 1000000;
+constexpr uint64_t kNsPerSecond = 1000000000;
+
+class Clock {
+public:
+    virtual ~Clock() = default;
+
+    // Nanoseconds since an arbitrary fixed point; never decreases
+    virtual uint64_t nowNs() const = 0;
+
+    uint64_t nowMs() const { return nowNs() / kNsPerMs; }
+};
+
+// SDL's monotonic clock, the time base of SDL event timestamps. Shared by
+// every core that is not given another clock.
+std::shared_ptr<Clock> systemClock();
+
+// Clock that moves only when told to, for simulating timing-dependent
+// behavior without waiting for it. Time may be read from any thread.
+class ManualClock : public Clock {
+public:
+    explicit ManualClock(uint64_t start_ns = 0) : m_now(start_ns) {}
+
+    uint64_t nowNs() const override { return m_now.load(std::memory_order_relaxed); }
+
+    void advance(uint64_t ns) { m_now.fetch_add(ns, std::memory_order_relaxed); }
+    void advanceMs(uint64_t ms) { advance(ms * kNsPerMs); }
+
+private:
+    std::atomic<uint64_t> m_now;
+};
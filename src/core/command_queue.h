@@ -0,0 +1,60 @@
+// command_queue.h
+// Lock-free multi-producer, single-consumer queue for handing work to the core thread
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+// Unbounded queue of linked nodes. Any thread may push; only the thread that
+// owns the queue may pop. A push is one atomic exchange and never waits for
+// the consumer. An item whose push has not finished linking its node is not
+// visible yet and is returned by a later pop.
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() {
+        Node* stub = new Node();
+        m_head.store(stub, std::memory_order_relaxed);
+        m_tail = stub;
+    }
+
+    ~MpscQueue() {
+        T value;
+        while (pop(value)) {}
+        delete m_tail;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void push(T value) {
+        Node* node = new Node();
+        node->value = std::move(value);
+        Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer only. Returns false if no item is ready.
+    bool pop(T& value) {
+        Node* tail = m_tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) {
+            return false;
+        }
+        value = std::move(next->value);
+        next->value = T();
+        m_tail = next;
+        delete tail;
+        return true;
+    }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value{};
+    };
+
+    std::atomic<Node*> m_head; // Most recently pushed node
+    Node* m_tail;              // Consumer's position; its value has already been taken
+};
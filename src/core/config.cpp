@@ -2,28 +2,86 @@
 // Implementation for config 
 
 #include "config.h"
+#include "mapping_io.h"
 #include "utils/logging.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
 #include <fstream>
+#include <sstream>
 
 namespace {
     const char* CONTROLLERS_JSON = "controllers.json";
     const char* MAPPINGS_JSON = "mappings.json";
     const char* RESOURCES_MAPPINGS = "mappings.json"; // Will be copied to build/bin/ by CMake
+    const char* MAPPINGS_CACHE = "mappings.cache";
+    const char* SETTINGS_JSON = "settings.json";
+    const char* CALIBRATION_JSON = "calibration.json";
+
+    const char* cursorMergePolicyName(CursorMergePolicy policy) {
+        switch (policy) {
+            case CursorMergePolicy::MAX_MAGNITUDE: return "max_magnitude";
+            case CursorMergePolicy::MOST_RECENT: return "most_recent";
+            default: return "sum";
+        }
+    }
+
+    CursorMergePolicy parseCursorMergePolicy(const std::string& name) {
+        if (name == "max_magnitude") return CursorMergePolicy::MAX_MAGNITUDE;
+        if (name == "most_recent") return CursorMergePolicy::MOST_RECENT;
+        return CursorMergePolicy::SUM;
+    }
+
+    nlohmann::json stickCalibrationToJson(const StickCalibration& stick) {
+        return {
+            {"offset_x", std::round(stick.offset_x * 10.0) / 10.0},
+            {"offset_y", std::round(stick.offset_y * 10.0) / 10.0},
+            {"deviation", std::round(stick.deviation * 10.0) / 10.0},
+            {"samples", stick.samples}
+        };
+    }
+
+    // Leaves the defaults (not calibrated) unless every value is present and in range
+    void readStickCalibration(const nlohmann::json& j, StickCalibration& stick) {
+        if (!j.is_object()) return;
+        auto number = [&](const char* key, float limit, float& out) {
+            if (!j.contains(key) || !j[key].is_number()) return false;
+            float value = j[key].get<float>();
+            if (!(std::abs(value) <= limit)) return false;
+            out = value;
+            return true;
+        };
+        StickCalibration read;
+        if (number("offset_x", 32767.0f, read.offset_x) && number("offset_y", 32767.0f, read.offset_y)
+            && number("deviation", 32767.0f, read.deviation) && read.deviation >= 0.0f
+            && j.contains("samples") && j["samples"].is_number_unsigned()) {
+            read.samples = j["samples"].get<uint32_t>();
+            stick = read;
+        }
+    }
 }
 
 Config::Config() {
     loadControllers();
+    loadCalibration();
+    loadSettings();
     loadMappings();
 }
 
 void Config::loadControllers() {
     std::ifstream in(CONTROLLERS_JSON);
     if (in) {
-        nlohmann::json j;
-        in >> j;
+        nlohmann::json j = nlohmann::json::parse(in, nullptr, false);
+        if (j.is_discarded()) {
+            logError("Failed to parse controllers.json, ignoring known controllers.");
+            return;
+        }
         if (j.contains("controllers") && j["controllers"].is_array()) {
             for (const auto& controller : j["controllers"]) {
-                if (controller.is_object() && controller.contains("guid") && controller.contains("name")) {
+                if (controller.is_object() && controller.contains("guid") && controller["guid"].is_string()
+                    && controller.contains("name") && controller["name"].is_string()) {
                     std::string guid = controller["guid"].get<std::string>();
                     std::string name = controller["name"].get<std::string>();
                     m_known_controllers[guid] = name;
@@ -47,32 +105,189 @@ void Config::saveControllers() {
     out << j.dump(4);
 }
 
-void Config::loadMappings() {
-    std::ifstream in(MAPPINGS_JSON);
-    if (in) {
-        in >> m_mappings;
+void Config::loadCalibration() {
+    std::ifstream in(CALIBRATION_JSON);
+    if (!in) {
+        return;
+    }
+    nlohmann::json j = nlohmann::json::parse(in, nullptr, false);
+    if (j.is_discarded() || !j.is_object()) {
+        logError("Failed to parse calibration.json, stick calibration starts over.");
+        return;
+    }
+    for (const auto& [guid, entry] : j.items()) {
+        if (!entry.is_object()) continue;
+        ControllerCalibration calibration;
+        if (entry.contains("left_stick")) readStickCalibration(entry["left_stick"], calibration.left_stick);
+        if (entry.contains("right_stick")) readStickCalibration(entry["right_stick"], calibration.right_stick);
+        m_calibrations[guid] = calibration;
+    }
+}
+
+const ControllerCalibration* Config::findCalibration(const std::string& guid) const {
+    auto it = m_calibrations.find(guid);
+    return it != m_calibrations.end() ? &it->second : nullptr;
+}
+
+void Config::setCalibration(const std::string& guid, const ControllerCalibration& calibration) {
+    m_calibrations[guid] = calibration;
+}
+
+void Config::saveCalibration() {
+    nlohmann::json j = nlohmann::json::object();
+    for (const auto& [guid, calibration] : m_calibrations) {
+        j[guid] = {
+            {"left_stick", stickCalibrationToJson(calibration.left_stick)},
+            {"right_stick", stickCalibrationToJson(calibration.right_stick)}
+        };
+    }
+    if (!m_writer) {
+        m_writer = std::make_unique<ConfigWriter>();
+    }
+    m_writer->write(CALIBRATION_JSON, j.dump(4));
+}
+
+void Config::loadSettings() {
+    m_settings = CoreSettings();
+    std::ifstream in(SETTINGS_JSON);
+    if (!in) {
+        // Write the defaults so the available settings are discoverable
+        saveSettings();
+        return;
+    }
+    nlohmann::json j = nlohmann::json::parse(in, nullptr, false);
+    if (j.is_discarded() || !j.is_object()) {
+        logError("Failed to parse settings.json, using default settings.");
+        return;
+    }
+    if (j.contains("cursor_merge") && j["cursor_merge"].is_string()) {
+        m_settings.cursor_merge = parseCursorMergePolicy(j["cursor_merge"].get<std::string>());
+    }
+    if (j.contains("output_rate")) {
+        if (j["output_rate"].is_number_integer()) {
+            m_settings.output_rate = std::clamp(j["output_rate"].get<int>(), 0, 10000);
+        } else if (j["output_rate"] == "display") {
+            m_settings.output_rate = OUTPUT_RATE_DISPLAY;
+        }
+    }
+    if (j.contains("kinetic_scroll") && j["kinetic_scroll"].is_boolean()) {
+        m_settings.kinetic_scroll = j["kinetic_scroll"].get<bool>();
+    }
+    if (j.contains("kinetic_scroll_decay") && j["kinetic_scroll_decay"].is_number()) {
+        m_settings.kinetic_scroll_decay = std::clamp(j["kinetic_scroll_decay"].get<float>(), 0.0f, 1.0f);
+    }
+    if (j.contains("output_sink") && j["output_sink"].is_string()) {
+        std::string sink = j["output_sink"].get<std::string>();
+        if (sink == "platform" || sink == "null" || sink == "recording") {
+            m_settings.output_sink = sink;
+        } else {
+            logError(("Unknown output_sink \"" + sink + "\", using the platform output").c_str());
+        }
+    }
+}
+
+void Config::saveSettings() {
+    nlohmann::json j;
+    j["cursor_merge"] = cursorMergePolicyName(m_settings.cursor_merge);
+    if (m_settings.output_rate == OUTPUT_RATE_DISPLAY) {
+        j["output_rate"] = "display";
     } else {
+        j["output_rate"] = m_settings.output_rate;
+    }
+    j["kinetic_scroll"] = m_settings.kinetic_scroll;
+    j["kinetic_scroll_decay"] = std::round(m_settings.kinetic_scroll_decay * 1000.0) / 1000.0;
+    j["output_sink"] = m_settings.output_sink;
+    std::ofstream out(SETTINGS_JSON);
+    out << j.dump(4);
+}
+
+void Config::loadMappings() {
+    m_profileCache.close();
+    m_profiles.clear();
+    m_resolved.clear();
+    m_mappingsDroppedKeys = 0;
+    m_mappingsDocumentKeys.clear();
+    m_mappingsParsed = false;
+    m_mappingsModified = false;
+
+    // A current binary cache lets known controllers start without touching the JSON.
+    auto start = std::chrono::steady_clock::now();
+    if (m_profileCache.open(MAPPINGS_CACHE, MAPPINGS_JSON)) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        logInfo(("Mapped " + std::to_string(m_profileCache.size()) + " compiled profiles from cache in " +
+                 std::to_string(elapsed.count()) + " us").c_str());
+        return;
+    }
+    parseMappingsFile();
+}
+
+void Config::parseMappingsFile() {
+    auto start = std::chrono::steady_clock::now();
+    if (!readMappingsFile(MAPPINGS_JSON)) {
         createDefaultMappingsFile();
-        // Try loading again after creation
-        std::ifstream created_in(MAPPINGS_JSON);
-        if (created_in) {
-            created_in >> m_mappings;
+    }
+    m_mappingsParsed = true;
+
+    // Older files hold a full copy of the default profile per controller.
+    // Reduce every profile to its overrides so edits to a parent propagate.
+    size_t field_count = 0;
+    for (auto& [guid, layer] : m_profiles) {
+        if (!layer.fields.empty() && !parentOf(guid).empty()) {
+            compactProfile(guid, resolveProfile(guid));
         }
+        field_count += layer.fields.size();
     }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    logInfo(("Loaded " + std::to_string(m_profiles.size()) + " profiles (" + std::to_string(field_count) +
+             " stored fields) from mappings.json in " + std::to_string(elapsed.count()) + " us").c_str());
+}
+
+bool Config::readMappingsFile(const char* path) {
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+
+    std::string error;
+    bool ok = false;
+    m_profiles.clear();
+    if (size > kMaxMappingsFileSize) {
+        error = "file is larger than " + std::to_string(kMaxMappingsFileSize) + " bytes";
+    } else {
+        std::ifstream in(path);
+        ok = in && readMappingLayers(in, m_profiles, error, &m_mappingsDroppedKeys, &m_mappingsDocumentKeys);
+    }
+    if (ok) {
+        if (m_mappingsDroppedKeys > 0) {
+            logError((std::string(path) + " has " + std::to_string(m_mappingsDroppedKeys) +
+                      " values that this version cannot keep; it will not be overwritten").c_str());
+        }
+        return true;
+    }
+
+    // Set the broken file aside so it can be inspected, and start over from defaults
+    m_profiles.clear();
+    m_mappingsDroppedKeys = 0;
+    m_mappingsDocumentKeys.clear();
+    std::string backup = std::string(path) + ".corrupt";
+    std::filesystem::rename(path, backup, ec);
+    logError(("Failed to parse " + std::string(path) + " (" + error + "), moved it to " + backup).c_str());
+    return false;
 }
 
 void Config::createDefaultMappingsFile() {
-    logInfo("mappings.json not found, creating from resources template.");
+    logInfo("No usable mappings.json, creating from resources template.");
     
     // Try to read from resources (copied by CMake to build/bin/)
     std::ifstream resources_in(RESOURCES_MAPPINGS);
     if (resources_in) {
-        try {
-            nlohmann::json resources_mappings;
-            resources_in >> resources_mappings;
-            m_mappings = resources_mappings;
+        std::string error;
+        m_profiles.clear();
+        if (readMappingLayers(resources_in, m_profiles, error)) {
+            m_mappingsParsed = true;
             logInfo("Successfully loaded mappings from resources template.");
-        } catch (const std::exception& e) {
+        } else {
             logError("Failed to parse resources mappings.json, using fallback defaults.");
             createFallbackMappings();
         }
@@ -86,7 +301,8 @@ void Config::createDefaultMappingsFile() {
 
 void Config::createFallbackMappings() {
     // Minimal fallback if resources file is missing or invalid
-    m_mappings = {
+    m_mappingsParsed = true;
+    nlohmann::json fallback = {
         {"mappings", {
             {"default", {
                 {"name", "Default Profile"},
@@ -300,11 +516,31 @@ void Config::createFallbackMappings() {
             }}
         }}
     };
+    std::istringstream in(fallback.dump());
+    std::string error;
+    m_profiles.clear();
+    readMappingLayers(in, m_profiles, error);
 }
 
-void Config::saveMappings() {
+bool Config::saveMappings() {
+    // Nothing can have changed if the document was never loaded
+    if (!m_mappingsParsed) {
+        return true;
+    }
+    // Rewriting would lose the values the reader could not keep
+    if (m_mappingsDroppedKeys > 0) {
+        logError("Not saving mappings.json: it has values this version would drop.");
+        return false;
+    }
     std::ofstream out(MAPPINGS_JSON);
-    out << m_mappings.dump(4);
+    writeMappingLayers(out, m_profiles, m_mappingsDocumentKeys);
+    out.close();
+    if (!out) {
+        logError("Failed to write mappings.json.");
+        return false;
+    }
+    m_mappingsModified = false;
+    return true;
 }
 
 const std::map<std::string, std::string>& Config::getKnownControllers() const {
@@ -315,14 +551,151 @@ void Config::addController(const std::string& guid, const std::string& name) {
     m_known_controllers[guid] = name;
 }
 
-const nlohmann::json& Config::getMappingsJson() const {
-    return m_mappings;
+const MappingProfile* Config::findProfile(const std::string& guid) {
+    if (!m_mappingsParsed) {
+        parseMappingsFile();
+    }
+    if (!m_profiles.count(guid)) {
+        return nullptr;
+    }
+    auto resolved = m_resolved.find(guid);
+    if (resolved == m_resolved.end()) {
+        resolved = m_resolved.emplace(guid, resolveProfile(guid)).first;
+    }
+    return &resolved->second;
 }
 
-nlohmann::json& Config::getMappingsJson() {
-    return m_mappings;
+void Config::addProfile(const std::string& guid) {
+    if (!m_mappingsParsed) {
+        parseMappingsFile();
+    }
+    MappingLayer layer;
+    auto controller = m_known_controllers.find(guid);
+    if (controller != m_known_controllers.end() && m_profiles.count("model:" + controller->second)) {
+        layer.parent = "model:" + controller->second;
+    }
+    m_profiles[guid] = std::move(layer);
+    markMappingsModified();
+}
+
+void Config::storeProfile(const std::string& guid, const MappingProfile& profile) {
+    if (!m_mappingsParsed) {
+        parseMappingsFile();
+    }
+    compactProfile(guid, profile);
+    markMappingsModified();
+}
+
+std::string Config::parentOf(const std::string& guid) const {
+    auto layer = m_profiles.find(guid);
+    if (layer != m_profiles.end() && !layer->second.parent.empty()) {
+        return layer->second.parent;
+    }
+    return guid == "default" ? std::string() : std::string("default");
+}
+
+MappingProfile Config::resolveProfile(const std::string& guid) const {
+    // Collect the chain from the profile up to its root, stopping at missing
+    // parents and cycles
+    std::vector<const MappingLayer*> chain;
+    std::vector<std::string> visited;
+    for (std::string current = guid; !current.empty(); current = parentOf(current)) {
+        auto layer = m_profiles.find(current);
+        if (layer == m_profiles.end() || std::find(visited.begin(), visited.end(), current) != visited.end()) {
+            break;
+        }
+        visited.push_back(current);
+        chain.push_back(&layer->second);
+    }
+
+    MappingProfile profile;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        for (const auto& [path, value] : (*it)->fields) {
+            applyMappingField(profile, path, value);
+        }
+    }
+    return profile;
+}
+
+void Config::compactProfile(const std::string& guid, const MappingProfile& profile) {
+    std::string parent = parentOf(guid);
+    MappingFields parent_fields;
+    if (!parent.empty() && parent != guid) {
+        const MappingProfile* parent_profile = findProfile(parent);
+        parent_fields = flattenMappingProfile(parent_profile ? *parent_profile : MappingProfile());
+    }
+    MappingLayer& layer = m_profiles[guid];
+    layer.fields.clear();
+    for (auto& [path, value] : flattenMappingProfile(profile)) {
+        auto inherited = parent_fields.find(path);
+        if (inherited == parent_fields.end() || !(inherited->second == value)) {
+            layer.fields.emplace(path, std::move(value));
+        }
+    }
+}
+
+void Config::markMappingsModified() {
+    // Any edit can change every profile that inherits from the edited one
+    m_resolved.clear();
+    invalidateProfileCache();
+}
+
+std::vector<std::string> Config::getProfileIds() {
+    if (!m_mappingsParsed) {
+        parseMappingsFile();
+    }
+    std::vector<std::string> ids;
+    ids.reserve(m_profiles.size());
+    for (const auto& item : m_profiles) {
+        ids.push_back(item.first);
+    }
+    return ids;
+}
+
+MappingProfile Config::resolveProfileOnce(const std::string& guid) {
+    if (!m_mappingsParsed) {
+        parseMappingsFile();
+    }
+    auto resolved = m_resolved.find(guid);
+    return resolved != m_resolved.end() ? resolved->second : resolveProfile(guid);
 }
 
 void Config::reloadMappings() {
     loadMappings();
+}
+
+const CoreSettings& Config::getSettings() const {
+    return m_settings;
+}
+
+void Config::setSettings(const CoreSettings& settings) {
+    m_settings = settings;
+}
+
+void Config::reloadSettings() {
+    loadSettings();
+}
+
+const ProfileCache& Config::getProfileCache() const {
+    return m_profileCache;
+}
+
+bool Config::rebuildProfileCache(std::vector<std::pair<std::string, CompiledProfile>> profiles) {
+    m_profileCache.close();
+    // The cache is stamped with the file on disk, so never bake unsaved edits into it
+    if (m_mappingsModified) {
+        return false;
+    }
+    size_t count = profiles.size();
+    if (!ProfileCache::write(MAPPINGS_CACHE, MAPPINGS_JSON, std::move(profiles))) {
+        logError("Failed to write profile cache.");
+        return false;
+    }
+    logInfo(("Rebuilt profile cache with " + std::to_string(count) + " profiles").c_str());
+    return m_profileCache.open(MAPPINGS_CACHE, MAPPINGS_JSON);
+}
+
+void Config::invalidateProfileCache() {
+    m_mappingsModified = true;
+    m_profileCache.close();
 } 
\ No newline at end of file
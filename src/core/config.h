@@ -3,33 +3,93 @@
 
 #pragma once
 
-#include <nlohmann/json.hpp>
+#include "config_writer.h"
+#include "mapping_fields.h"
+#include "mapping_io.h"
+#include "profile_cache.h"
+#include "types.h"
 #include <string>
 #include <map>
+#include <memory>
+#include <vector>
 
 class Config {
 public:
     Config(); // Constructor will load the files
 
     void saveControllers();
-    void saveMappings();
+    // Returns false if mappings.json could not be written, or if rewriting it
+    // would lose values this version could not read; the file is then left as it is
+    bool saveMappings();
+    void saveSettings();
 
     const std::map<std::string, std::string>& getKnownControllers() const;
     void addController(const std::string& guid, const std::string& name);
 
-    const nlohmann::json& getMappingsJson() const;
-    nlohmann::json& getMappingsJson();
+    // Stick calibration learned per GUID, kept in calibration.json. Null if
+    // the controller has none yet.
+    const ControllerCalibration* findCalibration(const std::string& guid) const;
+    void setCalibration(const std::string& guid, const ControllerCalibration& calibration);
+    // Queues calibration.json on a background writer, so the caller does not wait on the disk
+    void saveCalibration();
+
+    // Mapping profiles keyed by GUID ("default" is the base profile).
+    // Each profile stores only its overrides on top of a parent profile and is
+    // resolved on first use. mappings.json is read on first use.
+    const MappingProfile* findProfile(const std::string& guid);
+    // Adds an empty profile for a controller that inherits everything from
+    // "model:<controller name>" if that profile exists, otherwise from "default".
+    void addProfile(const std::string& guid);
+    // Stores a resolved profile, keeping only the fields that differ from its parent.
+    void storeProfile(const std::string& guid, const MappingProfile& profile);
+    std::vector<std::string> getProfileIds();
+    // Resolves a profile without keeping the result, for passes over every
+    // profile. Empty if the profile does not exist.
+    MappingProfile resolveProfileOnce(const std::string& guid);
     
     // Reload mappings from JSON file
     void reloadMappings();
 
+    // Core-wide settings from settings.json
+    const CoreSettings& getSettings() const;
+    void setSettings(const CoreSettings& settings);
+    void reloadSettings();
+
+    // Compiled profiles mapped from the binary cache (empty if stale or missing).
+    const ProfileCache& getProfileCache() const;
+    // Rebuilds the binary cache from the given compiled profiles and maps it.
+    bool rebuildProfileCache(std::vector<std::pair<std::string, CompiledProfile>> profiles);
+    // Stops serving from the cache once the in-memory profiles diverge from disk.
+    // The cache is rebuilt again after the next save.
+    void invalidateProfileCache();
+
 
 private:
     void loadControllers();
+    void loadCalibration();
+    void loadSettings();
     void loadMappings();
+    void parseMappingsFile();
+    bool readMappingsFile(const char* path);
     void createDefaultMappingsFile();
     void createFallbackMappings();
+    void markMappingsModified();
+
+    // Parent profile name, or empty if the profile has none
+    std::string parentOf(const std::string& guid) const;
+    MappingProfile resolveProfile(const std::string& guid) const;
+    // Replaces a profile's overrides with the minimal diff against its parent
+    void compactProfile(const std::string& guid, const MappingProfile& profile);
 
-    nlohmann::json m_mappings;
+    std::map<std::string, MappingLayer> m_profiles;
+    std::map<std::string, MappingProfile> m_resolved; // Resolved profiles, cleared on any edit
+    bool m_mappingsParsed = false;
+    bool m_mappingsModified = false; // In-memory profiles differ from mappings.json
+    size_t m_mappingsDroppedKeys = 0;  // Values in mappings.json that a save would lose
+    MappingDocumentKeys m_mappingsDocumentKeys; // Top-level keys of mappings.json besides "mappings"
+    ProfileCache m_profileCache;
     std::map<std::string, std::string> m_known_controllers; // guid -> name
+    std::map<std::string, ControllerCalibration> m_calibrations;
+    std::unique_ptr<ConfigWriter> m_writer; // Started on the first background save
+    CoreSettings m_settings;
 }; 
\ No newline at end of file
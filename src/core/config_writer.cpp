@@ -0,0 +1,69 @@
+// config_writer.cpp
+// Implementation for config_writer
+
+#include "config_writer.h"
+#include "utils/logging.h"
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+ConfigWriter::ConfigWriter() : m_thread(&ConfigWriter::run, this) {}
+
+ConfigWriter::~ConfigWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void ConfigWriter::write(const std::string& path, std::string contents) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending[path] = std::move(contents);
+    }
+    m_wake.notify_one();
+}
+
+void ConfigWriter::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_pending.empty() && !m_writing; });
+}
+
+void ConfigWriter::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wake.wait(lock, [this] { return m_stopping || !m_pending.empty(); });
+        if (m_pending.empty()) {
+            return; // Stopping with nothing left to write
+        }
+        std::map<std::string, std::string> batch;
+        batch.swap(m_pending);
+        m_writing = true;
+        lock.unlock();
+
+        for (const auto& [path, contents] : batch) {
+            std::string temp = path + ".tmp";
+            {
+                std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+                out << contents;
+                if (!out) {
+                    logError(("Failed to write " + path).c_str());
+                    continue;
+                }
+            }
+            std::error_code error;
+            std::filesystem::rename(temp, path, error);
+            if (error) {
+                logError(("Failed to replace " + path).c_str());
+            }
+        }
+
+        lock.lock();
+        m_writing = false;
+        if (m_pending.empty()) {
+            m_idle.notify_all();
+        }
+    }
+}
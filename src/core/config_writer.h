@@ -0,0 +1,39 @@
+// config_writer.h
+// Writes configuration files on a background thread
+
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Saves files off the caller's thread, so the polling loop never waits on the
+// disk. Contents are serialized by the caller; a file queued again before it
+// is written is written once with the newest contents. Each file is written to
+// a temporary name and renamed over the old one, so a crash never leaves it
+// half written. Pending writes are finished on destruction.
+class ConfigWriter {
+public:
+    ConfigWriter();
+    ~ConfigWriter();
+
+    ConfigWriter(const ConfigWriter&) = delete;
+    ConfigWriter& operator=(const ConfigWriter&) = delete;
+
+    void write(const std::string& path, std::string contents);
+    // Blocks until every queued write is on disk
+    void flush();
+
+private:
+    void run();
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::map<std::string, std::string> m_pending; // path -> newest contents
+    bool m_writing = false;
+    bool m_stopping = false;
+    std::thread m_thread;
+};
@@ -5,64 +5,350 @@
 #include "controller_manager.h"
 #include "config.h"
 #include "mapping_manager.h"
+#include "acceleration_curve.h"
+#include "action_registry.h"
+#include "mapping_fields.h"
+#include "profile_cache.h"
+#include "output_sink.h"
+#include "input_snapshot.h"
 #include "utils/logging.h"
-#include <nlohmann/json.hpp>
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_gamepad.h>
-#include <fstream>
+#include <algorithm>
 #include <set>
 #include <string>
 #include <unordered_map>
 #include <cmath>
-
-using nlohmann::json;
-
-// Platform-specific function declarations
-extern "C" {
-    void platform_simulate_mouse_click(int clickType);
-    void platform_simulate_mouse_down(int clickType);
-    void platform_simulate_mouse_up(int clickType);
-    void platform_simulate_key_press(int keyType);
-    void platform_simulate_key_down(int keyType);
-    void platform_simulate_key_up(int keyType);
-    void platform_simulate_scroll_vertical(int amount);
-    void platform_simulate_scroll_horizontal(int amount);
-}
+#include <cstring>
+#include <vector>
 
 namespace {
-const char* CONTROLLERS_JSON = "controllers.json";
-const char* MAPPINGS_JSON = "mappings.json";
-
 std::string guid_to_string(const SDL_GUID& guid) {
     char buf[64] = {0};
     SDL_GUIDToString(guid, buf, sizeof(buf));
     return std::string(buf);
 }
 
-json load_mappings() {
-    std::ifstream in(MAPPINGS_JSON);
-    json j;
-    if (in) {
-        in >> j;
+// Applies the stick's radial deadzone and response curve for virtual gamepad output
+void shapeStick(Sint16 x, Sint16 y, const StickMapping& mapping, int& out_x, int& out_y) {
+    float fx = x / 32767.0f;
+    float fy = y / 32767.0f;
+    float magnitude = std::sqrt(fx * fx + fy * fy);
+    float deadzone = std::clamp(mapping.deadzone / 32767.0f, 0.0f, 0.99f);
+    if (magnitude <= deadzone) {
+        out_x = 0;
+        out_y = 0;
+        return;
+    }
+    float scaled = std::min((magnitude - deadzone) / (1.0f - deadzone), 1.0f);
+    float shaped = std::pow(scaled, std::max(mapping.response_exponent, 0.1f));
+    float scale = shaped / magnitude * 32767.0f;
+    out_x = std::clamp(static_cast<int>(std::lround(fx * scale)), -32768, 32767);
+    out_y = std::clamp(static_cast<int>(std::lround(fy * scale)), -32768, 32767);
+}
+
+// Scale for a stick's cursor speed from its acceleration table. mx and my are the
+// deflection in -100..100; full_tilt_time tracks how long the stick has been held
+// at full tilt for the time ramp.
+float accelerationFactor(float mx, float my, const AccelerationLut& lut, float& full_tilt_time, float deltaTime) {
+    float deflection = std::min(std::sqrt(mx * mx + my * my) / 100.0f, 1.0f);
+    if (deflection <= 0.0f) {
+        full_tilt_time = 0.0f;
+        return 0.0f;
+    }
+    full_tilt_time = deflection >= 0.95f ? full_tilt_time + deltaTime : 0.0f;
+    return lut.evaluate(deflection) / deflection * lut.rampMultiplier(full_tilt_time);
+}
+
+const float RADIANS_TO_DEGREES = 57.29578f;
+const float MAX_GYRO_SAMPLE_GAP = 0.1f;   // Seconds; longer gaps between gyro readings are not integrated
+const float GYRO_STILL_THRESHOLD = 3.0f;  // Degrees per second from the bias that counts as still
+const float GYRO_STILL_TIME = 0.5f;       // Seconds of stillness before the bias is updated
+const float GYRO_CALIBRATION_TIME = 2.0f; // Time constant of the bias estimate, in seconds
+
+struct GyroState {
+    GyroMapping mapping;
+    Uint64 last_sample_ns = 0;
+    float bias_pitch = 0.0f; // Degrees per second reported while still
+    float bias_yaw = 0.0f;
+    float still_time = 0.0f;
+    float pending_x = 0.0f;  // Pixels integrated since the last poll
+    float pending_y = 0.0f;
+};
+
+const int MAX_TOUCH_FINGERS = 2;         // Fingers tracked per touchpad; more are ignored
+const float TOUCHPAD_ASPECT = 0.5f;      // Pad height over width, so both axes move at the same speed
+const float MAX_TOUCH_SPEED = 4.0f;      // Finger speed (pad widths per second) where acceleration stops growing
+
+struct TouchFinger {
+    bool down = false;
+    float x = 0.0f;
+    float y = 0.0f;
+    float start_x = 0.0f;
+    float start_y = 0.0f;
+    Uint64 last_ns = 0;
+};
+
+// Per-controller trackpad state machine. Fingers go down, move and lift; a
+// gesture spans from the first finger down to the last finger up.
+struct TouchpadState {
+    TouchpadMapping mapping;
+    TouchFinger fingers[MAX_TOUCH_FINGERS];
+    int fingers_down = 0;
+    int gesture_fingers = 0;  // Most fingers down at once during the gesture
+    bool gesture_moved = false;
+    Uint64 gesture_start_ns = 0;
+    float pending_x = 0.0f;   // Pixels of cursor motion since the last poll
+    float pending_y = 0.0f;
+};
+
+const int TRIGGER_COUNT = 2;
+const SDL_GamepadAxis TRIGGER_AXES[TRIGGER_COUNT] = {SDL_GAMEPAD_AXIS_LEFT_TRIGGER, SDL_GAMEPAD_AXIS_RIGHT_TRIGGER};
+const char* const TRIGGER_NAMES[TRIGGER_COUNT] = {"left_trigger", "right_trigger"};
+const int TRIGGER_RELEASE_MARGIN = 1024;      // How far below its threshold a held trigger must fall to release
+const Uint64 TRIGGER_SCROLL_INTERVAL_MS = 10; // Time between trigger scroll updates of one controller
+const int TRIGGER_MAX = 32767;
+const int TRIGGER_UNREACHABLE = TRIGGER_MAX + 1; // Press point of stages a trigger does not have
+
+// Value below which a held trigger counts as released. The gap to the press
+// threshold keeps a trigger resting near it from chattering.
+int triggerReleasePoint(int threshold) {
+    return threshold - std::min(TRIGGER_RELEASE_MARGIN, threshold / 2);
+}
+
+// A trigger mapping resolved into the values the trigger handlers use, so a
+// poll compares and scales axis values instead of reading mappings. Stages a
+// mapping does not use press at TRIGGER_UNREACHABLE.
+struct TriggerParams {
+    TriggerActionType action_type = TriggerActionType::NONE; // NONE while disabled
+    int press = TRIGGER_UNREACHABLE;      // First stage: button, scroll or start of the brake
+    int release = TRIGGER_UNREACHABLE;
+    int full_press = TRIGGER_UNREACHABLE; // Second stage of a two-stage button trigger
+    int full_release = TRIGGER_UNREACHABLE;
+    float pressure_scale = 0.0f;          // Maps press..TRIGGER_MAX to 0..1
+    float scroll_step = 0.0f;             // Signed scroll per update at full pressure once ramped up
+    float brake_strength = 0.0f;
+    ButtonMapping button_action;
+    ButtonMapping full_pull_action;
+};
+
+TriggerParams compileTrigger(const TriggerMapping& mapping) {
+    const float BASE_SCROLL_PER_FRAME = 2.0f;
+    const float MAX_SCROLL_PER_FRAME = 40.0f;
+    TriggerParams params;
+    if (!mapping.enabled || mapping.action_type == TriggerActionType::NONE) {
+        return params;
+    }
+    params.action_type = mapping.action_type;
+    params.press = std::clamp(mapping.threshold, 0, TRIGGER_MAX);
+    params.release = mapping.release_threshold >= 0 ? std::min(mapping.release_threshold, params.press)
+                                                    : triggerReleasePoint(params.press);
+    params.pressure_scale = 1.0f / float(std::max(TRIGGER_MAX - params.press, 1));
+    switch (mapping.action_type) {
+        case TriggerActionType::BUTTON:
+            params.button_action = mapping.button_action;
+            if (mapping.full_pull_action.enabled && !mapping.full_pull_action.actions.empty()) {
+                params.full_pull_action = mapping.full_pull_action;
+                params.full_press = std::clamp(mapping.full_pull_threshold, params.press, TRIGGER_MAX);
+                params.full_release = std::max(triggerReleasePoint(params.full_press), params.release);
+            }
+            break;
+        case TriggerActionType::SCROLL: {
+            float max = mapping.trigger_scroll_action.vertical_max_speed > 0 ? mapping.trigger_scroll_action.vertical_max_speed : MAX_SCROLL_PER_FRAME;
+            float step = mapping.trigger_scroll_action.vertical_sensitivity * BASE_SCROLL_PER_FRAME * max;
+            params.scroll_step = mapping.scroll_direction == "up" ? step : (mapping.scroll_direction == "down" ? -step : 0.0f);
+            break;
+        }
+        case TriggerActionType::BRAKE:
+            params.brake_strength = std::clamp(mapping.brake_strength, 0.0f, 1.0f);
+            break;
+        default:
+            break;
+    }
+    return params;
+}
+
+// Whether a stage pressing at press and releasing below release is held, given
+// whether it was held on the last poll
+bool stageHeld(bool was_held, int value, int press, int release) {
+    return value >= (was_held ? release : press);
+}
+
+// Trigger state of one controller. Bit i of each mask is trigger i of
+// TRIGGER_AXES, so press and release edges are found with bit operations.
+struct TriggerState {
+    TriggerParams params[TRIGGER_COUNT];
+    uint8_t pressed = 0;      // Button-mode triggers past their first stage
+    uint8_t full_pressed = 0; // Two-stage triggers past their second stage
+    uint8_t scrolling = 0;    // Scroll-mode triggers held down
+    Uint64 scroll_start_ms[TRIGGER_COUNT] = {}; // When each scrolling trigger was pressed
+    Uint64 next_scroll_ms = 0;
+};
+
+const float SETTLED_STICK_SPEED = 1.0f;  // Smoothed cursor speed (pixels per second) that counts as stopped
+const int AXIS_IGNORED = 0x10000;        // Rest limit for axes no mapping reads; every value is at rest
+const Uint32 MAX_IDLE_WAIT_MS = 250;     // Longest block in waitForInput, so callers can still stop the loop
+const Uint64 MAX_RESUME_STEP_NS = 20 * kNsPerMs; // Longest time step of the poll after an idle wait
+const Uint64 STATS_WINDOW_NS = SDL_NS_PER_SECOND; // Span of the rates and percentiles in LiveStats
+
+// Controller events that can produce output
+bool isInputEvent(Uint32 type) {
+    switch (type) {
+        case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+        case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
+        case SDL_EVENT_GAMEPAD_BUTTON_UP:
+        case SDL_EVENT_GAMEPAD_TOUCHPAD_DOWN:
+        case SDL_EVENT_GAMEPAD_TOUCHPAD_MOTION:
+        case SDL_EVENT_GAMEPAD_TOUCHPAD_UP:
+        case SDL_EVENT_GAMEPAD_SENSOR_UPDATE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Last value of each axis as reported by axis motion events. An axis is at rest
+// while its distance from its center (the calibrated rest position of a stick,
+// otherwise 0) is below its limit: the stick deadzone, or the trigger
+// threshold. A controller is settled once it has been processed at rest and its
+// cursor smoothing has run down; settled controllers are skipped until an axis
+// leaves its rest range.
+struct AxisActivity {
+    Sint16 values[SDL_GAMEPAD_AXIS_COUNT] = {};
+    int rest_limits[SDL_GAMEPAD_AXIS_COUNT] = {};
+    int rest_centers[SDL_GAMEPAD_AXIS_COUNT] = {};
+    bool settled = false;
+
+    bool atRest(int axis) const { return std::abs(values[axis] - rest_centers[axis]) < rest_limits[axis]; }
+    bool atRest() const {
+        for (int axis = 0; axis < SDL_GAMEPAD_AXIS_COUNT; ++axis) {
+            if (!atRest(axis)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Tracks the gyro's zero-rate drift: while readings stay close to the current
+// bias for a moment the controller is taken to be still, and the bias follows them.
+void calibrateGyro(GyroState& gyro, float pitch, float yaw, float dt) {
+    float dp = pitch - gyro.bias_pitch;
+    float dy = yaw - gyro.bias_yaw;
+    if (std::sqrt(dp * dp + dy * dy) > GYRO_STILL_THRESHOLD) {
+        gyro.still_time = 0.0f;
+        return;
+    }
+    gyro.still_time += dt;
+    if (gyro.still_time >= GYRO_STILL_TIME) {
+        float weight = std::min(dt / GYRO_CALIBRATION_TIME, 1.0f);
+        gyro.bias_pitch += dp * weight;
+        gyro.bias_yaw += dy * weight;
+    }
+}
+
+const int STICK_COUNT = 2;
+const SDL_GamepadAxis STICK_AXES[STICK_COUNT][2] = {
+    {SDL_GAMEPAD_AXIS_LEFTX, SDL_GAMEPAD_AXIS_LEFTY},
+    {SDL_GAMEPAD_AXIS_RIGHTX, SDL_GAMEPAD_AXIS_RIGHTY}
+};
+const int STICK_CALIBRATION_RANGE = 8192;        // Farthest from center a resting stick is believed to report
+const int STICK_STILL_BAND = 1024;               // Largest wobble of a stick left alone
+const Uint64 STICK_STILL_TIME_MS = 500;          // Time a stick must stay within the band before it counts as resting
+const float STICK_DEVIATION_RATE = 0.002f;       // Weight of one resting sample in the deviation estimate
+const float STICK_MEDIAN_STEP = 0.05f;           // Offset step per sample, as a fraction of the deviation
+const float STICK_NOISE_FLOOR = 4.0f;            // Deviations from the offset treated as noise
+const Uint64 STICK_CALIBRATION_SAVE_MS = 60000;  // Shortest time between saves of a changing calibration
+
+// Calibration of one stick and the stillness check gating its samples
+struct StickCalibrationState {
+    StickCalibration calibration;
+    bool enabled = false; // The stick's mapping asks for calibration
+    Sint16 anchor_x = 0;  // Where the stick settled; it is still while it stays within the band
+    Sint16 anchor_y = 0;
+    Uint64 still_since_ms = 0;
+};
+
+struct CalibrationState {
+    std::string guid;
+    StickCalibrationState sticks[STICK_COUNT];
+    bool dirty = false; // Changed since it was last stored in the config
+    Uint64 saved_ms = 0;
+};
+
+// Feeds one resting sample into a stick's calibration in constant time. The
+// offset is a running median of each axis: it steps toward every sample by a
+// fraction of the deviation, so single outliers barely move it. The deviation
+// is a running mean of the sample's distance from the offset.
+void addCalibrationSample(StickCalibration& calibration, int x, int y) {
+    if (calibration.samples == 0) {
+        calibration.offset_x = static_cast<float>(x);
+        calibration.offset_y = static_cast<float>(y);
     }
-    return j;
+    float dx = x - calibration.offset_x;
+    float dy = y - calibration.offset_y;
+    // A plain mean over the first samples, then an exponential one
+    float weight = std::max(STICK_DEVIATION_RATE, 1.0f / float(calibration.samples + 1));
+    calibration.deviation += (std::max(std::abs(dx), std::abs(dy)) - calibration.deviation) * weight;
+    float step = std::max(calibration.deviation * STICK_MEDIAN_STEP, 1.0f);
+    calibration.offset_x += std::clamp(dx, -step, step);
+    calibration.offset_y += std::clamp(dy, -step, step);
+    if (calibration.samples < UINT32_MAX) {
+        calibration.samples++;
+    }
+}
+
+bool isCalibrated(const StickCalibrationState& stick) {
+    return stick.enabled && stick.calibration.samples > 0;
+}
+
+// Deadzone around the stick's rest position: the mapping's, or the noise band
+// of the calibration if that is wider
+int stickDeadzone(const StickMapping& mapping, const StickCalibrationState& stick) {
+    int noise = isCalibrated(stick) ? static_cast<int>(std::ceil(stick.calibration.deviation * STICK_NOISE_FLOOR)) : 0;
+    return std::max(mapping.deadzone, noise);
+}
+
+// Moves an axis value so the stick's rest position reads as 0, stretching each
+// side so full deflection still reaches the end of the range
+float recenterAxis(Sint16 value, float offset) {
+    float centered = value - offset;
+    float span = centered >= 0.0f ? 32767.0f - offset : 32768.0f + offset;
+    return std::clamp(centered * 32767.0f / std::max(span, 1.0f), -32767.0f, 32767.0f);
+}
+
+// Axis value measured from the rest position, 0 within the deadzone
+float calibratedAxis(Sint16 value, float offset, int deadzone) {
+    if (std::abs(value - offset) < deadzone) return 0.0f;
+    return recenterAxis(value, offset);
 }
 }
 
 class ControllerManagerImpl : public ControllerManager {
 public:
-    ControllerManagerImpl() : m_mapping_manager(m_config.getMappingsJson()) {
+    ControllerManagerImpl() : m_mapping_manager(m_config) {
         if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_GAMEPAD | SDL_INIT_EVENTS) < 0) {
             logError(SDL_GetError());
         } else {
             logInfo("SDL initialized for controller detection.");
         }
         
-        // Initialize repeat timing tracking
-        m_last_repeat_time = SDL_GetTicks();
+        updateOutputInterval();
+
+        m_output = createOutputSink(m_config.getSettings().output_sink);
+        logInfo(("Sending output through the " + std::string(m_output->name()) + " sink").c_str());
     }
 
     ~ControllerManagerImpl() override {
+        m_output->commit();
+        for (const auto& [instance_id, gamepad] : m_virtual_gamepads) {
+            m_output->destroyVirtualGamepad(instance_id);
+        }
+        for (auto& [instance_id, calibration] : m_calibrations) {
+            if (calibration.dirty) {
+                storeCalibration(calibration);
+            }
+        }
         m_config.saveControllers();
         m_config.saveMappings();
         SDL_Quit();
@@ -70,11 +356,22 @@ public:
 
     void detectControllers() override {} // No-op for now
 
-    void pollEvents(float deltaTime = 0.005f) override {
+    void pollEvents() override {
+        Uint64 frame_start = m_clock->nowNs();
+        float deltaTime = advanceFrameTime(frame_start);
+        m_stats.last_frame_round_trips = 0;
         SDL_UpdateGamepads();
 
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
+            // Latency is timed on the manager's clock from when an event is
+            // taken off SDL's queue; SDL's event timestamps use its own clock
+            if (isInputEvent(event.type)) {
+                m_event_dequeued_ns = m_clock->nowNs();
+                if (m_pending_input_ns == 0) {
+                    m_pending_input_ns = m_event_dequeued_ns;
+                }
+            }
             switch (event.type) {
                 case SDL_EVENT_GAMEPAD_ADDED:
                     onGamepadAdded(event.gdevice);
@@ -83,10 +380,31 @@ public:
                     onGamepadRemoved(event.gdevice);
                     break;
                 case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
-                    handleButtonDown(event.gbutton);
+                    recordButton(event.gbutton, true);
+                    if (m_virtual_gamepads.count(event.gbutton.which)) {
+                        forwardButton(event.gbutton, true);
+                    } else {
+                        handleButtonDown(event.gbutton);
+                    }
                     break;
                 case SDL_EVENT_GAMEPAD_BUTTON_UP:
-                    handleButtonUp(event.gbutton);
+                    recordButton(event.gbutton, false);
+                    if (m_virtual_gamepads.count(event.gbutton.which)) {
+                        forwardButton(event.gbutton, false);
+                    } else {
+                        handleButtonUp(event.gbutton);
+                    }
+                    break;
+                case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+                    onGamepadAxis(event.gaxis);
+                    break;
+                case SDL_EVENT_GAMEPAD_SENSOR_UPDATE:
+                    onGamepadSensor(event.gsensor);
+                    break;
+                case SDL_EVENT_GAMEPAD_TOUCHPAD_DOWN:
+                case SDL_EVENT_GAMEPAD_TOUCHPAD_MOTION:
+                case SDL_EVENT_GAMEPAD_TOUCHPAD_UP:
+                    onGamepadTouchpad(event.gtouchpad);
                     break;
             }
         }
@@ -94,6 +412,122 @@ public:
         handleTriggerButtons();
         handleTriggerScroll();
         handleRepeatTiming();
+        settleControllers();
+        saveChangedCalibrations();
+
+        // Cursor and scroll output is paced; input polled in between is
+        // accumulated and sent with the next output frame. Buttons and keys
+        // are sent as soon as they are polled.
+        m_output_elapsed += deltaTime;
+        bool output_frame = outputDue();
+        if (output_frame) {
+            flushCursorMotion();
+            flushScroll(m_output_elapsed);
+            m_output_elapsed = 0.0f;
+        } else if (!m_cursor_motion.empty() || m_scroll_pending_x != 0.0f || m_scroll_pending_y != 0.0f) {
+            m_stats.coalesced_frames++;
+        }
+
+        // Everything produced by this poll goes out together
+        size_t committed = m_output->pendingCommandCount();
+        m_output->commit();
+        recordOutput(committed, output_frame);
+        for (Uint64 timestamp : m_forwarded_timestamps) {
+            recordGamepadLatency(timestamp);
+        }
+        m_forwarded_timestamps.clear();
+        publishInput();
+
+        m_stats.frames++;
+        m_stats.round_trips += m_stats.last_frame_round_trips;
+        m_stats.max_frame_round_trips = std::max(m_stats.max_frame_round_trips, m_stats.last_frame_round_trips);
+        recordFrameTime(frame_start);
+    }
+
+    CoreStats getStats() const override {
+        return m_stats;
+    }
+
+    LiveStats liveStats() const override {
+        LiveStats live = m_live_stats;
+        live.frames = m_stats.frames;
+        live.output_commands = m_stats.output_commands;
+        live.coalesced_frames = m_stats.coalesced_frames;
+        live.dropped_motions = m_stats.dropped_motions;
+        return live;
+    }
+
+    const InputSnapshotTable& inputSnapshots() const override {
+        return m_snapshot_table;
+    }
+
+    // Blocks until SDL has an event when polling has nothing left to do: every
+    // controller is settled, no buttons repeat and no output is waiting.
+    // Otherwise returns at once and the caller keeps its normal poll interval.
+    bool waitForInput(Uint32 max_wait_ms) override {
+        if (!isIdle()) {
+            return false;
+        }
+        m_stats.idle_waits++;
+        bool woken = SDL_WaitEventTimeout(nullptr, static_cast<Sint32>(std::min(max_wait_ms, MAX_IDLE_WAIT_MS)));
+        // Time spent blocked here is not a stall; see advanceFrameTime
+        m_resumed_from_idle = true;
+        return woken;
+    }
+
+    // SDL's event queue is thread-safe; the user event is drained and ignored by pollEvents
+    void wake() override {
+        SDL_Event event{};
+        event.type = SDL_EVENT_USER;
+        SDL_PushEvent(&event);
+    }
+
+    void setOutputSink(std::unique_ptr<OutputSink> sink) override {
+        if (!sink) {
+            return;
+        }
+        // Virtual gamepads belong to the sink that created them
+        m_output->commit();
+        for (const auto& [instance_id, gamepad] : m_virtual_gamepads) {
+            m_output->destroyVirtualGamepad(instance_id);
+        }
+        m_virtual_gamepads.clear();
+        m_output = std::move(sink);
+        for (auto& [instance_id, gamepad] : m_active_controllers) {
+            SDL_GUID guid = SDL_GetJoystickGUID(SDL_GetGamepadJoystick(gamepad));
+            openVirtualGamepad(instance_id, guid_to_string(guid));
+        }
+        logInfo(("Sending output through the " + std::string(m_output->name()) + " sink").c_str());
+    }
+
+    void setClock(std::shared_ptr<Clock> clock) override {
+        if (!clock) {
+            return;
+        }
+        m_clock = std::move(clock);
+        // Schedules kept in the old clock's time restart on the new one
+        m_frame_started = false;
+        m_resumed_from_idle = false;
+        m_last_step_ns = 0;
+        m_next_output_ns = 0;
+        m_last_output_ns = 0;
+        m_window_start_ns = 0;
+        m_pending_input_ns = 0;
+        m_button_press_times.clear();
+        m_last_repeat_times.clear();
+        // Held trigger buttons stay held; scroll ramps start over
+        for (auto& [instance_id, triggers] : m_triggers) {
+            triggers.scrolling = 0;
+            triggers.next_scroll_ms = 0;
+        }
+        // Stillness and save timers start over too
+        Uint64 now_ms = m_clock->nowMs();
+        for (auto& [instance_id, calibration] : m_calibrations) {
+            calibration.saved_ms = now_ms;
+            for (StickCalibrationState& stick : calibration.sticks) {
+                stick.still_since_ms = now_ms;
+            }
+        }
     }
 
     bool hasActiveController() const override {
@@ -119,8 +553,10 @@ public:
     }
 
     void reloadMappings() {
-        // Reload the config mappings from JSON file
+        // Reload the config mappings and settings from JSON files
         m_config.reloadMappings();
+        m_config.reloadSettings();
+        updateOutputInterval();
         
         // Clear the mapping manager's cache to force reload from JSON
         m_mapping_manager.clearCache();
@@ -132,8 +568,13 @@ public:
             std::string guid_str = guid_to_string(guid);
             
             // Reload mappings for this controller
-            m_left_stick_mappings[instance_id] = m_mapping_manager.getLeftStick(guid_str);
-            m_right_stick_mappings[instance_id] = m_mapping_manager.getRightStick(guid_str);
+            loadStickMappings(instance_id, guid_str);
+
+            // The profile may have switched between gamepad and mouse output
+            closeVirtualGamepad(instance_id);
+            openVirtualGamepad(instance_id, guid_str);
+            openGyro(instance_id, gamepad, guid_str);
+            openTouchpad(instance_id, gamepad, guid_str);
         }
         
         logInfo("Controller mappings reloaded from JSON");
@@ -149,6 +590,11 @@ private:
     }
 
     void onGamepadAdded(const SDL_GamepadDeviceEvent& event) {
+        // Our own virtual gamepads show up as controllers too; forwarding them would loop
+        const char* device_name = SDL_GetJoystickNameForID(event.which);
+        if (device_name && std::strcmp(device_name, kVirtualGamepadName) == 0) {
+            return;
+        }
         SDL_Gamepad* gamepad = SDL_OpenGamepad(event.which);
         if (!gamepad) {
             logError(SDL_GetError());
@@ -161,8 +607,11 @@ private:
         const char* name = SDL_GetGamepadName(gamepad);
 
         m_active_controllers[event.which] = gamepad;
-        m_left_stick_mappings[event.which] = m_mapping_manager.getLeftStick(guid_str);
-        m_right_stick_mappings[event.which] = m_mapping_manager.getRightStick(guid_str);
+        loadStickMappings(event.which, guid_str);
+        openVirtualGamepad(event.which, guid_str);
+        openGyro(event.which, gamepad, guid_str);
+        openTouchpad(event.which, gamepad, guid_str);
+        openInputSnapshot(event.which, gamepad, guid_str);
         
         // Log the current mapping configuration
         const auto& left_mapping = m_left_stick_mappings[event.which];
@@ -195,43 +644,8 @@ private:
             if (!mapping.enabled) continue;
             std::vector<std::string> enabled_actions;
             for (const auto& action : mapping.actions) {
-                if (action.enabled) {
-                    // Mouse click type
-                    if (action.click_type != MouseClickType::NONE) {
-                        switch (action.click_type) {
-                            case MouseClickType::LEFT_CLICK: enabled_actions.push_back("mouse_left_click"); break;
-                            case MouseClickType::RIGHT_CLICK: enabled_actions.push_back("mouse_right_click"); break;
-                            case MouseClickType::MIDDLE_CLICK: enabled_actions.push_back("mouse_middle_click"); break;
-                            default: break;
-                        }
-                    } else if (action.key_type != KeyboardKeyType::NONE) {
-                        // Keyboard key type
-                        switch (action.key_type) {
-                            case KeyboardKeyType::ESCAPE: enabled_actions.push_back("keyboard_escape"); break;
-                            case KeyboardKeyType::TAB: enabled_actions.push_back("keyboard_tab"); break;
-                            case KeyboardKeyType::UP: enabled_actions.push_back("keyboard_up"); break;
-                            case KeyboardKeyType::DOWN: enabled_actions.push_back("keyboard_down"); break;
-                            case KeyboardKeyType::LEFT: enabled_actions.push_back("keyboard_left"); break;
-                            case KeyboardKeyType::RIGHT: enabled_actions.push_back("keyboard_right"); break;
-                            case KeyboardKeyType::ALT: enabled_actions.push_back("keyboard_alt"); break;
-                            case KeyboardKeyType::CTRL: enabled_actions.push_back("keyboard_ctrl"); break;
-                            case KeyboardKeyType::SHIFT: enabled_actions.push_back("keyboard_shift"); break;
-                            case KeyboardKeyType::SPACE: enabled_actions.push_back("keyboard_space"); break;
-                            case KeyboardKeyType::F1: enabled_actions.push_back("keyboard_f1"); break;
-                            case KeyboardKeyType::F2: enabled_actions.push_back("keyboard_f2"); break;
-                            case KeyboardKeyType::F3: enabled_actions.push_back("keyboard_f3"); break;
-                            case KeyboardKeyType::F4: enabled_actions.push_back("keyboard_f4"); break;
-                            case KeyboardKeyType::F5: enabled_actions.push_back("keyboard_f5"); break;
-                            case KeyboardKeyType::F6: enabled_actions.push_back("keyboard_f6"); break;
-                            case KeyboardKeyType::F7: enabled_actions.push_back("keyboard_f7"); break;
-                            case KeyboardKeyType::F8: enabled_actions.push_back("keyboard_f8"); break;
-                            case KeyboardKeyType::F9: enabled_actions.push_back("keyboard_f9"); break;
-                            case KeyboardKeyType::F10: enabled_actions.push_back("keyboard_f10"); break;
-                            case KeyboardKeyType::F11: enabled_actions.push_back("keyboard_f11"); break;
-                            case KeyboardKeyType::F12: enabled_actions.push_back("keyboard_f12"); break;
-                            default: break;
-                        }
-                    }
+                if (action.enabled && findAction(action)) {
+                    enabled_actions.push_back(buttonActionName(action));
                 }
             }
             if (!enabled_actions.empty()) {
@@ -280,6 +694,32 @@ private:
             m_active_controllers.erase(event.which);
             m_left_stick_mappings.erase(event.which);
             m_right_stick_mappings.erase(event.which);
+            m_stick_curves.erase(event.which);
+            m_gyros.erase(event.which);
+            m_touchpads.erase(event.which);
+            m_axis_activity.erase(event.which);
+            auto calibration = m_calibrations.find(event.which);
+            if (calibration != m_calibrations.end()) {
+                if (calibration->second.dirty) {
+                    storeCalibration(calibration->second);
+                }
+                m_calibrations.erase(calibration);
+            }
+            auto triggers = m_triggers.find(event.which);
+            if (triggers != m_triggers.end()) {
+                releaseTriggerButtons(event.which, triggers->second);
+                m_triggers.erase(triggers);
+            }
+            m_left_stick_velocity.erase(event.which);
+            m_right_stick_velocity.erase(event.which);
+            m_l3_held.erase(event.which);
+            m_r3_held.erase(event.which);
+            m_buttons_held.erase(event.which);
+            m_button_press_times.erase(event.which);
+            m_last_repeat_times.erase(event.which);
+            closeInputSnapshot(event.which);
+            m_cursor_started_frame.erase(event.which);
+            closeVirtualGamepad(event.which);
             
             // Notify core about controller disconnection
             if (m_controllerDisconnectedCallback) {
@@ -288,28 +728,659 @@ private:
         }
     }
 
+    // Loads both stick mappings and compiles their acceleration curves
+    void loadStickMappings(SDL_JoystickID instance_id, const std::string& guid_str) {
+        const StickMapping& left = m_left_stick_mappings[instance_id] = m_mapping_manager.getLeftStick(guid_str);
+        const StickMapping& right = m_right_stick_mappings[instance_id] = m_mapping_manager.getRightStick(guid_str);
+        StickCurves& curves = m_stick_curves[instance_id];
+        curves.left = compileAccelerationCurve(left.cursor_action.acceleration);
+        curves.right = compileAccelerationCurve(right.cursor_action.acceleration);
+        curves.left_full_tilt_time = 0.0f;
+        curves.right_full_tilt_time = 0.0f;
+        loadCalibration(instance_id, guid_str);
+        loadTriggers(instance_id, guid_str);
+        loadAxisActivity(instance_id);
+    }
+
+    // Starts from the stored calibration when the controller connects. On a
+    // reload the calibration learned so far is kept and only the mappings'
+    // choice to use it is updated.
+    void loadCalibration(SDL_JoystickID instance_id, const std::string& guid_str) {
+        auto [it, added] = m_calibrations.try_emplace(instance_id);
+        CalibrationState& state = it->second;
+        if (added) {
+            state.guid = guid_str;
+            state.saved_ms = m_clock->nowMs();
+            state.sticks[0].still_since_ms = state.saved_ms;
+            state.sticks[1].still_since_ms = state.saved_ms;
+            if (const ControllerCalibration* stored = m_config.findCalibration(guid_str)) {
+                state.sticks[0].calibration = stored->left_stick;
+                state.sticks[1].calibration = stored->right_stick;
+            }
+        }
+        state.sticks[0].enabled = m_left_stick_mappings[instance_id].calibrate;
+        state.sticks[1].enabled = m_right_stick_mappings[instance_id].calibrate;
+    }
+
+    // Hands a controller's calibration to the config and queues it for saving
+    void storeCalibration(CalibrationState& state) {
+        ControllerCalibration calibration;
+        calibration.left_stick = state.sticks[0].calibration;
+        calibration.right_stick = state.sticks[1].calibration;
+        m_config.setCalibration(state.guid, calibration);
+        m_config.saveCalibration();
+        state.dirty = false;
+        state.saved_ms = m_clock->nowMs();
+    }
+
+    // Saves calibrations that changed, at most once per STICK_CALIBRATION_SAVE_MS
+    void saveChangedCalibrations() {
+        Uint64 now = m_clock->nowMs();
+        for (auto& [instance_id, state] : m_calibrations) {
+            if (state.dirty && now - state.saved_ms >= STICK_CALIBRATION_SAVE_MS) {
+                storeCalibration(state);
+            }
+        }
+    }
+
+    // Learns a stick's rest position from axis events. Samples count only once
+    // the stick has stayed within STICK_STILL_BAND for STICK_STILL_TIME_MS, so a
+    // moving stick is not mistaken for drift. Once calibrated, only samples
+    // that produce no output (within the deadzone or the still band around the
+    // rest position) are used, so holding the stick slightly pushed does not
+    // drag the rest position along.
+    void sampleStickRest(SDL_JoystickID instance_id, AxisActivity& activity, int stick) {
+        auto found = m_calibrations.find(instance_id);
+        if (found == m_calibrations.end() || !found->second.sticks[stick].enabled) return;
+        StickCalibrationState& state = found->second.sticks[stick];
+        Sint16 x = activity.values[STICK_AXES[stick][0]];
+        Sint16 y = activity.values[STICK_AXES[stick][1]];
+        Uint64 now = m_clock->nowMs();
+        if (std::abs(x - state.anchor_x) > STICK_STILL_BAND || std::abs(y - state.anchor_y) > STICK_STILL_BAND) {
+            state.anchor_x = x;
+            state.anchor_y = y;
+            state.still_since_ms = now;
+            return;
+        }
+        if (now - state.still_since_ms < STICK_STILL_TIME_MS) {
+            return;
+        }
+        if (isCalibrated(state)) {
+            const StickMapping& mapping = stick == 0 ? m_left_stick_mappings[instance_id] : m_right_stick_mappings[instance_id];
+            float reach = static_cast<float>(std::max(stickDeadzone(mapping, state), STICK_STILL_BAND));
+            if (std::abs(x - state.calibration.offset_x) > reach || std::abs(y - state.calibration.offset_y) > reach) {
+                return;
+            }
+        }
+        if (std::abs(x) > STICK_CALIBRATION_RANGE || std::abs(y) > STICK_CALIBRATION_RANGE) {
+            return;
+        }
+        addCalibrationSample(state.calibration, x, y);
+        found->second.dirty = true;
+        updateStickRest(instance_id, activity, stick);
+    }
+
+    // Centers a stick's rest range on its calibrated rest position
+    void updateStickRest(SDL_JoystickID instance_id, AxisActivity& activity, int stick) {
+        const StickMapping& mapping = stick == 0 ? m_left_stick_mappings[instance_id] : m_right_stick_mappings[instance_id];
+        const StickCalibrationState& calibration = m_calibrations[instance_id].sticks[stick];
+        bool read = mapping.enabled && mapping.action_type != StickActionType::NONE;
+        bool calibrated = isCalibrated(calibration);
+        for (int i = 0; i < 2; ++i) {
+            int axis = STICK_AXES[stick][i];
+            float offset = i == 0 ? calibration.calibration.offset_x : calibration.calibration.offset_y;
+            activity.rest_limits[axis] = read ? std::max(stickDeadzone(mapping, calibration), 1) : AXIS_IGNORED;
+            activity.rest_centers[axis] = calibrated ? static_cast<int>(std::lround(offset)) : 0;
+        }
+        publishStickRest(instance_id, stick);
+    }
+
+    // Compiles both trigger mappings. Stages held under the old mappings are
+    // released first, so a changed action cannot be left pressed.
+    void loadTriggers(SDL_JoystickID instance_id, const std::string& guid_str) {
+        TriggerState& state = m_triggers[instance_id];
+        releaseTriggerButtons(instance_id, state);
+        state.scrolling = 0;
+        for (int i = 0; i < TRIGGER_COUNT; ++i) {
+            state.params[i] = compileTrigger(m_mapping_manager.getTriggerMapping(guid_str, TRIGGER_NAMES[i]));
+        }
+    }
+
+    void releaseTriggerButtons(SDL_JoystickID instance_id, TriggerState& state) {
+        for (int i = 0; i < TRIGGER_COUNT; ++i) {
+            if (state.full_pressed & (1u << i)) {
+                executeButtonActionsUp(state.params[i].full_pull_action, instance_id, TRIGGER_NAMES[i]);
+            }
+            if (state.pressed & (1u << i)) {
+                executeButtonActionsUp(state.params[i].button_action, instance_id, TRIGGER_NAMES[i]);
+            }
+        }
+        state.pressed = 0;
+        state.full_pressed = 0;
+    }
+
+    // Sets each axis's rest range from the mappings that read it and starts the
+    // controller unsettled, so it gets at least one full pass
+    void loadAxisActivity(SDL_JoystickID instance_id) {
+        AxisActivity& activity = m_axis_activity[instance_id];
+        // A brake only scales cursor motion, so it cannot move a resting controller
+        const TriggerState& triggers = m_triggers[instance_id];
+        auto trigger_limit = [&](int trigger) {
+            const TriggerParams& params = triggers.params[trigger];
+            bool read = params.action_type == TriggerActionType::BUTTON || params.action_type == TriggerActionType::SCROLL;
+            return read ? std::max(params.release, 1) : AXIS_IGNORED;
+        };
+        for (int stick = 0; stick < STICK_COUNT; ++stick) {
+            updateStickRest(instance_id, activity, stick);
+        }
+        for (int i = 0; i < TRIGGER_COUNT; ++i) {
+            activity.rest_limits[TRIGGER_AXES[i]] = trigger_limit(i);
+        }
+        if (SDL_Gamepad* gamepad = m_active_controllers[instance_id]) {
+            for (int axis = 0; axis < SDL_GAMEPAD_AXIS_COUNT; ++axis) {
+                activity.values[axis] = SDL_GetGamepadAxis(gamepad, static_cast<SDL_GamepadAxis>(axis));
+            }
+        }
+        activity.settled = false;
+    }
+
+    bool isSettled(SDL_JoystickID instance_id) const {
+        auto it = m_axis_activity.find(instance_id);
+        return it != m_axis_activity.end() && it->second.settled;
+    }
+
+    // Marks controllers settled after a pass in which all their axes were at rest.
+    // Their triggers must have been released by the trigger handlers, and
+    // cursor smoothing must have decayed, since it keeps moving the cursor
+    // after the stick is released.
+    void settleControllers() {
+        for (auto& [instance_id, activity] : m_axis_activity) {
+            if (activity.settled || !activity.atRest() || m_virtual_gamepads.count(instance_id)) {
+                continue;
+            }
+            auto& left = m_left_stick_velocity[instance_id];
+            auto& right = m_right_stick_velocity[instance_id];
+            float speed = std::max({std::abs(left.first), std::abs(left.second), std::abs(right.first), std::abs(right.second)});
+            auto triggers = m_triggers.find(instance_id);
+            bool triggers_held = triggers != m_triggers.end()
+                && (triggers->second.pressed | triggers->second.full_pressed | triggers->second.scrolling) != 0;
+            if (triggers_held || speed >= SETTLED_STICK_SPEED) {
+                continue;
+            }
+            left = {0.0f, 0.0f};
+            right = {0.0f, 0.0f};
+            activity.settled = true;
+        }
+    }
+
+    // Whether the next poll could only produce output in response to a new event
+    bool isIdle() const {
+        for (const auto& [instance_id, gamepad] : m_active_controllers) {
+            if (!m_virtual_gamepads.count(instance_id) && !isSettled(instance_id)) {
+                return false;
+            }
+        }
+        for (const auto& [instance_id, pad] : m_touchpads) {
+            if (pad.fingers_down > 0) {
+                return false;
+            }
+        }
+        for (const auto& [instance_id, held_buttons] : m_buttons_held) {
+            if (!held_buttons.empty()) {
+                return false;
+            }
+        }
+        return m_scroll_velocity_x == 0.0f && m_scroll_velocity_y == 0.0f &&
+               std::abs(m_scroll_remainder_x) < 1.0f && std::abs(m_scroll_remainder_y) < 1.0f &&
+               std::abs(m_cursor_remainder_x) < 1.0f && std::abs(m_cursor_remainder_y) < 1.0f;
+    }
+
+    // Turns on the gyro if the profile uses it for the cursor and the controller has one
+    void openGyro(SDL_JoystickID instance_id, SDL_Gamepad* gamepad, const std::string& guid_str) {
+        GyroMapping mapping = m_mapping_manager.getGyro(guid_str);
+        bool use_gyro = mapping.enabled && !m_virtual_gamepads.count(instance_id);
+        if (!use_gyro || !SDL_GamepadHasSensor(gamepad, SDL_SENSOR_GYRO)) {
+            if (m_gyros.erase(instance_id)) {
+                SDL_SetGamepadSensorEnabled(gamepad, SDL_SENSOR_GYRO, false);
+            } else if (use_gyro) {
+                logInfo(("Controller [" + guid_str + "] has no gyro, gyro cursor is off").c_str());
+            }
+            return;
+        }
+        if (!SDL_SetGamepadSensorEnabled(gamepad, SDL_SENSOR_GYRO, true)) {
+            logError(SDL_GetError());
+            return;
+        }
+        GyroState& gyro = m_gyros[instance_id];
+        gyro = GyroState();
+        gyro.mapping = mapping;
+        float rate = SDL_GetGamepadSensorDataRate(gamepad, SDL_SENSOR_GYRO);
+        logInfo(("Gyro cursor on for [" + guid_str + "] at " + std::to_string(static_cast<int>(rate)) + " Hz").c_str());
+    }
+
+    // Integrates one gyro reading into the controller's pending cursor motion.
+    // Readings arrive at the sensor's own rate, usually several per poll, and
+    // are timed by their sensor timestamps.
+    void onGamepadSensor(const SDL_GamepadSensorEvent& event) {
+        if (event.sensor != SDL_SENSOR_GYRO) {
+            return;
+        }
+        auto it = m_gyros.find(event.which);
+        if (it == m_gyros.end()) {
+            return;
+        }
+        GyroState& gyro = it->second;
+        Uint64 timestamp = event.sensor_timestamp != 0 ? event.sensor_timestamp : event.timestamp;
+        float dt = gyro.last_sample_ns != 0 && timestamp > gyro.last_sample_ns
+            ? static_cast<float>(timestamp - gyro.last_sample_ns) * 1e-9f : 0.0f;
+        gyro.last_sample_ns = timestamp;
+        if (dt <= 0.0f || dt > MAX_GYRO_SAMPLE_GAP) {
+            return;
+        }
+        m_stats.gyro_samples++;
+
+        // Degrees per second around the controller's x (pitch) and y (yaw) axes
+        float pitch = event.data[0] * RADIANS_TO_DEGREES;
+        float yaw = event.data[1] * RADIANS_TO_DEGREES;
+        if (gyro.mapping.calibrate) {
+            calibrateGyro(gyro, pitch, yaw, dt);
+        }
+        pitch -= gyro.bias_pitch;
+        yaw -= gyro.bias_yaw;
+
+        float speed = std::sqrt(pitch * pitch + yaw * yaw);
+        if (speed <= gyro.mapping.deadzone) {
+            return;
+        }
+        // Slow rotation is scaled down so small hand tremors do not move the cursor
+        float tightening = gyro.mapping.tightening > 0.0f ? std::min(speed / gyro.mapping.tightening, 1.0f) : 1.0f;
+        float scale = gyro.mapping.sensitivity * tightening * dt;
+        gyro.pending_x -= yaw * scale;
+        gyro.pending_y -= pitch * scale;
+    }
+
+    void openTouchpad(SDL_JoystickID instance_id, SDL_Gamepad* gamepad, const std::string& guid_str) {
+        m_touchpads.erase(instance_id);
+        TouchpadMapping mapping = m_mapping_manager.getTouchpad(guid_str);
+        if (!mapping.enabled || m_virtual_gamepads.count(instance_id)) {
+            return;
+        }
+        if (SDL_GetNumGamepadTouchpads(gamepad) <= 0) {
+            logInfo(("Controller [" + guid_str + "] has no touchpad, trackpad mode is off").c_str());
+            return;
+        }
+        m_touchpads[instance_id].mapping = mapping;
+        logInfo(("Trackpad mode on for [" + guid_str + "]").c_str());
+    }
+
+    // Advances the controller's trackpad state machine by one touch event. Events
+    // are handled in arrival order and timed by their timestamps, so gestures do
+    // not depend on the poll rate. One finger moves the cursor, two fingers
+    // scroll, and a short touch that barely moves is a click.
+    void onGamepadTouchpad(const SDL_GamepadTouchpadEvent& event) {
+        auto it = m_touchpads.find(event.which);
+        if (it == m_touchpads.end() || event.touchpad != 0 || event.finger < 0 || event.finger >= MAX_TOUCH_FINGERS) {
+            return;
+        }
+        TouchpadState& pad = it->second;
+        TouchFinger& finger = pad.fingers[event.finger];
+        const TouchpadMapping& mapping = pad.mapping;
+
+        if (event.type == SDL_EVENT_GAMEPAD_TOUCHPAD_DOWN) {
+            if (finger.down) {
+                return;
+            }
+            finger = {true, event.x, event.y, event.x, event.y, event.timestamp};
+            if (pad.fingers_down++ == 0) {
+                pad.gesture_fingers = 0;
+                pad.gesture_moved = false;
+                pad.gesture_start_ns = event.timestamp;
+            }
+            pad.gesture_fingers = std::max(pad.gesture_fingers, pad.fingers_down);
+            return;
+        }
+        if (!finger.down) {
+            return;
+        }
+
+        if (event.type == SDL_EVENT_GAMEPAD_TOUCHPAD_MOTION) {
+            float dx = event.x - finger.x;
+            float dy = (event.y - finger.y) * TOUCHPAD_ASPECT;
+            float dt = event.timestamp > finger.last_ns ? static_cast<float>(event.timestamp - finger.last_ns) * 1e-9f : 0.0f;
+            finger.x = event.x;
+            finger.y = event.y;
+            finger.last_ns = event.timestamp;
+            float travel_x = event.x - finger.start_x;
+            float travel_y = (event.y - finger.start_y) * TOUCHPAD_ASPECT;
+            if (std::sqrt(travel_x * travel_x + travel_y * travel_y) > mapping.tap_distance) {
+                pad.gesture_moved = true;
+            }
+
+            if (pad.fingers_down == 1) {
+                float speed = dt > 0.0f ? std::min(std::sqrt(dx * dx + dy * dy) / dt, MAX_TOUCH_SPEED) : 0.0f;
+                float gain = mapping.sensitivity * (1.0f + mapping.acceleration * speed);
+                pad.pending_x += dx * gain;
+                pad.pending_y += dy * gain;
+            } else {
+                // Each finger contributes its share; content follows the fingers.
+                // Scroll goes through the fractional high-resolution scroll path.
+                float share = mapping.scroll_sensitivity / pad.fingers_down / TOUCHPAD_ASPECT;
+                m_scroll_pending_x -= dx * share;
+                m_scroll_pending_y += dy * share;
+            }
+            return;
+        }
+
+        // SDL_EVENT_GAMEPAD_TOUCHPAD_UP
+        finger.down = false;
+        if (--pad.fingers_down > 0) {
+            return;
+        }
+        Uint64 duration_ms = (event.timestamp - pad.gesture_start_ns) / 1000000;
+        if (mapping.tap_to_click && !pad.gesture_moved && duration_ms <= static_cast<Uint64>(std::max(mapping.tap_time, 0))) {
+            MouseClickType click = pad.gesture_fingers >= 2 ? MouseClickType::RIGHT_CLICK : MouseClickType::LEFT_CLICK;
+            m_output->mouseDown(click);
+            m_output->mouseUp(click);
+        }
+    }
+
+    // Gives the controller a snapshot slot for the live visualizer, if one is free
+    void openInputSnapshot(SDL_JoystickID instance_id, SDL_Gamepad* gamepad, const std::string& guid_str) {
+        bool used[kMaxSnapshotControllers] = {};
+        for (const auto& [id, published] : m_published_input) {
+            used[published.slot] = true;
+        }
+        int slot = 0;
+        while (slot < kMaxSnapshotControllers && used[slot]) {
+            ++slot;
+        }
+        if (slot == kMaxSnapshotControllers) {
+            return;
+        }
+        PublishedInput& published = m_published_input[instance_id];
+        published = PublishedInput();
+        published.slot = slot;
+        std::strncpy(published.snapshot.guid, guid_str.c_str(), kSnapshotGuidLength - 1);
+        for (int axis = 0; axis < kInputSnapshotAxes; ++axis) {
+            published.snapshot.axes[axis] = SDL_GetGamepadAxis(gamepad, static_cast<SDL_GamepadAxis>(axis));
+        }
+        for (int stick = 0; stick < STICK_COUNT; ++stick) {
+            publishStickRest(instance_id, stick);
+        }
+    }
+
+    // Copies a stick's calibrated rest position into the controller's snapshot,
+    // so the visualizer centers the deadzone where the core does
+    void publishStickRest(SDL_JoystickID instance_id, int stick) {
+        auto published = m_published_input.find(instance_id);
+        auto calibration = m_calibrations.find(instance_id);
+        if (published == m_published_input.end() || calibration == m_calibrations.end()) {
+            return;
+        }
+        const StickCalibrationState& state = calibration->second.sticks[stick];
+        bool calibrated = isCalibrated(state);
+        int16_t* rest = published->second.snapshot.stick_rest + stick * 2;
+        rest[0] = calibrated ? static_cast<int16_t>(std::lround(state.calibration.offset_x)) : 0;
+        rest[1] = calibrated ? static_cast<int16_t>(std::lround(state.calibration.offset_y)) : 0;
+        published->second.dirty = true;
+    }
+
+    void closeInputSnapshot(SDL_JoystickID instance_id) {
+        auto it = m_published_input.find(instance_id);
+        if (it != m_published_input.end()) {
+            m_snapshot_table.slots[it->second.slot].store(InputSnapshot());
+            m_published_input.erase(it);
+        }
+    }
+
+    void recordButton(const SDL_GamepadButtonEvent& event, bool pressed) {
+        auto it = m_published_input.find(event.which);
+        if (it == m_published_input.end() || event.button >= 32) {
+            return;
+        }
+        uint32_t bit = 1u << event.button;
+        InputSnapshot& snapshot = it->second.snapshot;
+        snapshot.buttons = pressed ? (snapshot.buttons | bit) : (snapshot.buttons & ~bit);
+        it->second.dirty = true;
+    }
+
+    // Publishes the input of controllers that changed this poll, once per poll
+    // however many events arrived, so readers see at most one write per frame
+    void publishInput() {
+        for (auto& [instance_id, published] : m_published_input) {
+            if (!published.dirty) {
+                continue;
+            }
+            published.snapshot.version++;
+            m_snapshot_table.slots[published.slot].store(published.snapshot);
+            published.dirty = false;
+        }
+    }
+
     void onGamepadAxis(const SDL_GamepadAxisEvent& event) {
-        // Unused - polling instead
+        auto published = m_published_input.find(event.which);
+        if (published != m_published_input.end() && event.axis < kInputSnapshotAxes) {
+            published->second.snapshot.axes[event.axis] = event.value;
+            published->second.dirty = true;
+        }
+        // Mouse and keyboard output polls the axes instead
+        if (m_virtual_gamepads.count(event.which)) {
+            forwardAxis(event);
+            return;
+        }
+        auto it = m_axis_activity.find(event.which);
+        if (it == m_axis_activity.end() || event.axis >= SDL_GAMEPAD_AXIS_COUNT) {
+            return;
+        }
+        AxisActivity& activity = it->second;
+        activity.values[event.axis] = event.value;
+        for (int stick = 0; stick < STICK_COUNT; ++stick) {
+            if (event.axis == STICK_AXES[stick][0] || event.axis == STICK_AXES[stick][1]) {
+                sampleStickRest(event.which, activity, stick);
+            }
+        }
+        if (!activity.atRest(event.axis)) {
+            activity.settled = false;
+        }
+    }
+
+    // Creates a virtual gamepad for the controller if its profile asks for gamepad
+    // output. Controllers with one skip all mouse and keyboard processing.
+    void openVirtualGamepad(SDL_JoystickID instance_id, const std::string& guid_str) {
+        GamepadOutputMapping output = m_mapping_manager.getGamepadOutput(guid_str);
+        if (!output.enabled) {
+            return;
+        }
+        if (!m_output->createVirtualGamepad(instance_id)) {
+            logError(("Could not create a virtual gamepad for [" + guid_str + "], using mouse and keyboard output").c_str());
+            return;
+        }
+        VirtualGamepad& gamepad = m_virtual_gamepads[instance_id];
+        for (int i = 0; i < kGamepadButtonCount; ++i) {
+            gamepad.buttons[i] = static_cast<uint8_t>(i);
+        }
+        for (const auto& [source, target] : output.buttons) {
+            int source_index = gamepadButtonIndex(source);
+            int target_index = gamepadButtonIndex(target);
+            if (source_index >= 0 && target_index >= 0) {
+                gamepad.buttons[source_index] = static_cast<uint8_t>(target_index);
+            }
+        }
+        logInfo(("Forwarding controller [" + guid_str + "] to a virtual gamepad").c_str());
+    }
+
+    void closeVirtualGamepad(SDL_JoystickID instance_id) {
+        if (m_virtual_gamepads.erase(instance_id)) {
+            m_output->commit();
+            m_output->destroyVirtualGamepad(instance_id);
+        }
+    }
+
+    void forwardButton(const SDL_GamepadButtonEvent& event, bool pressed) {
+        if (event.button >= kGamepadButtonCount) {
+            return;
+        }
+        const VirtualGamepad& gamepad = m_virtual_gamepads.at(event.which);
+        m_output->gamepadButton(event.which, gamepad.buttons[event.button], pressed);
+        m_forwarded_timestamps.push_back(m_event_dequeued_ns);
+    }
+
+    void forwardAxis(const SDL_GamepadAxisEvent& event) {
+        SDL_Gamepad* gamepad = m_active_controllers.count(event.which) ? m_active_controllers.at(event.which) : nullptr;
+        if (!gamepad) {
+            return;
+        }
+        switch (event.axis) {
+            case SDL_GAMEPAD_AXIS_LEFTX:
+            case SDL_GAMEPAD_AXIS_LEFTY:
+                forwardStick(event.which, gamepad, SDL_GAMEPAD_AXIS_LEFTX, SDL_GAMEPAD_AXIS_LEFTY, m_left_stick_mappings[event.which]);
+                break;
+            case SDL_GAMEPAD_AXIS_RIGHTX:
+            case SDL_GAMEPAD_AXIS_RIGHTY:
+                forwardStick(event.which, gamepad, SDL_GAMEPAD_AXIS_RIGHTX, SDL_GAMEPAD_AXIS_RIGHTY, m_right_stick_mappings[event.which]);
+                break;
+            case SDL_GAMEPAD_AXIS_LEFT_TRIGGER:
+            case SDL_GAMEPAD_AXIS_RIGHT_TRIGGER:
+                m_output->gamepadAxis(event.which, event.axis, std::max<int>(event.value, 0));
+                break;
+            default:
+                return;
+        }
+        m_forwarded_timestamps.push_back(m_event_dequeued_ns);
+    }
+
+    // The deadzone is radial, so both axes of a stick are shaped and sent together
+    void forwardStick(SDL_JoystickID instance_id, SDL_Gamepad* gamepad, SDL_GamepadAxis axis_x, SDL_GamepadAxis axis_y,
+                      const StickMapping& mapping) {
+        int x, y;
+        shapeStick(SDL_GetGamepadAxis(gamepad, axis_x), SDL_GetGamepadAxis(gamepad, axis_y), mapping, x, y);
+        m_output->gamepadAxis(instance_id, axis_x, x);
+        m_output->gamepadAxis(instance_id, axis_y, y);
+    }
+
+    // Input latency runs from the first controller event after the previous
+    // output to the next commit that sends anything. Input that produced
+    // nothing by the end of an output frame starts over.
+    void recordOutput(size_t committed, bool output_frame) {
+        if (committed > 0) {
+            m_stats.output_commands += committed;
+            m_window_output_commands += committed;
+            if (m_pending_input_ns != 0) {
+                Uint64 now = m_clock->nowNs();
+                uint64_t latency_us = now > m_pending_input_ns ? (now - m_pending_input_ns) / 1000 : 0;
+                m_stats.input_latency.record(latency_us);
+                m_window_input_latency.record(latency_us);
+            }
+            m_pending_input_ns = 0;
+        } else if (output_frame) {
+            m_pending_input_ns = 0;
+        }
+    }
+
+    // Seconds since the previous poll. The first poll and any poll after a gap
+    // longer than kMaxFrameGapNs integrate nothing: their motion filters start
+    // over from rest rather than treating the gap as one huge time step.
+    // The poll after an idle wait is no gap, however long the wait: everything
+    // was at rest, so it steps by the last ordinary frame and the input that
+    // ended the wait moves the cursor at once.
+    float advanceFrameTime(Uint64 now) {
+        bool first = !m_frame_started;
+        bool resumed = m_resumed_from_idle;
+        Uint64 step = now - m_last_frame_ns;
+        m_frame_started = true;
+        m_resumed_from_idle = false;
+        m_last_frame_ns = now;
+        if (!first && resumed) {
+            step = std::min({step, m_last_step_ns > 0 ? m_last_step_ns : MAX_RESUME_STEP_NS, MAX_RESUME_STEP_NS});
+        } else if (first || step > kMaxFrameGapNs) {
+            resetMotionFilters();
+            return 0.0f;
+        } else {
+            m_last_step_ns = step;
+        }
+        return static_cast<float>(step) / static_cast<float>(kNsPerSecond);
+    }
+
+    // Drops smoothing, acceleration ramps and coasting scroll
+    void resetMotionFilters() {
+        m_left_stick_velocity.clear();
+        m_right_stick_velocity.clear();
+        for (auto& [instance_id, curves] : m_stick_curves) {
+            curves.left_full_tilt_time = 0.0f;
+            curves.right_full_tilt_time = 0.0f;
+        }
+        m_scroll_velocity_x = 0.0f;
+        m_scroll_velocity_y = 0.0f;
+        m_output_elapsed = 0.0f;
+    }
+
+    // Adds the poll to the frame time statistics and closes the stats window
+    // once it spans STATS_WINDOW_NS
+    void recordFrameTime(Uint64 frame_start) {
+        Uint64 now = m_clock->nowNs();
+        uint64_t frame_us = (now - frame_start) / 1000;
+        m_stats.frame_time.record(frame_us);
+        m_window_frame_time.record(frame_us);
+        if (m_window_start_ns == 0) {
+            m_window_start_ns = frame_start;
+        }
+        Uint64 span = now - m_window_start_ns;
+        if (span < STATS_WINDOW_NS) {
+            return;
+        }
+        double seconds = static_cast<double>(span) / SDL_NS_PER_SECOND;
+        m_live_stats.poll_rate_hz = static_cast<float>(m_window_frame_time.count / seconds);
+        m_live_stats.output_events_per_second = static_cast<float>(m_window_output_commands / seconds);
+        m_live_stats.frame_time_p50_us = static_cast<uint32_t>(m_window_frame_time.percentile(50));
+        m_live_stats.frame_time_p99_us = static_cast<uint32_t>(m_window_frame_time.percentile(99));
+        m_live_stats.input_latency_p99_us = m_window_input_latency.count > 0
+            ? static_cast<uint32_t>(m_window_input_latency.percentile(99)) : 0;
+        m_window_frame_time.clear();
+        m_window_input_latency.clear();
+        m_window_output_commands = 0;
+        m_window_start_ns = now;
+    }
+
+    void recordGamepadLatency(Uint64 dequeued_ns) {
+        Uint64 now = m_clock->nowNs();
+        m_stats.gamepad_latency.record(now > dequeued_ns ? (now - dequeued_ns) / 1000 : 0);
+    }
+
+    // Reads a stick measured from its calibrated rest position, with the deadzone applied
+    void readStick(SDL_JoystickID instance_id, SDL_Gamepad* gamepad, int stick, const StickMapping& mapping, float& x, float& y) {
+        const StickCalibrationState& calibration = m_calibrations[instance_id].sticks[stick];
+        bool calibrated = isCalibrated(calibration);
+        int deadzone = stickDeadzone(mapping, calibration);
+        x = calibratedAxis(SDL_GetGamepadAxis(gamepad, STICK_AXES[stick][0]), calibrated ? calibration.calibration.offset_x : 0.0f, deadzone);
+        y = calibratedAxis(SDL_GetGamepadAxis(gamepad, STICK_AXES[stick][1]), calibrated ? calibration.calibration.offset_y : 0.0f, deadzone);
     }
 
     void handleMouseMovement(float deltaTime) {
+        m_cursor_motion.clear();
+        m_stick_scroll_held = false;
+        m_touch_scroll_held = false;
         for (auto const& [instance_id, gamepad] : m_active_controllers) {
+            if (m_virtual_gamepads.count(instance_id)) continue;
+            // Settled sticks are not read; gyro and touchpad motion still is
+            bool settled = isSettled(instance_id);
+            if (settled && !m_gyros.count(instance_id) && !m_touchpads.count(instance_id)) {
+                m_cursor_started_frame.erase(instance_id);
+                m_stats.idle_skips++;
+                continue;
+            }
             float total_cursor_x = 0.0f;
             float total_cursor_y = 0.0f;
             bool has_cursor_movement = false;
 
             // Process left stick
-            if (m_left_stick_mappings.count(instance_id) && m_left_stick_mappings.at(instance_id).enabled) {
+            if (!settled && m_left_stick_mappings.count(instance_id) && m_left_stick_mappings.at(instance_id).enabled) {
                 const auto& left_mapping = m_left_stick_mappings.at(instance_id);
                 
-                Sint16 left_x = SDL_GetGamepadAxis(gamepad, SDL_GAMEPAD_AXIS_LEFTX);
-                Sint16 left_y = SDL_GetGamepadAxis(gamepad, SDL_GAMEPAD_AXIS_LEFTY);
-
-                if (std::abs(left_x) < left_mapping.deadzone) left_x = 0;
-                if (std::abs(left_y) < left_mapping.deadzone) left_y = 0;
+                float left_x, left_y;
+                readStick(instance_id, gamepad, 0, left_mapping, left_x, left_y);
                 
-                float left_mx = std::clamp(static_cast<float>(left_x) / 32767.0f, -1.0f, 1.0f) * 100;
-                float left_my = std::clamp(static_cast<float>(left_y) / 32767.0f, -1.0f, 1.0f) * 100;
+                float left_mx = std::clamp(left_x / 32767.0f, -1.0f, 1.0f) * 100;
+                float left_my = std::clamp(left_y / 32767.0f, -1.0f, 1.0f) * 100;
 
                 if (left_mapping.action_type == StickActionType::CURSOR) {
                     // Use boosted sensitivity if L3 is held (left stick button)
@@ -318,9 +1389,11 @@ private:
                         effective_sensitivity = left_mapping.cursor_action.boosted_sensitivity;
                     }
 
-                    // Calculate movement per second (time-based)
-                    float cursor_mx = left_mx * effective_sensitivity * 60.0f; // 60 pixels per second at full input
-                    float cursor_my = left_my * effective_sensitivity * 60.0f;
+                    // Calculate movement per second (time-based), shaped by the acceleration curve
+                    StickCurves& curves = m_stick_curves[instance_id];
+                    float speed = accelerationFactor(left_mx, left_my, curves.left, curves.left_full_tilt_time, deltaTime);
+                    float cursor_mx = left_mx * speed * effective_sensitivity * 60.0f; // 60 pixels per second at full input
+                    float cursor_my = left_my * speed * effective_sensitivity * 60.0f;
 
                     // Smoothing logic with time-based movement
                     auto& vel = m_left_stick_velocity[instance_id];
@@ -348,34 +1421,23 @@ private:
                         if (std::abs(left_mx) < 5.0f) curved_x = 0; // 5% deadzone
                         if (std::abs(left_my) < 5.0f) curved_y = 0; // 5% deadzone
 
-                        int scroll_y = static_cast<int>(-curved_y * vertical_sensitivity * vertical_max_speed);
-                        int scroll_x = static_cast<int>(curved_x * horizontal_sensitivity * horizontal_max_speed);
-                        
-                        // Apply vertical scroll
-                        if (scroll_y != 0) {
-                            platform_simulate_scroll_vertical(scroll_y);
-                        }
-                        
-                        // Apply horizontal scroll (if enabled)
-                        if (scroll_x != 0) {
-                            platform_simulate_scroll_horizontal(scroll_x);
-                        }
+                        // Queue fractional scroll; flushScroll emits it once per frame
+                        m_scroll_pending_y += -curved_y * vertical_sensitivity * vertical_max_speed;
+                        m_scroll_pending_x += curved_x * horizontal_sensitivity * horizontal_max_speed;
+                        m_stick_scroll_held = true;
                     }
                 }
             }
 
             // Process right stick
-            if (m_right_stick_mappings.count(instance_id) && m_right_stick_mappings.at(instance_id).enabled) {
+            if (!settled && m_right_stick_mappings.count(instance_id) && m_right_stick_mappings.at(instance_id).enabled) {
                 const auto& right_mapping = m_right_stick_mappings.at(instance_id);
                 
-                Sint16 right_x = SDL_GetGamepadAxis(gamepad, SDL_GAMEPAD_AXIS_RIGHTX);
-                Sint16 right_y = SDL_GetGamepadAxis(gamepad, SDL_GAMEPAD_AXIS_RIGHTY);
-
-                if (std::abs(right_x) < right_mapping.deadzone) right_x = 0;
-                if (std::abs(right_y) < right_mapping.deadzone) right_y = 0;
+                float right_x, right_y;
+                readStick(instance_id, gamepad, 1, right_mapping, right_x, right_y);
                 
-                float right_mx = std::clamp(static_cast<float>(right_x) / 32767.0f, -1.0f, 1.0f) * 100;
-                float right_my = std::clamp(static_cast<float>(right_y) / 32767.0f, -1.0f, 1.0f) * 100;
+                float right_mx = std::clamp(right_x / 32767.0f, -1.0f, 1.0f) * 100;
+                float right_my = std::clamp(right_y / 32767.0f, -1.0f, 1.0f) * 100;
 
                 if (right_mapping.action_type == StickActionType::CURSOR) {
                     // Use boosted sensitivity if R3 is held (right stick button)
@@ -384,9 +1446,11 @@ private:
                         effective_sensitivity = right_mapping.cursor_action.boosted_sensitivity;
                     }
 
-                    // Calculate movement per second (time-based)
-                    float cursor_mx = right_mx * effective_sensitivity * 60.0f; // 60 pixels per second at full input
-                    float cursor_my = right_my * effective_sensitivity * 60.0f;
+                    // Calculate movement per second (time-based), shaped by the acceleration curve
+                    StickCurves& curves = m_stick_curves[instance_id];
+                    float speed = accelerationFactor(right_mx, right_my, curves.right, curves.right_full_tilt_time, deltaTime);
+                    float cursor_mx = right_mx * speed * effective_sensitivity * 60.0f; // 60 pixels per second at full input
+                    float cursor_my = right_my * speed * effective_sensitivity * 60.0f;
 
                     // Smoothing logic with time-based movement
                     auto& vel = m_right_stick_velocity[instance_id];
@@ -414,133 +1478,311 @@ private:
                         if (std::abs(right_mx) < 5.0f) curved_x = 0; // 5% deadzone
                         if (std::abs(right_my) < 5.0f) curved_y = 0; // 5% deadzone
 
-                        int scroll_y = static_cast<int>(-curved_y * vertical_sensitivity * vertical_max_speed);
-                        int scroll_x = static_cast<int>(curved_x * horizontal_sensitivity * horizontal_max_speed);
-
-                        // Apply vertical scroll
-                        if (scroll_y != 0) {
-                            platform_simulate_scroll_vertical(scroll_y);
-                        }
-                        
-                        // Apply horizontal scroll (if enabled)
-                        if (scroll_x != 0) {
-                            platform_simulate_scroll_horizontal(scroll_x);
-                        }
+                        // Queue fractional scroll; flushScroll emits it once per frame
+                        m_scroll_pending_y += -curved_y * vertical_sensitivity * vertical_max_speed;
+                        m_scroll_pending_x += curved_x * horizontal_sensitivity * horizontal_max_speed;
+                        m_stick_scroll_held = true;
                     }
                 }
             }
 
-            // Apply combined cursor movement
+            // Gyro motion integrated since the last poll adds to the sticks' motion
+            auto gyro = m_gyros.find(instance_id);
+            if (gyro != m_gyros.end()) {
+                total_cursor_x += gyro->second.pending_x;
+                total_cursor_y += gyro->second.pending_y;
+                gyro->second.pending_x = 0.0f;
+                gyro->second.pending_y = 0.0f;
+                has_cursor_movement = true;
+            }
+
+            auto touchpad = m_touchpads.find(instance_id);
+            if (touchpad != m_touchpads.end()) {
+                TouchpadState& pad = touchpad->second;
+                total_cursor_x += pad.pending_x;
+                total_cursor_y += pad.pending_y;
+                pad.pending_x = 0.0f;
+                pad.pending_y = 0.0f;
+                has_cursor_movement = true;
+                if (pad.fingers_down >= 2) {
+                    m_touch_scroll_held = true;
+                }
+            }
+
+            if (has_cursor_movement) {
+                float brake = cursorBrake(instance_id, gamepad);
+                total_cursor_x *= brake;
+                total_cursor_y *= brake;
+            }
+
+            // Collect this controller's cursor movement; all controllers are merged into one event below
             if (has_cursor_movement && (total_cursor_x != 0.0f || total_cursor_y != 0.0f)) {
-                float current_x, current_y;
-                SDL_GetGlobalMouseState(&current_x, &current_y);
-                SDL_WarpMouseGlobal(current_x + total_cursor_x, current_y + total_cursor_y);
+                m_cursor_started_frame.emplace(instance_id, m_stats.frames);
+                m_cursor_motion.push_back({instance_id, total_cursor_x, total_cursor_y});
+            } else {
+                m_cursor_started_frame.erase(instance_id);
             }
         }
+
+        if (m_cursor_motion.size() > 1 && m_config.getSettings().cursor_merge != CursorMergePolicy::SUM) {
+            m_stats.dropped_motions += m_cursor_motion.size() - 1;
+        }
+        float cursor_x, cursor_y;
+        if (mergeCursorMotion(cursor_x, cursor_y)) {
+            m_cursor_remainder_x += cursor_x;
+            m_cursor_remainder_y += cursor_y;
+        }
     }
 
+    // Combines this frame's cursor motion from all controllers according to the
+    // merge policy. Returns false if the cursor does not move.
+    bool mergeCursorMotion(float& x, float& y) const {
+        x = 0.0f;
+        y = 0.0f;
+        if (m_cursor_motion.empty()) {
+            return false;
+        }
+        const CursorMotion* chosen = &m_cursor_motion.front();
+        switch (m_config.getSettings().cursor_merge) {
+            case CursorMergePolicy::MAX_MAGNITUDE:
+                for (const auto& motion : m_cursor_motion) {
+                    if (motion.x * motion.x + motion.y * motion.y > chosen->x * chosen->x + chosen->y * chosen->y) {
+                        chosen = &motion;
+                    }
+                }
+                break;
+            case CursorMergePolicy::MOST_RECENT:
+                for (const auto& motion : m_cursor_motion) {
+                    if (m_cursor_started_frame.at(motion.instance_id) > m_cursor_started_frame.at(chosen->instance_id)) {
+                        chosen = &motion;
+                    }
+                }
+                break;
+            case CursorMergePolicy::SUM:
+                for (const auto& motion : m_cursor_motion) {
+                    x += motion.x;
+                    y += motion.y;
+                }
+                return x != 0.0f || y != 0.0f;
+        }
+        x = chosen->x;
+        y = chosen->y;
+        return true;
+    }
+
+    // Moves the cursor once per output frame by the motion accumulated since the
+    // last one. Motion is sent as whole-pixel deltas; the fractional part carries
+    // over so slow stick movement is not lost.
+    void flushCursorMotion() {
+        int dx = static_cast<int>(m_cursor_remainder_x);
+        int dy = static_cast<int>(m_cursor_remainder_y);
+        if (dx == 0 && dy == 0) {
+            return;
+        }
+        m_cursor_remainder_x -= dx;
+        m_cursor_remainder_y -= dy;
+        m_stats.cursor_events++;
+
+        // Relative motion is a single write with no reads. Warping is only used when
+        // the output sink has no relative backend, and needs the current position
+        // first, which costs two display server round trips.
+        if (m_output->supportsRelativeMotion()) {
+            m_output->mouseMove(dx, dy);
+            return;
+        }
+        float current_x, current_y;
+        SDL_GetGlobalMouseState(&current_x, &current_y);
+        SDL_WarpMouseGlobal(current_x + dx, current_y + dy);
+        m_stats.last_frame_round_trips += 2;
+    }
+
+    // Output interval from the output_rate setting: 0 sends output every poll,
+    // OUTPUT_RATE_DISPLAY follows the primary display's refresh rate.
+    void updateOutputInterval() {
+        int rate = m_config.getSettings().output_rate;
+        if (rate == OUTPUT_RATE_DISPLAY) {
+            const SDL_DisplayMode* mode = SDL_GetCurrentDisplayMode(SDL_GetPrimaryDisplay());
+            rate = (mode && mode->refresh_rate > 0.0f) ? static_cast<int>(std::lround(mode->refresh_rate)) : 60;
+            logInfo(("Pacing cursor and scroll output to the display refresh rate (" + std::to_string(rate) + " Hz)").c_str());
+        }
+        m_output_interval_ns = rate > 0 ? SDL_NS_PER_SECOND / static_cast<Uint64>(rate) : 0;
+        m_next_output_ns = 0;
+    }
+
+    // Whether cursor and scroll output is due this poll. Deadlines advance by
+    // whole intervals so the output cadence does not drift with the poll rate.
+    bool outputDue() {
+        Uint64 now = m_clock->nowNs();
+        if (m_output_interval_ns != 0) {
+            if (now < m_next_output_ns) {
+                return false;
+            }
+            m_next_output_ns += m_output_interval_ns;
+            if (m_next_output_ns <= now) {
+                // Fell behind by more than an interval (e.g. after a stall); restart the schedule
+                m_next_output_ns = now + m_output_interval_ns;
+            }
+        }
+        recordOutputInterval(now);
+        return true;
+    }
+
+    // Tracks the mean and standard deviation of the time between output frames
+    void recordOutputInterval(Uint64 now) {
+        m_stats.output_frames++;
+        if (m_last_output_ns != 0) {
+            double interval_us = static_cast<double>(now - m_last_output_ns) / 1000.0;
+            m_output_interval_count++;
+            double delta = interval_us - m_output_interval_mean;
+            m_output_interval_mean += delta / m_output_interval_count;
+            m_output_interval_m2 += delta * (interval_us - m_output_interval_mean);
+            m_stats.output_interval_mean_us = m_output_interval_mean;
+            m_stats.output_jitter_us = std::sqrt(m_output_interval_m2 / m_output_interval_count);
+        } else {
+            m_first_output_ns = now;
+        }
+        m_last_output_ns = now;
+        m_stats.output_time_ns = now - m_first_output_ns;
+    }
+
+    // Presses and releases the actions of button-mode triggers on the edges
+    // between this poll's held bits and the last poll's. A two-stage trigger
+    // holds its first action from the half pull and adds its full-pull action.
     void handleTriggerButtons() {
-        // Track previous pressed state for each controller and trigger
-        static std::unordered_map<int, std::unordered_map<std::string, bool>> prev_trigger_pressed;
         for (const auto& [instance_id, gamepad] : m_active_controllers) {
-            SDL_Joystick* joystick = SDL_GetGamepadJoystick(gamepad);
-            SDL_GUID guid = SDL_GetJoystickGUID(joystick);
-            std::string guid_str = guid_to_string(guid);
-
-            struct TriggerInfo {
-                SDL_GamepadAxis axis;
-                const char* name;
-            } triggers[2] = {
-                {SDL_GAMEPAD_AXIS_LEFT_TRIGGER, "left_trigger"},
-                {SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, "right_trigger"}
-            };
-
-            for (const auto& trig : triggers) {
-                TriggerMapping mapping = m_mapping_manager.getTriggerMapping(guid_str, trig.name);
-                if (!mapping.enabled || mapping.action_type != TriggerActionType::BUTTON) continue;
-
-                Sint16 value = SDL_GetGamepadAxis(gamepad, trig.axis);
-                bool pressed = value >= mapping.threshold;
-                bool was_pressed = prev_trigger_pressed[instance_id][trig.name];
-
-                if (pressed && !was_pressed) {
-                    // Just pressed
-                    executeButtonActionsDown(mapping.button_action, instance_id, trig.name);
-                } else if (!pressed && was_pressed) {
-                    // Just released
-                    executeButtonActionsUp(mapping.button_action, instance_id, trig.name);
-                }
-                prev_trigger_pressed[instance_id][trig.name] = pressed;
+            if (m_virtual_gamepads.count(instance_id) || isSettled(instance_id)) continue;
+            TriggerState& state = m_triggers[instance_id];
+
+            // Stages a mapping lacks press at TRIGGER_UNREACHABLE and never hold
+            uint8_t held = 0;
+            uint8_t full_held = 0;
+            for (int i = 0; i < TRIGGER_COUNT; ++i) {
+                const TriggerParams& params = state.params[i];
+                if (params.action_type != TriggerActionType::BUTTON) continue;
+                int value = SDL_GetGamepadAxis(gamepad, TRIGGER_AXES[i]);
+                uint8_t bit = 1u << i;
+                held |= stageHeld(state.pressed & bit, value, params.press, params.release) ? bit : 0;
+                full_held |= stageHeld(state.full_pressed & bit, value, params.full_press, params.full_release) ? bit : 0;
+            }
+            full_held &= held;
+
+            uint8_t down = held & ~state.pressed;
+            uint8_t up = state.pressed & ~held;
+            uint8_t full_down = full_held & ~state.full_pressed;
+            uint8_t full_up = state.full_pressed & ~full_held;
+            state.pressed = held;
+            state.full_pressed = full_held;
+            if (!(down | up | full_down | full_up)) continue;
+            for (int i = 0; i < TRIGGER_COUNT; ++i) {
+                uint8_t bit = 1u << i;
+                const TriggerParams& params = state.params[i];
+                if (down & bit) executeButtonActionsDown(params.button_action, instance_id, TRIGGER_NAMES[i]);
+                if (full_down & bit) executeButtonActionsDown(params.full_pull_action, instance_id, TRIGGER_NAMES[i]);
+                if (full_up & bit) executeButtonActionsUp(params.full_pull_action, instance_id, TRIGGER_NAMES[i]);
+                if (up & bit) executeButtonActionsUp(params.button_action, instance_id, TRIGGER_NAMES[i]);
             }
         }
     }
 
+    // Queues scroll from scroll-mode triggers. Each controller is updated every
+    // TRIGGER_SCROLL_INTERVAL_MS, and the speed ramps up while a trigger is held.
     void handleTriggerScroll() {
-        static std::unordered_map<int, std::unordered_map<std::string, Uint32>> trigger_press_times;
-        static Uint32 last_scroll_time = 0;
-        Uint32 now = SDL_GetTicks();
-        const Uint32 SCROLL_INTERVAL_MS = 10;
-        const float BASE_SCROLL_PER_FRAME = 2.0f;
-        const float MAX_SCROLL_PER_FRAME = 40.0f;
+        Uint64 now = m_clock->nowMs();
         const float MAX_ACCEL_TIME = 2000.0f; // ms
 
-        if (now - last_scroll_time < SCROLL_INTERVAL_MS) return;
-        last_scroll_time = now;
-
         for (const auto& [instance_id, gamepad] : m_active_controllers) {
-            SDL_Joystick* joystick = SDL_GetGamepadJoystick(gamepad);
-            SDL_GUID guid = SDL_GetJoystickGUID(joystick);
-            std::string guid_str = guid_to_string(guid);
-
-            struct TriggerInfo {
-                SDL_GamepadAxis axis;
-                const char* name;
-                int direction; // +1 for up, -1 for down
-            } triggers[2] = {
-                {SDL_GAMEPAD_AXIS_LEFT_TRIGGER, "left_trigger", +1},
-                {SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, "right_trigger", -1}
-            };
-
-            for (const auto& trig : triggers) {
-                TriggerMapping mapping = m_mapping_manager.getTriggerMapping(guid_str, trig.name);
-                if (!mapping.enabled) continue;
-
-                if (mapping.action_type == TriggerActionType::SCROLL) {
-                    // logInfo((std::string("Trigger: ") + trig.name + " mapped to scroll " + mapping.scroll_direction).c_str());
-                } else if (mapping.action_type == TriggerActionType::BUTTON) {
-                    // logInfo((std::string("Trigger: ") + trig.name + " mapped to button action").c_str());
-                }
-
-                Sint16 value = SDL_GetGamepadAxis(gamepad, trig.axis);
-                if (value < mapping.threshold)
-                {
-                    trigger_press_times[instance_id][trig.name] = 0;
+            if (m_virtual_gamepads.count(instance_id) || isSettled(instance_id)) continue;
+            TriggerState& state = m_triggers[instance_id];
+            if (now < state.next_scroll_ms) continue;
+            state.next_scroll_ms = now + TRIGGER_SCROLL_INTERVAL_MS;
+
+            for (int i = 0; i < TRIGGER_COUNT; ++i) {
+                const TriggerParams& params = state.params[i];
+                uint8_t bit = 1u << i;
+                bool was_held = state.scrolling & bit;
+                int value = SDL_GetGamepadAxis(gamepad, TRIGGER_AXES[i]);
+                if (params.action_type != TriggerActionType::SCROLL
+                    || !stageHeld(was_held, value, params.press, params.release)) {
+                    state.scrolling &= ~bit;
                     continue;
                 }
-
-                // Track held time
-                Uint32& press_time = trigger_press_times[instance_id][trig.name];
-                if (press_time == 0) press_time = now;
-                float held_time = float(now - press_time);
-                float accel = std::min(1.0f, held_time / MAX_ACCEL_TIME);
-                float factor = accel * accel; // quadratic ramp-up
-
-                // Normalize from threshold to max
-                float norm = (value - mapping.threshold) / float(32767 - mapping.threshold);
-                norm = std::clamp(norm, 0.0f, 1.0f);
-
-                float base = mapping.trigger_scroll_action.vertical_sensitivity * BASE_SCROLL_PER_FRAME;
-                float max = mapping.trigger_scroll_action.vertical_max_speed > 0 ? mapping.trigger_scroll_action.vertical_max_speed : MAX_SCROLL_PER_FRAME;
-                int scroll_amount = static_cast<int>(base * norm * factor * max);
-                if (scroll_amount == 0) continue;
-
-                if (mapping.scroll_direction == "up") {
-                    platform_simulate_scroll_vertical(scroll_amount);
-                } else if (mapping.scroll_direction == "down") {
-                    platform_simulate_scroll_vertical(-scroll_amount);
+                if (!was_held) {
+                    state.scrolling |= bit;
+                    state.scroll_start_ms[i] = now;
                 }
+
+                // Quadratic ramp-up over the time held, scaled by pressure past the threshold
+                float accel = std::min(1.0f, float(now - state.scroll_start_ms[i]) / MAX_ACCEL_TIME);
+                float pressure = std::clamp((value - params.press) * params.pressure_scale, 0.0f, 1.0f);
+                m_scroll_pending_y += params.scroll_step * pressure * accel * accel;
             }
         }
+
+        m_trigger_scroll_held = false;
+        for (const auto& [instance_id, state] : m_triggers) {
+            if (state.scrolling) {
+                m_trigger_scroll_held = true;
+                break;
+            }
+        }
+    }
+
+    // Factor the cursor motion of a controller is scaled by: each brake trigger
+    // removes its strength times its pressure past the threshold
+    float cursorBrake(SDL_JoystickID instance_id, SDL_Gamepad* gamepad) const {
+        auto triggers = m_triggers.find(instance_id);
+        if (triggers == m_triggers.end()) return 1.0f;
+        float scale = 1.0f;
+        for (int i = 0; i < TRIGGER_COUNT; ++i) {
+            const TriggerParams& params = triggers->second.params[i];
+            if (params.action_type != TriggerActionType::BRAKE) continue;
+            float pressure = std::clamp((SDL_GetGamepadAxis(gamepad, TRIGGER_AXES[i]) - params.press) * params.pressure_scale, 0.0f, 1.0f);
+            scale *= 1.0f - params.brake_strength * pressure;
+        }
+        return scale;
+    }
+
+    // Emits the scroll queued by sticks and triggers since the last output frame
+    // as at most one event per axis. Amounts are in 1/120 notch units; the fraction left over
+    // is kept for the next frame so slow scrolling is smooth instead of lost.
+    // With kinetic scrolling, releasing all scroll inputs lets the last speed
+    // coast down instead of stopping at once.
+    void flushScroll(float deltaTime) {
+        const CoreSettings& settings = m_config.getSettings();
+        bool held = m_stick_scroll_held || m_trigger_scroll_held || m_touch_scroll_held;
+        if (held && deltaTime > 0.0f) {
+            // Smoothed input rate, so bursty trigger updates give a steady coasting speed
+            m_scroll_velocity_x = m_scroll_velocity_x * 0.8f + (m_scroll_pending_x / deltaTime) * 0.2f;
+            m_scroll_velocity_y = m_scroll_velocity_y * 0.8f + (m_scroll_pending_y / deltaTime) * 0.2f;
+        } else if (settings.kinetic_scroll) {
+            m_scroll_pending_x += m_scroll_velocity_x * deltaTime;
+            m_scroll_pending_y += m_scroll_velocity_y * deltaTime;
+            float decay = std::pow(std::clamp(settings.kinetic_scroll_decay, 0.0f, 1.0f), deltaTime);
+            m_scroll_velocity_x *= decay;
+            m_scroll_velocity_y *= decay;
+            if (std::abs(m_scroll_velocity_x) < MIN_KINETIC_SCROLL_SPEED) m_scroll_velocity_x = 0.0f;
+            if (std::abs(m_scroll_velocity_y) < MIN_KINETIC_SCROLL_SPEED) m_scroll_velocity_y = 0.0f;
+        } else {
+            m_scroll_velocity_x = 0.0f;
+            m_scroll_velocity_y = 0.0f;
+        }
+
+        m_scroll_remainder_x += m_scroll_pending_x;
+        m_scroll_remainder_y += m_scroll_pending_y;
+        m_scroll_pending_x = 0.0f;
+        m_scroll_pending_y = 0.0f;
+        int scroll_x = static_cast<int>(m_scroll_remainder_x);
+        int scroll_y = static_cast<int>(m_scroll_remainder_y);
+        m_scroll_remainder_x -= scroll_x;
+        m_scroll_remainder_y -= scroll_y;
+        if (scroll_y != 0) {
+            m_output->scrollVertical(scroll_y);
+            m_stats.scroll_events++;
+        }
+        if (scroll_x != 0) {
+            m_output->scrollHorizontal(scroll_x);
+            m_stats.scroll_events++;
+        }
     }
 
     void handleButtonDown(const SDL_GamepadButtonEvent& event) {
@@ -630,16 +1872,16 @@ private:
             
             // Handle mouse clicks
             if (action.click_type != MouseClickType::NONE) {
-                platform_simulate_mouse_down(static_cast<int>(action.click_type));
+                m_output->mouseDown(action.click_type);
             }
             
             // Handle keyboard keys
             if (action.key_type != KeyboardKeyType::NONE) {
-                platform_simulate_key_down(static_cast<int>(action.key_type));
+                m_output->keyDown(action.key_type);
                 
                 // Track press time for repeat logic
                 if (action.repeat_on_hold) {
-                    Uint32 current_time = SDL_GetTicks();
+                    Uint64 current_time = m_clock->nowMs();
                     m_button_press_times[instance_id][button_name] = current_time;
                     m_last_repeat_times[instance_id][button_name] = current_time;
                 }
@@ -655,12 +1897,12 @@ private:
             
             // Handle mouse clicks
             if (action.click_type != MouseClickType::NONE) {
-                platform_simulate_mouse_up(static_cast<int>(action.click_type));
+                m_output->mouseUp(action.click_type);
             }
             
             // Handle keyboard keys
             if (action.key_type != KeyboardKeyType::NONE) {
-                platform_simulate_key_up(static_cast<int>(action.key_type));
+                m_output->keyUp(action.key_type);
                 
                 // Clear repeat timing tracking
                 if (action.repeat_on_hold) {
@@ -672,7 +1914,7 @@ private:
     }
 
     void handleRepeatTiming() {
-        Uint32 current_time = SDL_GetTicks();
+        Uint64 current_time = m_clock->nowMs();
         
         for (auto const& [instance_id, held_buttons] : m_buttons_held) {
             for (const auto& button_name : held_buttons) {
@@ -699,15 +1941,15 @@ private:
                     auto& press_time = m_button_press_times[instance_id][button_name];
                     auto& last_repeat = m_last_repeat_times[instance_id][button_name];
                     
-                    Uint32 time_since_press = current_time - press_time;
-                    Uint32 time_since_last_repeat = current_time - last_repeat;
+                    Uint64 time_since_press = current_time - press_time;
+                    Uint64 time_since_last_repeat = current_time - last_repeat;
                     
                     // Initial delay before first repeat
                     if (time_since_press >= action.repeat_delay) {
                         // Check if it's time for the next repeat
                         if (time_since_last_repeat >= action.repeat_interval) {
-                            platform_simulate_key_down(static_cast<int>(action.key_type));
-                            platform_simulate_key_up(static_cast<int>(action.key_type));
+                            m_output->keyDown(action.key_type);
+                            m_output->keyUp(action.key_type);
                             last_repeat = current_time;
                         }
                     }
@@ -724,13 +1966,102 @@ private:
     std::unordered_map<int, std::pair<float, float>> m_left_stick_velocity;
     std::unordered_map<int, std::pair<float, float>> m_right_stick_velocity;
     std::unordered_map<int, bool> m_l3_held;
+
+    // Acceleration tables compiled from each controller's stick mappings
+    struct StickCurves {
+        AccelerationLut left;
+        AccelerationLut right;
+        float left_full_tilt_time = 0.0f;
+        float right_full_tilt_time = 0.0f;
+    };
+    std::unordered_map<int, StickCurves> m_stick_curves;
+
+    // Gyro cursor state for controllers whose profile enables it
+    std::unordered_map<int, GyroState> m_gyros;
+
+    // Trackpad state for controllers whose profile enables it
+    std::unordered_map<int, TouchpadState> m_touchpads;
+
+    // Trigger press and scroll state, removed with the controller
+    std::unordered_map<int, TriggerState> m_triggers;
+    // Learned stick rest positions, stored in the config on disconnect and while they change
+    std::unordered_map<int, CalibrationState> m_calibrations;
+
+    // Axis rest tracking for the idle fast path
+    std::unordered_map<int, AxisActivity> m_axis_activity;
+
+    // Raw input published for other threads; written only at the end of pollEvents
+    struct PublishedInput {
+        int slot = 0;
+        InputSnapshot snapshot = {};
+        bool dirty = true;
+    };
+    std::unordered_map<int, PublishedInput> m_published_input;
+    InputSnapshotTable m_snapshot_table;
     std::unordered_map<int, bool> m_r3_held;
     std::unordered_map<int, std::set<std::string>> m_buttons_held;
+
+    // Cursor motion collected from each controller during the current frame
+    struct CursorMotion {
+        int instance_id;
+        float x;
+        float y;
+    };
+    std::vector<CursorMotion> m_cursor_motion;
+    std::unordered_map<int, uint64_t> m_cursor_started_frame; // Frame each moving controller started moving
+    float m_cursor_remainder_x = 0.0f; // Sub-pixel motion not yet emitted
+    float m_cursor_remainder_y = 0.0f;
+
+    // Output pacing
+    float m_output_elapsed = 0.0f; // Seconds of input accumulated since the last output frame
+    Uint64 m_output_interval_ns = 0;
+    Uint64 m_next_output_ns = 0;
+    Uint64 m_first_output_ns = 0;
+    Uint64 m_last_output_ns = 0;
+    uint64_t m_output_interval_count = 0;
+    double m_output_interval_mean = 0.0;
+    double m_output_interval_m2 = 0.0;
+
+    // Scroll queued since the last output frame, leftover fractions, and coasting speed (units per second)
+    static constexpr float MIN_KINETIC_SCROLL_SPEED = 10.0f;
+    float m_scroll_pending_x = 0.0f;
+    float m_scroll_pending_y = 0.0f;
+    float m_scroll_remainder_x = 0.0f;
+    float m_scroll_remainder_y = 0.0f;
+    float m_scroll_velocity_x = 0.0f;
+    float m_scroll_velocity_y = 0.0f;
+    bool m_stick_scroll_held = false;
+    bool m_trigger_scroll_held = false; // Some controller's scroll trigger is held
+    bool m_touch_scroll_held = false;   // Two fingers are on a touchpad
+    CoreStats m_stats;
+
+    // Current stats window and the figures of the last completed one
+    LiveStats m_live_stats;
+    Uint64 m_window_start_ns = 0;
+    uint64_t m_window_output_commands = 0;
+    LatencyHistogram m_window_frame_time;
+    DelayHistogram m_window_input_latency;
+    Uint64 m_pending_input_ns = 0; // Time of the first controller event not yet followed by output
+    Uint64 m_event_dequeued_ns = 0; // Time the input event being handled was taken off SDL's queue
+
+    // Controllers forwarded to a virtual gamepad, with the virtual button for each source button
+    struct VirtualGamepad {
+        uint8_t buttons[kGamepadButtonCount];
+    };
+    std::unordered_map<int, VirtualGamepad> m_virtual_gamepads;
+    std::vector<Uint64> m_forwarded_timestamps; // Dequeue times of events forwarded this poll
+
+    std::unique_ptr<OutputSink> m_output;
+
+    std::shared_ptr<Clock> m_clock = systemClock();
+    bool m_frame_started = false;
+    Uint64 m_last_frame_ns = 0; // Start of the previous poll
+    Uint64 m_last_step_ns = 0;  // Time step of the last poll that was not after an idle wait
+    bool m_resumed_from_idle = false;
     
-    // Repeat timing tracking
-    Uint32 m_last_repeat_time;
-    std::unordered_map<int, std::unordered_map<std::string, Uint32>> m_button_press_times;
-    std::unordered_map<int, std::unordered_map<std::string, Uint32>> m_last_repeat_times;
+    // Repeat timing tracking, in clock milliseconds
+    std::unordered_map<int, std::unordered_map<std::string, Uint64>> m_button_press_times;
+    std::unordered_map<int, std::unordered_map<std::string, Uint64>> m_last_repeat_times;
 
     // Callback functions for core integration
     ControllerConnectedCallback m_controllerConnectedCallback = nullptr;
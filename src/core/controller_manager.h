@@ -2,9 +2,19 @@
 // Interface for managing controllers (platform-independent)
 
 #pragma once
+#include "clock.h"
+#include "core_stats.h"
+#include "input_snapshot.h"
+#include "output_sink.h"
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <functional>
 
+// Longest frame that is integrated as motion; anything longer (a stall, a
+// suspend) resets the motion filters. Time blocked in waitForInput does not count.
+constexpr uint64_t kMaxFrameGapNs = 100 * kNsPerMs;
+
 // Callback types for core integration
 using ControllerConnectedCallback = std::function<void(const std::string& guid, const std::string& name)>;
 using ControllerDisconnectedCallback = std::function<void(const std::string& guid)>;
@@ -12,9 +22,32 @@ using ControllerDisconnectedCallback = std::function<void(const std::string& gui
 class ControllerManager {
 public:
     virtual void detectControllers() = 0;
-    virtual void pollEvents(float deltaTime = 0.005f) = 0;
+    // Runs one frame. The time step is measured on the manager's clock; after a
+    // gap longer than kMaxFrameGapNs motion restarts from rest instead. The poll
+    // after an idle waitForInput steps by an ordinary frame.
+    virtual void pollEvents() = 0;
     virtual bool hasActiveController() const = 0;
     virtual std::string getActiveControllerName() const = 0;
+    virtual CoreStats getStats() const = 0;
+    // Rates and percentiles of the last stats window, with the running totals
+    virtual LiveStats liveStats() const = 0;
+
+    // Latest input of each controller; may be read from any thread
+    virtual const InputSnapshotTable& inputSnapshots() const = 0;
+
+    // Called between polls. Blocks for up to max_wait_ms until new input arrives
+    // if every controller is at rest and nothing is pending; otherwise returns at once.
+    // Returns true if it blocked and input arrived, so the caller should poll now.
+    virtual bool waitForInput(uint32_t max_wait_ms) = 0;
+
+    // Ends a waitForInput in progress early. May be called from any thread.
+    virtual void wake() = 0;
+
+    // Replaces where mouse, keyboard and gamepad output is sent
+    virtual void setOutputSink(std::unique_ptr<OutputSink> sink) = 0;
+
+    // Replaces the time source, systemClock() by default
+    virtual void setClock(std::shared_ptr<Clock> clock) = 0;
     
     // Callback setters for core integration
     virtual void setControllerConnectedCallback(ControllerConnectedCallback callback) = 0;
@@ -0,0 +1,364 @@
+// core_server.cpp
+// Implementation for the headless core's control socket
+
+#include "core_server.h"
+#include "joycursor_core.h"
+#include "mapping_json.h"
+#include "utils/logging.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <future>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr size_t kMaxRequestLength = 1024 * 1024;   // Longer lines drop the client
+constexpr size_t kMaxClients = 8;
+// How long a request waits for the polling thread before failing, so a
+// stalled core cannot hang the socket thread
+constexpr auto kRequestTimeout = std::chrono::seconds(2);
+
+template <typename T>
+bool waitForResult(std::future<T>& result) {
+    return result.wait_for(kRequestTimeout) == std::future_status::ready;
+}
+
+std::vector<std::string> stringList(const nlohmann::json& json) {
+    std::vector<std::string> names;
+    if (json.is_array()) {
+        for (const auto& name : json) {
+            if (name.is_string()) {
+                names.push_back(name.get<std::string>());
+            }
+        }
+    }
+    return names;
+}
+}
+
+CoreServer::CoreServer(JoyCursorCore& core) : m_core(core) {
+    m_core.setControllerConnectedCallback([this](const std::string& guid, const std::string& name) {
+        queueEvent(nlohmann::json{{"event", "connected"}, {"guid", guid}, {"name", name}}.dump());
+    });
+    m_core.setControllerDisconnectedCallback([this](const std::string& guid) {
+        queueEvent(nlohmann::json{{"event", "disconnected"}, {"guid", guid}}.dump());
+    });
+}
+
+CoreServer::~CoreServer() {
+    stop();
+    m_core.setControllerConnectedCallback(nullptr);
+    m_core.setControllerDisconnectedCallback(nullptr);
+}
+
+void CoreServer::publish() {
+    if (!m_shared) {
+        return;
+    }
+    SharedCoreState* state = m_shared->state();
+    if (const InputSnapshotTable* input = m_core.inputSnapshots()) {
+        for (int i = 0; i < kMaxSnapshotControllers; ++i) {
+            InputSnapshot snapshot;
+            if (input->slots[i].load(snapshot) && std::memcmp(&snapshot, &m_publishedInput[i], sizeof(snapshot)) != 0) {
+                state->input.slots[i].store(snapshot);
+                m_publishedInput[i] = snapshot;
+            }
+        }
+    }
+    LiveStats stats;
+    if (m_core.liveStats()->load(stats) && std::memcmp(&stats, &m_publishedStats, sizeof(stats)) != 0) {
+        state->stats.store(stats);
+        m_publishedStats = stats;
+    }
+}
+
+std::string CoreServer::handleRequest(const std::string& line) {
+    nlohmann::json request = nlohmann::json::parse(line, nullptr, false);
+    if (!request.is_object()) {
+        return nlohmann::json{{"error", "malformed request"}}.dump();
+    }
+    // A client of another version may send fields of unexpected types
+    try {
+        nlohmann::json reply = {{"id", request.value("id", 0)}};
+        std::string cmd = request.value("cmd", "");
+        std::string guid = request.value("guid", "");
+
+        if (cmd == "controllers") {
+            using ControllerLists = std::pair<std::map<std::string, std::string>, std::map<std::string, std::string>>;
+            auto result = m_core.call([](JoyCursorCore& core) {
+                return ControllerLists(core.getKnownControllers(), core.getConnectedControllers());
+            });
+            if (!waitForResult(result)) {
+                reply["error"] = "core did not respond";
+                return reply.dump();
+            }
+            ControllerLists lists = result.get();
+            reply["known"] = lists.first;
+            reply["connected"] = lists.second;
+        } else if (cmd == "get_mappings" && !guid.empty()) {
+            std::vector<std::string> buttons = stringList(request.value("buttons", nlohmann::json()));
+            std::vector<std::string> triggers = stringList(request.value("triggers", nlohmann::json()));
+            auto result = m_core.call([guid, buttons, triggers](JoyCursorCore& core) {
+                return core.getMappingProfile(guid, buttons, triggers);
+            });
+            if (!waitForResult(result)) {
+                reply["error"] = "core did not respond";
+                return reply.dump();
+            }
+            reply["fields"] = mappingFieldsToJson(flattenMappingProfile(result.get()));
+        } else if (cmd == "save_mappings" && !guid.empty()) {
+            MappingFields fields;
+            if (!mappingFieldsFromJson(request.value("fields", nlohmann::json()), fields)) {
+                reply["error"] = "fields must be an object";
+                return reply.dump();
+            }
+            MappingProfile profile;
+            for (const auto& [path, value] : fields) {
+                applyMappingField(profile, path, value);
+            }
+            // Saving rewrites mappings.json; the reply is sent once the core has applied it
+            auto result = m_core.call([guid, profile](JoyCursorCore& core) {
+                return core.applyMappingProfile(guid, profile);
+            });
+            if (!waitForResult(result)) {
+                reply["error"] = "core did not respond";
+                return reply.dump();
+            }
+            bool saved = result.get();
+            reply["ok"] = saved;
+            if (!saved) {
+                reply["error"] = "mappings.json could not be saved";
+            }
+        } else {
+            reply["error"] = "unknown command: " + cmd;
+        }
+        return reply.dump();
+    } catch (const nlohmann::json::exception&) {
+        nlohmann::json reply = {{"error", "malformed request"}};
+        auto id = request.find("id");
+        if (id != request.end() && id->is_number_integer()) {
+            reply["id"] = *id;
+        }
+        return reply.dump();
+    }
+}
+
+#ifdef __linux__
+bool CoreServer::start() {
+    if (m_running) {
+        return true;
+    }
+    m_socketPath = coreSocketPath();
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (m_socketPath.size() >= sizeof(address.sun_path)) {
+        logError(("Core socket path is too long: " + m_socketPath).c_str());
+        return false;
+    }
+    std::strcpy(address.sun_path, m_socketPath.c_str());
+
+    // A socket file that accepts connections belongs to a running core; one
+    // that refuses them was left behind by a core that exited and is replaced
+    int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe >= 0) {
+        bool in_use = connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        close(probe);
+        if (in_use) {
+            logError(("Another core is already serving at " + m_socketPath).c_str());
+            return false;
+        }
+    }
+    unlink(m_socketPath.c_str());
+
+    m_listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (m_listenFd < 0 || bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || chmod(m_socketPath.c_str(), 0600) != 0 || listen(m_listenFd, 4) != 0) {
+        logError(("Failed to listen on " + m_socketPath + ": " + std::strerror(errno)).c_str());
+        stop();
+        return false;
+    }
+    if (pipe2(m_wakeFds, O_CLOEXEC | O_NONBLOCK) != 0) {
+        logError("Failed to create the core server wake pipe");
+        stop();
+        return false;
+    }
+
+    // Input keeps working without the page; only live displays in UIs are lost
+    m_shared = SharedStateMapping::create();
+
+    m_running = true;
+    m_thread = std::thread(&CoreServer::run, this);
+    logInfo(("Core serving at " + m_socketPath).c_str());
+    return true;
+}
+
+void CoreServer::stop() {
+    if (m_running.exchange(false)) {
+        char byte = 0;
+        (void)!write(m_wakeFds[1], &byte, 1);
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    for (const Client& client : m_clients) {
+        close(client.fd);
+    }
+    m_clients.clear();
+    if (m_listenFd >= 0) {
+        close(m_listenFd);
+        unlink(m_socketPath.c_str());
+        m_listenFd = -1;
+    }
+    for (int& fd : m_wakeFds) {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+
+void CoreServer::queueEvent(std::string line) {
+    if (!m_running) {
+        return;
+    }
+    m_events.push(std::move(line));
+    char byte = 0;
+    (void)!write(m_wakeFds[1], &byte, 1);
+}
+
+void CoreServer::run() {
+    std::vector<pollfd> fds;
+    while (m_running) {
+        fds.clear();
+        fds.push_back({m_listenFd, POLLIN, 0});
+        fds.push_back({m_wakeFds[0], POLLIN, 0});
+        for (const Client& client : m_clients) {
+            fds.push_back({client.fd, POLLIN, 0});
+        }
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            logError("Core server poll failed");
+            break;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            char drain[64];
+            while (read(m_wakeFds[0], drain, sizeof(drain)) > 0) {}
+            std::string event;
+            while (m_events.pop(event)) {
+                for (Client& client : m_clients) {
+                    client.broken = client.broken || !sendLine(client, event);
+                }
+            }
+        }
+
+        // Clients are matched to their poll entries by position, so walk the
+        // entries before accepting new clients
+        std::vector<Client> remaining;
+        for (size_t i = 0; i < m_clients.size(); ++i) {
+            Client& client = m_clients[i];
+            short revents = fds[i + 2].revents;
+            bool keep = !client.broken && !(revents & (POLLERR | POLLNVAL)) && (!(revents & (POLLIN | POLLHUP)) || readClient(client));
+            if (keep) {
+                remaining.push_back(std::move(client));
+            } else {
+                close(client.fd);
+                logInfo("UI detached from core");
+            }
+        }
+        m_clients = std::move(remaining);
+
+        if (fds[0].revents & POLLIN) {
+            acceptClient();
+        }
+    }
+}
+
+void CoreServer::acceptClient() {
+    int fd;
+    while ((fd = accept4(m_listenFd, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK)) >= 0) {
+        if (m_clients.size() >= kMaxClients) {
+            close(fd);
+            continue;
+        }
+        m_clients.push_back({fd, std::string(), false});
+        logInfo("UI attached to core");
+    }
+}
+
+bool CoreServer::readClient(Client& client) {
+    char buffer[4096];
+    for (;;) {
+        ssize_t count = recv(client.fd, buffer, sizeof(buffer), 0);
+        if (count == 0) {
+            return false;
+        }
+        if (count < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        client.input.append(buffer, static_cast<size_t>(count));
+        size_t newline;
+        while ((newline = client.input.find('\n')) != std::string::npos) {
+            std::string line = client.input.substr(0, newline);
+            client.input.erase(0, newline + 1);
+            if (!sendLine(client, handleRequest(line))) {
+                return false;
+            }
+        }
+        if (client.input.size() > kMaxRequestLength) {
+            logError("Core request too long, dropping the UI connection");
+            return false;
+        }
+    }
+}
+
+bool CoreServer::sendLine(const Client& client, const std::string& line) {
+    // Sockets are non-blocking: a UI that stops reading is dropped rather than
+    // allowed to stall the server. It reconnects and asks again.
+    std::string message = line + "\n";
+    size_t sent = 0;
+    while (sent < message.size()) {
+        ssize_t count = send(client.fd, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(count);
+    }
+    return true;
+}
+#else
+// The headless core is only supported on Linux so far
+bool CoreServer::start() {
+    logError("The headless core is not supported on this platform");
+    return false;
+}
+
+void CoreServer::stop() {}
+
+void CoreServer::queueEvent(std::string) {}
+
+void CoreServer::run() {}
+
+void CoreServer::acceptClient() {}
+
+bool CoreServer::readClient(Client&) {
+    return false;
+}
+
+bool CoreServer::sendLine(const Client&, const std::string&) {
+    return false;
+}
+#endif
@@ -0,0 +1,79 @@
+// core_server.h
+// Control socket that lets the core run headless, with UIs in other processes
+
+#pragma once
+
+#include "command_queue.h"
+#include "core_stats.h"
+#include "input_snapshot.h"
+#include "shared_state.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class JoyCursorCore;
+
+// Serves a JoyCursorCore to UI processes. Commands arrive on a local socket,
+// one JSON object per line, and run on the polling thread through
+// JoyCursorCore::call(); live input and stats go to the shared state page.
+// UIs may attach and detach at any time without affecting input handling.
+//
+// Requests carry an "id" that is echoed in the reply:
+//   {"id":1,"cmd":"controllers"}
+//       -> {"id":1,"known":{guid:name},"connected":{guid:name}}
+//   {"id":2,"cmd":"get_mappings","guid":g,"buttons":[...],"triggers":[...]}
+//       -> {"id":2,"fields":{path:value}}
+//   {"id":3,"cmd":"save_mappings","guid":g,"fields":{path:value}}
+//       -> {"id":3,"ok":true}, or {"id":3,"ok":false,"error":message} if
+//          mappings.json could not be saved (the core then keeps its old mappings)
+// A failed request gets {"id":n,"error":message}. Connection changes are
+// pushed to every client as {"event":"connected","guid":g,"name":n} and
+// {"event":"disconnected","guid":g}.
+class CoreServer {
+public:
+    // Takes over the core's connection callbacks
+    explicit CoreServer(JoyCursorCore& core);
+    ~CoreServer();
+
+    CoreServer(const CoreServer&) = delete;
+    CoreServer& operator=(const CoreServer&) = delete;
+
+    // Creates the shared state page and the socket and starts serving.
+    // Fails if another core is already serving this user.
+    bool start();
+    void stop();
+
+    // Copies the core's live input and stats to the shared state page.
+    // Polling thread only; call after each pollEvents().
+    void publish();
+
+private:
+    struct Client {
+        int fd;
+        std::string input; // Received bytes not yet forming a full line
+        bool broken;       // A push failed; closed on the next pass
+    };
+
+    void run();
+    void acceptClient();
+    bool readClient(Client& client);
+    bool sendLine(const Client& client, const std::string& line);
+    std::string handleRequest(const std::string& line);
+    void queueEvent(std::string line);
+
+    JoyCursorCore& m_core;
+    std::unique_ptr<SharedStateMapping> m_shared;
+    // Last values written to the page, so unchanged slots are not rewritten
+    InputSnapshot m_publishedInput[kMaxSnapshotControllers] = {};
+    LiveStats m_publishedStats = {};
+
+    std::string m_socketPath;
+    int m_listenFd = -1;
+    int m_wakeFds[2] = {-1, -1};  // Wakes the socket thread when events are queued or on stop
+    std::vector<Client> m_clients; // Socket thread only
+    MpscQueue<std::string> m_events;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
@@ -0,0 +1,90 @@
+// core_stats.h
+// Counters describing the work done by the controller polling loop
+
+#pragma once
+
+#include <cstdint>
+
+// Latency distribution in fixed-width buckets; slower samples share the last bucket
+template <int BucketCount, uint64_t BucketWidthUs>
+struct Histogram {
+    static constexpr int kBucketCount = BucketCount;
+    static constexpr uint64_t kBucketWidthUs = BucketWidthUs;
+
+    uint64_t buckets[kBucketCount] = {};
+    uint64_t count = 0;
+
+    void record(uint64_t latency_us) {
+        uint64_t bucket = latency_us / kBucketWidthUs;
+        buckets[bucket < kBucketCount ? bucket : kBucketCount - 1]++;
+        count++;
+    }
+
+    void clear() {
+        *this = Histogram();
+    }
+
+    // Upper bound in microseconds of the bucket holding the given percentile (0-100)
+    uint64_t percentile(double p) const {
+        uint64_t rank = static_cast<uint64_t>(p / 100.0 * count);
+        uint64_t seen = 0;
+        for (int i = 0; i < kBucketCount; ++i) {
+            seen += buckets[i];
+            if (seen > rank) {
+                return (i + 1) * kBucketWidthUs;
+            }
+        }
+        return kBucketCount * kBucketWidthUs;
+    }
+};
+
+// 10 us buckets up to 2 ms
+using LatencyHistogram = Histogram<201, 10>;
+// 100 us buckets up to 50 ms, for delays that include output pacing
+using DelayHistogram = Histogram<501, 100>;
+
+struct CoreStats {
+    uint64_t frames = 0;               // Calls to pollEvents
+    uint64_t cursor_events = 0;        // Cursor motion events emitted
+    uint64_t scroll_events = 0;        // Wheel events emitted (vertical and horizontal)
+    uint64_t round_trips = 0;          // Synchronous display server calls (position queries and warps)
+    uint64_t gyro_samples = 0;         // Gyro readings integrated into cursor motion
+    uint64_t idle_skips = 0;           // Controllers skipped in a poll because their axes were at rest
+    uint64_t idle_waits = 0;           // Blocking waits for input made because all controllers were at rest
+    uint32_t last_frame_round_trips = 0;
+    uint32_t max_frame_round_trips = 0;
+
+    // Output pacing: cursor and scroll output is sent on output frames
+    uint64_t output_frames = 0;
+    uint64_t output_time_ns = 0;         // Time from the first to the latest output frame
+    double output_interval_mean_us = 0.0;
+    double output_jitter_us = 0.0;       // Standard deviation of the output interval
+
+    // Time from taking an SDL gamepad event off the queue to the matching
+    // virtual gamepad write, on the manager's clock
+    LatencyHistogram gamepad_latency;
+
+    uint64_t output_commands = 0;        // Commands committed to the output sink
+    uint64_t coalesced_frames = 0;       // Polls whose cursor or scroll motion waited for a later output frame
+    uint64_t dropped_motions = 0;        // Controllers' cursor motion discarded by the cursor merge policy
+    LatencyHistogram frame_time;         // Time spent in pollEvents
+    DelayHistogram input_latency;        // Time from dequeuing a controller event to the first output committed after it
+};
+
+// Summary of the polling loop for live displays, published once per poll.
+// Rates and percentiles cover the last completed stats window (about one
+// second); counters are totals since start.
+struct LiveStats {
+    uint64_t frames = 0;
+    uint64_t output_commands = 0;
+    uint64_t coalesced_frames = 0;
+    uint64_t dropped_motions = 0;
+    float poll_rate_hz = 0.0f;
+    float output_events_per_second = 0.0f;
+    uint32_t frame_time_p50_us = 0;
+    uint32_t frame_time_p99_us = 0;
+    uint32_t input_latency_p99_us = 0;   // 0 if no output followed input during the window
+    uint32_t config_save_us = 0;         // Duration of the last configuration save, 0 if none yet
+    uint32_t config_load_us = 0;         // Duration of the last configuration load
+    uint32_t mapping_reload_us = 0;      // Duration of the last reload of the controllers' mappings
+};
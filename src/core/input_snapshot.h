@@ -0,0 +1,43 @@
+// input_snapshot.h
+// Latest raw input of each connected controller, published by the polling
+// thread for readers on other threads (the GUI's live visualizer)
+
+#pragma once
+
+#include "seqlock.h"
+#include <cstdint>
+#include <cstring>
+
+constexpr int kInputSnapshotAxes = 6;        // SDL_GamepadAxis order: LX, LY, RX, RY, LT, RT
+constexpr int kMaxSnapshotControllers = 8;   // Controllers beyond this are not published
+constexpr int kSnapshotGuidLength = 33;      // SDL GUID string plus terminator
+
+struct InputSnapshot {
+    char guid[kSnapshotGuidLength];          // Empty if the slot is unused
+    int16_t axes[kInputSnapshotAxes];
+    int16_t stick_rest[4];                   // Calibrated rest position of LX, LY, RX, RY; 0 if not calibrated
+    uint32_t buttons;                        // Bit n set while SDL_GamepadButton n is held
+    uint32_t version;                        // Incremented on every change
+};
+
+// Fixed table of snapshot slots; a controller keeps its slot while connected
+struct InputSnapshotTable {
+    SeqlockSlot<InputSnapshot> slots[kMaxSnapshotControllers];
+
+    // Latest snapshot of the controller with this GUID, if it is connected.
+    // busy is set when a slot was being written and could not be read, in
+    // which case a false result does not mean the controller is gone.
+    bool find(const char* guid, InputSnapshot& snapshot, bool* busy = nullptr) const {
+        if (busy) *busy = false;
+        for (const auto& slot : slots) {
+            if (!slot.load(snapshot)) {
+                if (busy) *busy = true;
+                continue;
+            }
+            if (snapshot.guid[0] != '\0' && std::strcmp(snapshot.guid, guid) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
@@ -4,10 +4,15 @@
 #include "config.h"
 #include "../utils/logging.h"
 
+namespace {
+uint32_t elapsedMicroseconds(const Clock& clock, uint64_t start_ns) {
+    return static_cast<uint32_t>((clock.nowNs() - start_ns) / 1000);
+}
+}
+
 JoyCursorCore::JoyCursorCore() 
     : m_controllerManager(std::unique_ptr<ControllerManager>(createControllerManager()))
-    , m_deltaTime(0.005f) // Default to 5ms
-    , m_lastPollTime(std::chrono::steady_clock::now()) {
+    , m_clock(systemClock()) {
 }
 
 JoyCursorCore::~JoyCursorCore() {
@@ -20,7 +25,7 @@ bool JoyCursorCore::initialize() {
         m_config = std::make_unique<Config>();
         
         // Initialize mapping manager with the configuration
-        m_mappingManager = std::make_unique<MappingManager>(m_config->getMappingsJson());
+        m_mappingManager = std::make_unique<MappingManager>(*m_config);
         
         // Connect controller manager callbacks to core events
         if (m_controllerManager) {
@@ -37,10 +42,6 @@ bool JoyCursorCore::initialize() {
             );
         }
         
-        // Initialize time tracking
-        m_lastPollTime = std::chrono::steady_clock::now();
-        m_deltaTime = 0.005f; // Start with 5ms
-        
         logInfo("JoyCursorCore initialized successfully");
         return true;
     } catch (const std::exception& e) {
@@ -62,26 +63,44 @@ void JoyCursorCore::shutdown() {
 }
 
 void JoyCursorCore::pollEvents() {
-    // Update delta time first
-    updateDeltaTime();
-    
+    // Mapping edits and queries from other threads apply between frames
+    runCommands();
+
     if (m_controllerManager) {
-        m_controllerManager->pollEvents(m_deltaTime);
+        m_controllerManager->pollEvents();
         processControllerEvents();
+        publishLiveStats();
+    }
+}
+
+void JoyCursorCore::publishLiveStats() {
+    LiveStats live = m_controllerManager->liveStats();
+    live.config_save_us = m_configSaveUs;
+    live.config_load_us = m_configLoadUs;
+    live.mapping_reload_us = m_mappingReloadUs;
+    m_liveStats.store(live);
+}
+
+void JoyCursorCore::post(CoreCommand command) {
+    m_commands.push(std::move(command));
+    if (m_controllerManager) {
+        m_controllerManager->wake();
     }
 }
 
-void JoyCursorCore::updateDeltaTime() {
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - m_lastPollTime);
-    m_deltaTime = elapsed.count() / 1000000.0f; // Convert to seconds
-    
-    // Clamp delta time to prevent huge jumps (e.g., if system was suspended)
-    if (m_deltaTime > 0.1f) {
-        m_deltaTime = 0.005f; // Cap at 100ms, default to 5ms
+void JoyCursorCore::runCommands() {
+    CoreCommand command;
+    while (m_commands.pop(command)) {
+        try {
+            command(*this);
+        } catch (const std::exception& e) {
+            logError(("Core command failed: " + std::string(e.what())).c_str());
+        }
     }
-    
-    m_lastPollTime = now;
+}
+
+bool JoyCursorCore::waitForInput(uint32_t max_wait_ms) {
+    return m_controllerManager && m_controllerManager->waitForInput(max_wait_ms);
 }
 
 bool JoyCursorCore::hasActiveController() const {
@@ -101,6 +120,33 @@ std::string JoyCursorCore::getActiveControllerGuid() const {
     return "";
 }
 
+CoreStats JoyCursorCore::getStats() const {
+    if (m_controllerManager) {
+        return m_controllerManager->getStats();
+    }
+    return CoreStats{};
+}
+
+const InputSnapshotTable* JoyCursorCore::inputSnapshots() const {
+    return m_controllerManager ? &m_controllerManager->inputSnapshots() : nullptr;
+}
+
+void JoyCursorCore::setOutputSink(std::unique_ptr<OutputSink> sink) {
+    if (m_controllerManager) {
+        m_controllerManager->setOutputSink(std::move(sink));
+    }
+}
+
+void JoyCursorCore::setClock(std::shared_ptr<Clock> clock) {
+    if (!clock) {
+        return;
+    }
+    m_clock = clock;
+    if (m_controllerManager) {
+        m_controllerManager->setClock(std::move(clock));
+    }
+}
+
 std::map<std::string, std::string> JoyCursorCore::getKnownControllers() const {
     if (m_config) {
         return m_config->getKnownControllers();
@@ -116,8 +162,10 @@ bool JoyCursorCore::loadConfiguration(const std::string& configPath) {
     try {
         if (m_config) {
             // Reload configuration
+            uint64_t start = m_clock->nowNs();
             m_config = std::make_unique<Config>();
-            m_mappingManager = std::make_unique<MappingManager>(m_config->getMappingsJson());
+            m_mappingManager = std::make_unique<MappingManager>(*m_config);
+            m_configLoadUs = elapsedMicroseconds(*m_clock, start);
             return true;
         }
         return false;
@@ -130,9 +178,11 @@ bool JoyCursorCore::loadConfiguration(const std::string& configPath) {
 bool JoyCursorCore::saveConfiguration(const std::string& configPath) {
     try {
         if (m_config) {
+            uint64_t start = m_clock->nowNs();
             m_config->saveControllers();
-            m_config->saveMappings();
-            return true;
+            bool saved = m_config->saveMappings();
+            m_configSaveUs = elapsedMicroseconds(*m_clock, start);
+            return saved;
         }
         return false;
     } catch (const std::exception& e) {
@@ -149,7 +199,9 @@ void JoyCursorCore::clearMappingCache() {
 
 void JoyCursorCore::reloadControllerMappings() {
     if (m_controllerManager) {
+        uint64_t start = m_clock->nowNs();
         m_controllerManager->reloadMappings();
+        m_mappingReloadUs = elapsedMicroseconds(*m_clock, start);
     }
 }
 
@@ -205,6 +257,41 @@ void JoyCursorCore::setTriggerMapping(const std::string& controllerGuid, const s
     }
 }
 
+MappingProfile JoyCursorCore::getMappingProfile(const std::string& controllerGuid, const std::vector<std::string>& buttons,
+                                               const std::vector<std::string>& triggers) {
+    MappingProfile profile;
+    profile.left_stick = getLeftStickMapping(controllerGuid);
+    profile.right_stick = getRightStickMapping(controllerGuid);
+    for (const std::string& button : buttons) {
+        profile.buttons[button] = getButtonMapping(controllerGuid, button);
+    }
+    for (const std::string& trigger : triggers) {
+        profile.triggers[trigger] = getTriggerMapping(controllerGuid, trigger);
+    }
+    return profile;
+}
+
+bool JoyCursorCore::applyMappingProfile(const std::string& controllerGuid, const MappingProfile& profile) {
+    setLeftStickMapping(controllerGuid, profile.left_stick);
+    setRightStickMapping(controllerGuid, profile.right_stick);
+    for (const auto& [button, mapping] : profile.buttons) {
+        setButtonMapping(controllerGuid, button, mapping);
+    }
+    for (const auto& [trigger, mapping] : profile.triggers) {
+        setTriggerMapping(controllerGuid, trigger, mapping);
+    }
+    // Write mappings.json, then rebuild the caches and compiled mappings from it.
+    // Reloading after a failed save would replace the edits with the file.
+    if (!saveConfiguration()) {
+        logError(("Mappings for " + controllerGuid + " were not saved").c_str());
+        return false;
+    }
+    clearMappingCache();
+    loadConfiguration();
+    reloadControllerMappings();
+    return true;
+}
+
 void JoyCursorCore::addKnownController(const std::string& guid, const std::string& name) {
     if (m_config) {
         m_config->addController(guid, name);
@@ -1,11 +1,20 @@
 #pragma once
 
+#include "clock.h"
+#include "command_queue.h"
+#include "core_stats.h"
+#include "input_snapshot.h"
+#include "output_sink.h"
+#include "seqlock.h"
 #include "types.h"
 #include <string>
 #include <functional>
 #include <memory>
 #include <map>
-#include <chrono>
+#include <exception>
+#include <future>
+#include <type_traits>
+#include <vector>
 
 // Forward declarations
 class ControllerManager;
@@ -19,6 +28,11 @@ using ButtonEventCallback = std::function<void(const std::string& guid, const st
 using StickEventCallback = std::function<void(const std::string& guid, const std::string& stick, float x, float y)>;
 using TriggerEventCallback = std::function<void(const std::string& guid, const std::string& trigger, float value)>;
 
+class JoyCursorCore;
+
+// Work handed to the core from another thread
+using CoreCommand = std::function<void(JoyCursorCore& core)>;
+
 // Main core class that unifies all functionality
 class JoyCursorCore {
 public:
@@ -29,11 +43,58 @@ public:
     bool initialize();
     void shutdown();
     void pollEvents();
+    // Blocks for up to max_wait_ms while all controllers are idle. Returns true if
+    // input arrived during the wait; see ControllerManager::waitForInput
+    bool waitForInput(uint32_t max_wait_ms);
+
+    // Queues a command to run on the polling thread at the start of the next
+    // pollEvents(). post(), call(), inputSnapshots() and liveStats() are the only
+    // members that may be used from other threads; everything else belongs to the
+    // polling thread.
+    void post(CoreCommand command);
+
+    // Like post(), with the command's result (or exception) delivered through a future
+    template <typename F>
+    auto call(F command) -> std::future<std::invoke_result_t<F, JoyCursorCore&>> {
+        using Result = std::invoke_result_t<F, JoyCursorCore&>;
+        auto promise = std::make_shared<std::promise<Result>>();
+        std::future<Result> result = promise->get_future();
+        post([promise, command](JoyCursorCore& core) {
+            try {
+                if constexpr (std::is_void_v<Result>) {
+                    command(core);
+                    promise->set_value();
+                } else {
+                    promise->set_value(command(core));
+                }
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+        return result;
+    }
 
     // Controller management
     bool hasActiveController() const;
     std::string getActiveControllerName() const;
     std::string getActiveControllerGuid() const;
+
+    // Polling loop counters
+    CoreStats getStats() const;
+
+    // Raw controller input published once per poll; null before initialization
+    const InputSnapshotTable* inputSnapshots() const;
+
+    // Poll loop summary and configuration timings, published once per poll
+    const SeqlockSlot<LiveStats>* liveStats() const { return &m_liveStats; }
+
+    // Replaces the output sink chosen by settings.json, e.g. with a NullOutputSink
+    // to run the core without injecting input
+    void setOutputSink(std::unique_ptr<OutputSink> sink);
+
+    // Replaces the time source of the core and its controller manager, e.g.
+    // with a ManualClock to simulate timing. Call before polling starts.
+    void setClock(std::shared_ptr<Clock> clock);
     
     // Get all known controllers
     std::map<std::string, std::string> getKnownControllers() const; // guid -> name
@@ -60,6 +121,14 @@ public:
     void setRightStickMapping(const std::string& controllerGuid, const StickMapping& mapping);
     void setButtonMapping(const std::string& controllerGuid, const std::string& button, const ButtonMapping& mapping);
     void setTriggerMapping(const std::string& controllerGuid, const std::string& trigger, const TriggerMapping& mapping);
+
+    // The sticks and the named buttons and triggers of a controller gathered into one profile
+    MappingProfile getMappingProfile(const std::string& controllerGuid, const std::vector<std::string>& buttons,
+                                     const std::vector<std::string>& triggers);
+    // Stores the sticks, buttons and triggers of profile, then saves and reloads the
+    // configuration. Returns false if mappings.json could not be saved; the edits
+    // are then kept in memory only and nothing is reloaded.
+    bool applyMappingProfile(const std::string& controllerGuid, const MappingProfile& profile);
     
     // Controller management
     void addKnownController(const std::string& guid, const std::string& name);
@@ -83,18 +152,26 @@ private:
     ButtonEventCallback m_buttonEventCallback;
     StickEventCallback m_stickEventCallback;
     TriggerEventCallback m_triggerEventCallback;
+
+    // Commands posted by other threads, drained at frame boundaries
+    MpscQueue<CoreCommand> m_commands;
+
+    SeqlockSlot<LiveStats> m_liveStats;
+    // Durations of the last configuration save, load and mapping reload
+    uint32_t m_configSaveUs = 0;
+    uint32_t m_configLoadUs = 0;
+    uint32_t m_mappingReloadUs = 0;
     
     // Internal state tracking
     std::map<std::string, std::string> m_connectedControllers; // guid -> name
     std::map<std::string, std::string> m_previousConnectedControllers; // for change detection
     
-    // Time tracking for consistent movement
-    std::chrono::steady_clock::time_point m_lastPollTime;
-    float m_deltaTime; // Time since last poll in seconds
-    
+    std::shared_ptr<Clock> m_clock;
+
     // Internal methods
     void onControllerConnected(const std::string& guid, const std::string& name);
     void onControllerDisconnected(const std::string& guid);
     void processControllerEvents();
-    void updateDeltaTime();
+    void runCommands();
+    void publishLiveStats();
 }; 
\ No newline at end of file
@@ -0,0 +1,371 @@
+// mapping_fields.cpp
+// Implementation for field-level profile access
+
+#include "mapping_fields.h"
+#include "acceleration_curve.h"
+#include "action_registry.h"
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+// Splits "a.b.c" into "a" and "b.c"
+void splitPath(const std::string& path, std::string& head, std::string& rest) {
+    size_t dot = path.find('.');
+    if (dot == std::string::npos) {
+        head = path;
+        rest.clear();
+    } else {
+        head = path.substr(0, dot);
+        rest = path.substr(dot + 1);
+    }
+}
+
+bool readBool(const MappingValue& value, bool& out) {
+    if (const bool* b = std::get_if<bool>(&value)) {
+        out = *b;
+        return true;
+    }
+    return false;
+}
+
+bool readInt(const MappingValue& value, int& out) {
+    if (const int* i = std::get_if<int>(&value)) {
+        out = *i;
+        return true;
+    }
+    if (const double* d = std::get_if<double>(&value)) {
+        // Out-of-range conversions are undefined, so clamp first
+        out = static_cast<int>(std::clamp(*d, static_cast<double>(INT_MIN), static_cast<double>(INT_MAX)));
+        return true;
+    }
+    return false;
+}
+
+bool readFloat(const MappingValue& value, float& out) {
+    if (const double* d = std::get_if<double>(&value)) {
+        out = static_cast<float>(std::clamp(*d, -static_cast<double>(FLT_MAX), static_cast<double>(FLT_MAX)));
+        return true;
+    }
+    if (const int* i = std::get_if<int>(&value)) {
+        out = static_cast<float>(*i);
+        return true;
+    }
+    return false;
+}
+
+bool readString(const MappingValue& value, std::string& out) {
+    if (const std::string* s = std::get_if<std::string>(&value)) {
+        out = *s;
+        return true;
+    }
+    return false;
+}
+
+bool readActions(const MappingValue& value, std::vector<ButtonAction>& out) {
+    if (const auto* actions = std::get_if<std::vector<ButtonAction>>(&value)) {
+        out = *actions;
+        return true;
+    }
+    return false;
+}
+
+bool applyAccelerationField(AccelerationCurve& curve, const std::string& path, const MappingValue& value) {
+    if (path == "curve") {
+        std::string name;
+        if (!readString(value, name)) return false;
+        curve.type = parseAccelerationCurveType(name);
+        return true;
+    }
+    if (path == "points") {
+        std::string text;
+        return readString(value, text) && parseAccelerationPoints(text, curve.points);
+    }
+    if (path == "exponent") return readFloat(value, curve.exponent);
+    if (path == "control1_x") return readFloat(value, curve.control1_x);
+    if (path == "control1_y") return readFloat(value, curve.control1_y);
+    if (path == "control2_x") return readFloat(value, curve.control2_x);
+    if (path == "control2_y") return readFloat(value, curve.control2_y);
+    if (path == "ramp_time") return readFloat(value, curve.ramp_time);
+    if (path == "ramp_gain") return readFloat(value, curve.ramp_gain);
+    return false;
+}
+
+bool applyStickField(StickMapping& stick, const std::string& path, const MappingValue& value) {
+    if (path == "enabled") return readBool(value, stick.enabled);
+    if (path == "action_type") {
+        std::string name;
+        if (!readString(value, name)) return false;
+        stick.action_type = parseStickActionType(name);
+        return true;
+    }
+    if (path == "deadzone") return readInt(value, stick.deadzone);
+    if (path == "calibrate") return readBool(value, stick.calibrate);
+    if (path == "response_exponent") return readFloat(value, stick.response_exponent);
+    if (path == "cursor_action.sensitivity") return readFloat(value, stick.cursor_action.sensitivity);
+    if (path == "cursor_action.boosted_sensitivity") return readFloat(value, stick.cursor_action.boosted_sensitivity);
+    if (path == "cursor_action.smoothing") return readFloat(value, stick.cursor_action.smoothing);
+    if (path.compare(0, 27, "cursor_action.acceleration.") == 0) {
+        return applyAccelerationField(stick.cursor_action.acceleration, path.substr(27), value);
+    }
+    if (path == "scroll_action.vertical_sensitivity") return readFloat(value, stick.scroll_action.vertical_sensitivity);
+    if (path == "scroll_action.horizontal_sensitivity") return readFloat(value, stick.scroll_action.horizontal_sensitivity);
+    if (path == "scroll_action.vertical_max_speed") return readInt(value, stick.scroll_action.vertical_max_speed);
+    if (path == "scroll_action.horizontal_max_speed") return readInt(value, stick.scroll_action.horizontal_max_speed);
+    return false;
+}
+
+bool applyButtonField(ButtonMapping& button, const std::string& path, const MappingValue& value) {
+    if (path == "enabled") return readBool(value, button.enabled);
+    if (path == "actions") return readActions(value, button.actions);
+    return false;
+}
+
+bool applyGamepadOutputField(GamepadOutputMapping& output, const std::string& path, const MappingValue& value) {
+    if (path == "enabled") return readBool(value, output.enabled);
+    if (path.compare(0, 8, "buttons.") == 0 && path.size() > 8) {
+        std::string target;
+        if (!readString(value, target)) return false;
+        output.buttons[path.substr(8)] = target;
+        return true;
+    }
+    return false;
+}
+
+bool applyGyroField(GyroMapping& gyro, const std::string& path, const MappingValue& value) {
+    if (path == "enabled") return readBool(value, gyro.enabled);
+    if (path == "sensitivity") return readFloat(value, gyro.sensitivity);
+    if (path == "deadzone") return readFloat(value, gyro.deadzone);
+    if (path == "tightening") return readFloat(value, gyro.tightening);
+    if (path == "calibrate") return readBool(value, gyro.calibrate);
+    return false;
+}
+
+bool applyTouchpadField(TouchpadMapping& touchpad, const std::string& path, const MappingValue& value) {
+    if (path == "enabled") return readBool(value, touchpad.enabled);
+    if (path == "sensitivity") return readFloat(value, touchpad.sensitivity);
+    if (path == "acceleration") return readFloat(value, touchpad.acceleration);
+    if (path == "scroll_sensitivity") return readFloat(value, touchpad.scroll_sensitivity);
+    if (path == "tap_to_click") return readBool(value, touchpad.tap_to_click);
+    if (path == "tap_time") return readInt(value, touchpad.tap_time);
+    if (path == "tap_distance") return readFloat(value, touchpad.tap_distance);
+    return false;
+}
+
+bool applyTriggerField(TriggerMapping& trigger, const std::string& path, const MappingValue& value) {
+    if (path == "enabled") return readBool(value, trigger.enabled);
+    if (path == "action_type") {
+        std::string name;
+        if (!readString(value, name)) return false;
+        trigger.action_type = parseTriggerActionType(name);
+        return true;
+    }
+    if (path == "threshold") return readInt(value, trigger.threshold);
+    if (path == "release_threshold") return readInt(value, trigger.release_threshold);
+    if (path == "full_pull_threshold") return readInt(value, trigger.full_pull_threshold);
+    if (path == "brake_strength") return readFloat(value, trigger.brake_strength);
+    if (path == "scroll_direction") return readString(value, trigger.scroll_direction);
+    if (path == "trigger_scroll_action.vertical_sensitivity") return readFloat(value, trigger.trigger_scroll_action.vertical_sensitivity);
+    if (path == "trigger_scroll_action.vertical_max_speed") return readInt(value, trigger.trigger_scroll_action.vertical_max_speed);
+    if (path.compare(0, 14, "button_action.") == 0) return applyButtonField(trigger.button_action, path.substr(14), value);
+    if (path.compare(0, 17, "full_pull_action.") == 0) return applyButtonField(trigger.full_pull_action, path.substr(17), value);
+    return false;
+}
+
+// Widens a float to the shortest double that reads back as the same float,
+// so 0.15f is written as 0.15 rather than 0.15000000596046448.
+double floatField(float value) {
+    char buffer[32];
+    for (int precision = 6; precision < 9; ++precision) {
+        std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+        double shortest = std::strtod(buffer, nullptr);
+        if (static_cast<float>(shortest) == value) {
+            return shortest;
+        }
+    }
+    return static_cast<double>(value);
+}
+
+void flattenAcceleration(const std::string& prefix, const AccelerationCurve& curve, MappingFields& fields) {
+    fields[prefix + "curve"] = std::string(accelerationCurveTypeName(curve.type));
+    fields[prefix + "exponent"] = floatField(curve.exponent);
+    if (!curve.points.empty()) {
+        fields[prefix + "points"] = formatAccelerationPoints(curve.points);
+    }
+    fields[prefix + "control1_x"] = floatField(curve.control1_x);
+    fields[prefix + "control1_y"] = floatField(curve.control1_y);
+    fields[prefix + "control2_x"] = floatField(curve.control2_x);
+    fields[prefix + "control2_y"] = floatField(curve.control2_y);
+    fields[prefix + "ramp_time"] = floatField(curve.ramp_time);
+    fields[prefix + "ramp_gain"] = floatField(curve.ramp_gain);
+}
+
+void flattenStick(const std::string& prefix, const StickMapping& stick, MappingFields& fields) {
+    fields[prefix + "enabled"] = stick.enabled;
+    fields[prefix + "action_type"] = std::string(stickActionTypeName(stick.action_type));
+    fields[prefix + "deadzone"] = stick.deadzone;
+    fields[prefix + "calibrate"] = stick.calibrate;
+    fields[prefix + "response_exponent"] = floatField(stick.response_exponent);
+    fields[prefix + "cursor_action.sensitivity"] = floatField(stick.cursor_action.sensitivity);
+    fields[prefix + "cursor_action.boosted_sensitivity"] = floatField(stick.cursor_action.boosted_sensitivity);
+    fields[prefix + "cursor_action.smoothing"] = floatField(stick.cursor_action.smoothing);
+    flattenAcceleration(prefix + "cursor_action.acceleration.", stick.cursor_action.acceleration, fields);
+    fields[prefix + "scroll_action.vertical_sensitivity"] = floatField(stick.scroll_action.vertical_sensitivity);
+    fields[prefix + "scroll_action.horizontal_sensitivity"] = floatField(stick.scroll_action.horizontal_sensitivity);
+    fields[prefix + "scroll_action.vertical_max_speed"] = stick.scroll_action.vertical_max_speed;
+    fields[prefix + "scroll_action.horizontal_max_speed"] = stick.scroll_action.horizontal_max_speed;
+}
+
+void flattenButton(const std::string& prefix, const ButtonMapping& button, MappingFields& fields) {
+    fields[prefix + "enabled"] = button.enabled;
+    fields[prefix + "actions"] = button.actions;
+}
+
+void flattenTrigger(const std::string& prefix, const TriggerMapping& trigger, MappingFields& fields) {
+    fields[prefix + "enabled"] = trigger.enabled;
+    fields[prefix + "action_type"] = std::string(triggerActionTypeName(trigger.action_type));
+    fields[prefix + "threshold"] = trigger.threshold;
+    fields[prefix + "release_threshold"] = trigger.release_threshold;
+    fields[prefix + "full_pull_threshold"] = trigger.full_pull_threshold;
+    fields[prefix + "brake_strength"] = floatField(trigger.brake_strength);
+    if (!trigger.scroll_direction.empty()) {
+        fields[prefix + "scroll_direction"] = trigger.scroll_direction;
+    }
+    fields[prefix + "trigger_scroll_action.vertical_sensitivity"] = floatField(trigger.trigger_scroll_action.vertical_sensitivity);
+    fields[prefix + "trigger_scroll_action.vertical_max_speed"] = trigger.trigger_scroll_action.vertical_max_speed;
+    flattenButton(prefix + "button_action.", trigger.button_action, fields);
+    flattenButton(prefix + "full_pull_action.", trigger.full_pull_action, fields);
+}
+
+void flattenGamepadOutput(const std::string& prefix, const GamepadOutputMapping& output, MappingFields& fields) {
+    fields[prefix + "enabled"] = output.enabled;
+    for (const auto& [source, target] : output.buttons) {
+        fields[prefix + "buttons." + source] = target;
+    }
+}
+
+void flattenGyro(const std::string& prefix, const GyroMapping& gyro, MappingFields& fields) {
+    fields[prefix + "enabled"] = gyro.enabled;
+    fields[prefix + "sensitivity"] = floatField(gyro.sensitivity);
+    fields[prefix + "deadzone"] = floatField(gyro.deadzone);
+    fields[prefix + "tightening"] = floatField(gyro.tightening);
+    fields[prefix + "calibrate"] = gyro.calibrate;
+}
+
+void flattenTouchpad(const std::string& prefix, const TouchpadMapping& touchpad, MappingFields& fields) {
+    fields[prefix + "enabled"] = touchpad.enabled;
+    fields[prefix + "sensitivity"] = floatField(touchpad.sensitivity);
+    fields[prefix + "acceleration"] = floatField(touchpad.acceleration);
+    fields[prefix + "scroll_sensitivity"] = floatField(touchpad.scroll_sensitivity);
+    fields[prefix + "tap_to_click"] = touchpad.tap_to_click;
+    fields[prefix + "tap_time"] = touchpad.tap_time;
+    fields[prefix + "tap_distance"] = floatField(touchpad.tap_distance);
+}
+
+} // namespace
+
+bool applyMappingField(MappingProfile& profile, const std::string& path, const MappingValue& value) {
+    std::string head, rest;
+    splitPath(path, head, rest);
+    if (head == "name" && rest.empty()) return readString(value, profile.name);
+    if (head == "left_stick") return applyStickField(profile.left_stick, rest, value);
+    if (head == "right_stick") return applyStickField(profile.right_stick, rest, value);
+    if (head == "gamepad_output") return applyGamepadOutputField(profile.gamepad_output, rest, value);
+    if (head == "gyro") return applyGyroField(profile.gyro, rest, value);
+    if (head == "touchpad") return applyTouchpadField(profile.touchpad, rest, value);
+
+    // Button and trigger names are the second path segment
+    std::string name, field;
+    splitPath(rest, name, field);
+    if (name.empty() || field.empty()) return false;
+    if (head == "buttons") {
+        ButtonMapping button = profile.buttons.count(name) ? profile.buttons[name] : ButtonMapping();
+        if (!applyButtonField(button, field, value)) return false;
+        profile.buttons[name] = std::move(button);
+        return true;
+    }
+    if (head == "triggers") {
+        TriggerMapping trigger = profile.triggers.count(name) ? profile.triggers[name] : TriggerMapping();
+        if (!applyTriggerField(trigger, field, value)) return false;
+        profile.triggers[name] = std::move(trigger);
+        return true;
+    }
+    return false;
+}
+
+bool applyActionField(ButtonAction& action, const std::string& field, const MappingValue& value) {
+    if (field == "enabled") return readBool(value, action.enabled);
+    if (field == "action_type") {
+        std::string name;
+        if (!readString(value, name)) return false;
+        parseButtonActionName(name, action);
+        return true;
+    }
+    if (field == "repeat_on_hold") return readBool(value, action.repeat_on_hold);
+    if (field == "repeat_delay") return readInt(value, action.repeat_delay);
+    if (field == "repeat_interval") return readInt(value, action.repeat_interval);
+    return false;
+}
+
+MappingFields flattenMappingProfile(const MappingProfile& profile) {
+    MappingFields fields;
+    if (!profile.name.empty()) {
+        fields["name"] = profile.name;
+    }
+    flattenStick("left_stick.", profile.left_stick, fields);
+    flattenStick("right_stick.", profile.right_stick, fields);
+    for (const auto& [name, button] : profile.buttons) {
+        flattenButton("buttons." + name + ".", button, fields);
+    }
+    for (const auto& [name, trigger] : profile.triggers) {
+        flattenTrigger("triggers." + name + ".", trigger, fields);
+    }
+    flattenGamepadOutput("gamepad_output.", profile.gamepad_output, fields);
+    flattenGyro("gyro.", profile.gyro, fields);
+    flattenTouchpad("touchpad.", profile.touchpad, fields);
+    return fields;
+}
+
+std::string buttonActionName(const ButtonAction& action) {
+    const ActionInfo* info = findAction(action);
+    return info ? std::string(info->name) : std::string("none");
+}
+
+void parseButtonActionName(const std::string& name, ButtonAction& action) {
+    const ActionInfo* info = findAction(std::string_view(name));
+    action.click_type = info ? info->click_type : MouseClickType::NONE;
+    action.key_type = info ? info->key_type : KeyboardKeyType::NONE;
+}
+
+const char* stickActionTypeName(StickActionType type) {
+    switch (type) {
+        case StickActionType::CURSOR: return "cursor";
+        case StickActionType::SCROLL: return "scroll";
+        default: return "none";
+    }
+}
+
+StickActionType parseStickActionType(const std::string& name) {
+    if (name == "scroll") return StickActionType::SCROLL;
+    if (name == "cursor") return StickActionType::CURSOR;
+    return StickActionType::NONE;
+}
+
+const char* triggerActionTypeName(TriggerActionType type) {
+    switch (type) {
+        case TriggerActionType::BUTTON: return "button";
+        case TriggerActionType::SCROLL: return "scroll";
+        case TriggerActionType::BRAKE: return "brake";
+        default: return "none";
+    }
+}
+
+TriggerActionType parseTriggerActionType(const std::string& name) {
+    if (name == "button") return TriggerActionType::BUTTON;
+    if (name == "scroll") return TriggerActionType::SCROLL;
+    if (name == "brake") return TriggerActionType::BRAKE;
+    return TriggerActionType::NONE;
+}
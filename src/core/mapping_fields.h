@@ -0,0 +1,54 @@
+// mapping_fields.h
+// Field-level access to typed mapping profiles.
+// Every setting in a profile is addressed by a dotted path relative to the profile,
+// e.g. "left_stick.cursor_action.sensitivity" or "buttons.button_a.actions".
+
+#pragma once
+
+#include "types.h"
+#include <map>
+#include <string>
+#include <variant>
+#include <vector>
+
+// A single setting value. Action lists are treated as one value so a button's
+// actions are always replaced as a whole.
+using MappingValue = std::variant<bool, int, double, std::string, std::vector<ButtonAction>>;
+
+// Flat view of a profile: field path -> value
+using MappingFields = std::map<std::string, MappingValue>;
+
+// A profile as stored in mappings.json: only the fields that differ from its
+// parent. An empty parent means "default" for every profile except "default",
+// which has no parent.
+struct MappingLayer {
+    std::string parent;
+    MappingFields fields;
+    // Values this version does not understand, as JSON text keyed by field
+    // path. They are written back unchanged so other versions keep their settings.
+    std::map<std::string, std::string> unknown_fields;
+};
+
+inline bool operator==(const ButtonAction& a, const ButtonAction& b) {
+    return a.click_type == b.click_type && a.key_type == b.key_type && a.enabled == b.enabled
+        && a.repeat_on_hold == b.repeat_on_hold && a.repeat_delay == b.repeat_delay
+        && a.repeat_interval == b.repeat_interval && a.unknown_fields == b.unknown_fields;
+}
+
+// Stores a value into the profile field named by path.
+// Returns false if the path is unknown or the value has the wrong type.
+bool applyMappingField(MappingProfile& profile, const std::string& path, const MappingValue& value);
+
+// Stores a value into a single button action field (e.g. "action_type", "repeat_delay").
+bool applyActionField(ButtonAction& action, const std::string& field, const MappingValue& value);
+
+// Lists every field of the profile with its current value.
+MappingFields flattenMappingProfile(const MappingProfile& profile);
+
+// Conversions between action types and their names in mappings.json
+std::string buttonActionName(const ButtonAction& action);
+void parseButtonActionName(const std::string& name, ButtonAction& action);
+const char* stickActionTypeName(StickActionType type);
+StickActionType parseStickActionType(const std::string& name);
+const char* triggerActionTypeName(TriggerActionType type);
+TriggerActionType parseTriggerActionType(const std::string& name);
@@ -0,0 +1,513 @@
+// mapping_io.cpp
+// Implementation for the streaming mappings.json reader and writer
+
+#include "mapping_io.h"
+#include "mapping_fields.h"
+#include "mapping_json.h"
+#include <algorithm>
+#include <climits>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace {
+
+// SAX handler that tracks the key path of each value and records it as a
+// field of the profile being read. Only "mappings.<guid>.*" is interpreted;
+// button action arrays are collected into a vector and stored as one value.
+// Other values inside a profile or a button action, and top-level keys other
+// than "mappings", are kept as JSON text so they survive a save.
+class MappingsReader : public nlohmann::json_sax<nlohmann::json> {
+public:
+    MappingsReader(std::map<std::string, MappingLayer>& profiles, MappingDocumentKeys* document_keys)
+        : m_profiles(profiles), m_documentKeys(document_keys) {}
+
+    const std::string& error() const { return m_error; }
+    size_t droppedKeys() const { return m_dropped; }
+
+    bool null() override { return unknownValue(nullptr); }
+    bool boolean(bool val) override { return value(val); }
+    bool number_integer(number_integer_t val) override {
+        if (capturing()) {
+            return capture(val);
+        }
+        if (keepsRawNumber()) {
+            return unknownValue(val);
+        }
+        return value(static_cast<int>(std::clamp<number_integer_t>(val, INT_MIN, INT_MAX)));
+    }
+    bool number_unsigned(number_unsigned_t val) override {
+        if (capturing()) {
+            return capture(val);
+        }
+        if (keepsRawNumber()) {
+            return unknownValue(val);
+        }
+        return value(static_cast<int>(std::min<number_unsigned_t>(val, INT_MAX)));
+    }
+    bool number_float(number_float_t val, const string_t&) override { return value(static_cast<double>(val)); }
+    bool string(string_t& val) override {
+        if (val.size() > kMaxMappingStringLength) {
+            return fail("string value too long");
+        }
+        return value(MappingValue(std::move(val)));
+    }
+    bool binary(binary_t&) override { return true; }
+
+    bool key(string_t& val) override {
+        if (val.size() > kMaxMappingStringLength) {
+            return fail("key too long");
+        }
+        m_key = val;
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        if (capturing()) {
+            startCaptureContainer(nlohmann::json::object());
+        } else if (!skipping()) {
+            if (inActions() && m_frames.size() == m_actionsFrame + 1) {
+                // A new element of the actions array
+                if (m_actions.size() >= kMaxButtonActions) {
+                    return fail("too many actions for one button");
+                }
+                m_actions.emplace_back();
+            } else if (inActionObject()) {
+                beginCapture(CaptureTarget::ACTION, nlohmann::json::object());
+            } else if (inActions()) {
+                ++m_dropped;
+                startSkip();
+            } else if (atDocumentKey()) {
+                beginCapture(CaptureTarget::DOCUMENT, nlohmann::json::object());
+            } else if (m_frames.size() == 2 && m_frames[1].key == "mappings" && !m_frames[1].array) {
+                if (m_profiles.size() >= kMaxMappingProfiles && !m_profiles.count(m_key)) {
+                    return fail("too many profiles");
+                }
+                m_profile = &m_profiles[m_key];
+            }
+        }
+        return push(false);
+    }
+
+    bool end_object() override {
+        if (capturing()) {
+            return endCaptureContainer();
+        }
+        // Keep empty objects inside a profile, which no field path would recreate
+        bool keep_empty = m_profile && !skipping() && !inActions() && m_frames.size() > 3 && m_frames.back().empty;
+        std::string key = m_frames.back().key;
+        pop();
+        if (m_frames.size() == 2) {
+            m_profile = nullptr;
+        }
+        if (keep_empty) {
+            m_key = key;
+            bool stored = keepUnknown(fieldPath(), "{}");
+            m_key.clear();
+            return stored;
+        }
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        if (capturing()) {
+            startCaptureContainer(nlohmann::json::array());
+        } else if (!skipping()) {
+            if (m_profile && !inActions() && m_key == "actions") {
+                m_actionsFrame = m_frames.size();
+                m_actions.clear();
+            } else if (inActionObject()) {
+                beginCapture(CaptureTarget::ACTION, nlohmann::json::array());
+            } else if (m_profile && !inActions()) {
+                beginCapture(CaptureTarget::PROFILE, nlohmann::json::array());
+            } else if (atDocumentKey()) {
+                beginCapture(CaptureTarget::DOCUMENT, nlohmann::json::array());
+            } else {
+                ++m_dropped;
+                startSkip();
+            }
+        }
+        return push(true);
+    }
+
+    bool end_array() override {
+        if (capturing()) {
+            return endCaptureContainer();
+        }
+        bool closes_actions = inActions() && m_frames.size() == m_actionsFrame + 1;
+        std::string key = m_frames.back().key;
+        pop();
+        if (closes_actions) {
+            m_actionsFrame = NO_FRAME;
+            m_key = key;
+            bool stored = applyField(MappingValue(std::move(m_actions)));
+            m_actions.clear();
+            m_key.clear();
+            return stored;
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        m_error = ex.what();
+        return false;
+    }
+
+private:
+    static constexpr size_t NO_FRAME = static_cast<size_t>(-1);
+
+    // Where a captured value is kept once complete
+    enum class CaptureTarget {
+        PROFILE,  // The current profile's unknown_fields
+        ACTION,   // The current button action's unknown_fields
+        DOCUMENT  // The top-level keys
+    };
+
+    struct Frame {
+        std::string key; // Key under which this container appears in its parent
+        bool array;
+        bool empty = true; // No value or container has been read inside it yet
+    };
+
+    bool skipping() const { return m_skipFrom != NO_FRAME; }
+    bool inActions() const { return m_actionsFrame != NO_FRAME; }
+    bool capturing() const { return !m_capture.empty(); }
+    void startSkip() { m_skipFrom = m_frames.size(); }
+    // Directly inside one of the objects of an actions array
+    bool inActionObject() const { return inActions() && m_frames.size() == m_actionsFrame + 2; }
+    // At a top-level key other than "mappings", when those are kept
+    bool atDocumentKey() const { return m_documentKeys && m_frames.size() == 1 && m_key != "mappings"; }
+
+    // Integers that are kept as JSON text are kept exactly rather than clamped
+    // to the range of a profile field
+    bool keepsRawNumber() const {
+        if (skipping()) {
+            return false;
+        }
+        if (inActionObject()) {
+            ButtonAction probe;
+            return !applyActionField(probe, m_key, MappingValue(0));
+        }
+        return atDocumentKey();
+    }
+
+    bool fail(const char* reason) {
+        m_error = reason;
+        return false;
+    }
+
+    bool push(bool array) {
+        if (m_frames.size() >= kMaxMappingDepth) {
+            return fail("nesting too deep");
+        }
+        // Array elements have no key of their own
+        std::string key = (!m_frames.empty() && m_frames.back().array) ? std::string() : m_key;
+        if (!m_frames.empty()) {
+            m_frames.back().empty = false;
+        }
+        m_frames.push_back({key, array});
+        m_key.clear();
+        return true;
+    }
+
+    void pop() {
+        m_frames.pop_back();
+        if (skipping() && m_frames.size() <= m_skipFrom) {
+            m_skipFrom = NO_FRAME;
+        }
+        m_key.clear();
+    }
+
+    // Path of the current key relative to the profile
+    std::string fieldPath() const {
+        std::string path;
+        for (size_t i = 3; i < m_frames.size(); ++i) {
+            path += m_frames[i].key;
+            path += '.';
+        }
+        path += m_key;
+        return path;
+    }
+
+    bool value(MappingValue val) {
+        if (capturing()) {
+            return capture(mappingValueToJson(val));
+        }
+        if (skipping()) {
+            return true;
+        }
+        if (m_frames.empty() || m_frames.back().array) {
+            ++m_dropped;
+            return true;
+        }
+        m_frames.back().empty = false;
+        if (inActionObject()) {
+            // Fields of the action object currently being read
+            if (!applyActionField(m_actions.back(), m_key, val)) {
+                return keepActionUnknown(m_key, mappingValueToJson(val).dump());
+            }
+            return true;
+        }
+        if (atDocumentKey()) {
+            return keepDocumentKey(m_key, mappingValueToJson(val).dump());
+        }
+        return applyField(val);
+    }
+
+    // A value kept as JSON text wherever it appears (null, out of range integers)
+    bool unknownValue(nlohmann::json val) {
+        if (capturing()) {
+            return capture(std::move(val));
+        }
+        if (skipping()) {
+            return true;
+        }
+        if (!m_frames.empty() && !m_frames.back().array) {
+            m_frames.back().empty = false;
+        }
+        if (inActionObject()) {
+            return keepActionUnknown(m_key, val.dump());
+        }
+        if (atDocumentKey()) {
+            return keepDocumentKey(m_key, val.dump());
+        }
+        if (!m_profile || m_frames.back().array || inActions()) {
+            ++m_dropped;
+            return true;
+        }
+        return keepUnknown(fieldPath(), val.dump());
+    }
+
+    // Records a value at the current key path as a field of the current profile.
+    // Returns false if the profile has too many fields.
+    bool applyField(const MappingValue& val) {
+        if (!m_profile || m_frames.size() < 3) {
+            ++m_dropped;
+            return true;
+        }
+        if (m_frames.size() == 3 && m_key == "parent") {
+            if (const std::string* parent = std::get_if<std::string>(&val)) {
+                m_profile->parent = *parent;
+                return true;
+            }
+            return keepUnknown(m_key, mappingValueToJson(val).dump());
+        }
+        std::string path = fieldPath();
+        // Values the profile model does not understand are kept as they are
+        if (!applyMappingField(m_scratch, path, val)) {
+            return keepUnknown(path, mappingValueToJson(val).dump());
+        }
+        if (!hasRoomFor(path)) {
+            return fail("too many fields in one profile");
+        }
+        m_profile->fields[path] = val;
+        return true;
+    }
+
+    bool hasRoomFor(const std::string& path) const {
+        size_t count = m_profile->fields.size() + m_profile->unknown_fields.size();
+        return count < kMaxProfileFields || m_profile->fields.count(path) || m_profile->unknown_fields.count(path);
+    }
+
+    bool keepUnknown(const std::string& path, std::string json_text) {
+        if (!hasRoomFor(path)) {
+            return fail("too many fields in one profile");
+        }
+        m_profile->unknown_fields[path] = std::move(json_text);
+        return true;
+    }
+
+    bool keepActionUnknown(const std::string& key, std::string json_text) {
+        std::map<std::string, std::string>& unknown = m_actions.back().unknown_fields;
+        if (unknown.size() >= kMaxProfileFields && !unknown.count(key)) {
+            return fail("too many fields in one action");
+        }
+        unknown[key] = std::move(json_text);
+        return true;
+    }
+
+    bool keepDocumentKey(const std::string& key, std::string json_text) {
+        if (m_documentKeys->size() >= kMaxProfileFields && !m_documentKeys->count(key)) {
+            return fail("too many top-level keys");
+        }
+        (*m_documentKeys)[key] = std::move(json_text);
+        return true;
+    }
+
+    // Starts keeping the container opening at the current key as one value
+    void beginCapture(CaptureTarget target, nlohmann::json container) {
+        startSkip();
+        m_captureTarget = target;
+        m_capturePath = target == CaptureTarget::PROFILE ? fieldPath() : m_key;
+        m_captureSize = 0;
+        startCaptureContainer(std::move(container));
+    }
+
+    bool keepCaptured(std::string json_text) {
+        switch (m_captureTarget) {
+            case CaptureTarget::ACTION:
+                return keepActionUnknown(m_capturePath, std::move(json_text));
+            case CaptureTarget::DOCUMENT:
+                return keepDocumentKey(m_capturePath, std::move(json_text));
+            case CaptureTarget::PROFILE:
+                break;
+        }
+        return keepUnknown(m_capturePath, std::move(json_text));
+    }
+
+    // Unknown containers are rebuilt as a JSON value up to a size limit;
+    // larger ones are dropped instead of failing the whole file
+    void startCaptureContainer(nlohmann::json container) {
+        if (m_captureSize++ >= kMaxProfileFields) {
+            abandonCapture();
+            return;
+        }
+        m_capture.push_back(std::move(container));
+    }
+
+    bool capture(nlohmann::json val) {
+        if (m_captureSize++ >= kMaxProfileFields) {
+            abandonCapture();
+            return true;
+        }
+        nlohmann::json& parent = m_capture.back();
+        if (parent.is_array()) {
+            parent.push_back(std::move(val));
+        } else {
+            parent[m_key] = std::move(val);
+        }
+        return true;
+    }
+
+    bool endCaptureContainer() {
+        nlohmann::json val = std::move(m_capture.back());
+        m_capture.pop_back();
+        std::string key = m_frames.back().key;
+        pop();
+        if (m_capture.empty()) {
+            return keepCaptured(val.dump());
+        }
+        nlohmann::json& parent = m_capture.back();
+        if (parent.is_array()) {
+            parent.push_back(std::move(val));
+        } else {
+            parent[key] = std::move(val);
+        }
+        return true;
+    }
+
+    // The rest of the value is skipped (m_skipFrom is still set)
+    void abandonCapture() {
+        m_capture.clear();
+        ++m_dropped;
+    }
+
+    std::map<std::string, MappingLayer>& m_profiles;
+    MappingDocumentKeys* m_documentKeys; // Null when top-level keys are not kept
+    MappingLayer* m_profile = nullptr;
+    MappingProfile m_scratch; // Validates field paths and value types
+    std::vector<Frame> m_frames; // [0] root, [1] "mappings", [2] profile, [3+] profile fields
+    std::string m_key;
+    size_t m_skipFrom = NO_FRAME;     // Depth of an ignored container, if inside one
+    size_t m_actionsFrame = NO_FRAME; // Depth of the actions array being collected
+    std::vector<ButtonAction> m_actions;
+    std::vector<nlohmann::json> m_capture; // Open containers of an unknown value being kept
+    CaptureTarget m_captureTarget = CaptureTarget::PROFILE;
+    std::string m_capturePath;
+    size_t m_captureSize = 0;
+    size_t m_dropped = 0; // Values that cannot be kept anywhere
+    std::string m_error;
+};
+
+// Stores a kept unknown value at its path unless a known field already occupies it
+void insertUnknown(nlohmann::json& profile_json, const std::string& path, const std::string& json_text) {
+    nlohmann::json* node = &profile_json;
+    size_t start = 0;
+    size_t dot;
+    while ((dot = path.find('.', start)) != std::string::npos) {
+        nlohmann::json& child = (*node)[path.substr(start, dot - start)];
+        if (!child.is_null() && !child.is_object()) {
+            return;
+        }
+        node = &child;
+        start = dot + 1;
+    }
+    std::string key = path.substr(start);
+    if (!node->contains(key)) {
+        (*node)[key] = nlohmann::json::parse(json_text, nullptr, false);
+    }
+}
+
+// Builds the JSON object for one profile from its fields
+nlohmann::json layerToJson(const MappingLayer& layer) {
+    nlohmann::json profile_json = nlohmann::json::object();
+    if (!layer.parent.empty()) {
+        profile_json["parent"] = layer.parent;
+    }
+    for (const auto& [path, value] : layer.fields) {
+        nlohmann::json* node = &profile_json;
+        size_t start = 0;
+        size_t dot;
+        while ((dot = path.find('.', start)) != std::string::npos) {
+            node = &(*node)[path.substr(start, dot - start)];
+            start = dot + 1;
+        }
+        (*node)[path.substr(start)] = mappingValueToJson(value);
+    }
+    for (const auto& [path, json_text] : layer.unknown_fields) {
+        insertUnknown(profile_json, path, json_text);
+    }
+    return profile_json;
+}
+
+// Pretty-prints a value that is nested at the given indent
+std::string indentJson(const nlohmann::json& value, const char* indent) {
+    std::string body = value.dump(4);
+    std::string indented;
+    indented.reserve(body.size() + body.size() / 4);
+    for (char c : body) {
+        indented += c;
+        if (c == '\n') {
+            indented += indent;
+        }
+    }
+    return indented;
+}
+
+} // namespace
+
+bool readMappingLayers(std::istream& in, std::map<std::string, MappingLayer>& profiles, std::string& error,
+                       size_t* dropped_keys, MappingDocumentKeys* document_keys) {
+    MappingsReader reader(profiles, document_keys);
+    bool ok = nlohmann::json::sax_parse(in, &reader);
+    if (dropped_keys) {
+        *dropped_keys = reader.droppedKeys();
+    }
+    if (!ok) {
+        error = reader.error();
+        return false;
+    }
+    return true;
+}
+
+void writeMappingLayers(std::ostream& out, const std::map<std::string, MappingLayer>& profiles,
+                        const MappingDocumentKeys& document_keys) {
+    // Profiles are serialized one at a time so only a single profile's tree
+    // exists in memory while saving.
+    out << "{\n    \"mappings\": {";
+    bool first = true;
+    for (const auto& [guid, profile] : profiles) {
+        out << (first ? "\n" : ",\n") << "        " << nlohmann::json(guid).dump() << ": "
+            << indentJson(layerToJson(profile), "        ");
+        first = false;
+    }
+    out << (first ? "}" : "\n    }");
+    for (const auto& [key, json_text] : document_keys) {
+        if (key == "mappings") {
+            continue;
+        }
+        out << ",\n    " << nlohmann::json(key).dump() << ": "
+            << indentJson(nlohmann::json::parse(json_text, nullptr, false), "    ");
+    }
+    out << "\n}";
+}
@@ -0,0 +1,40 @@
+// mapping_io.h
+// Streaming reader and writer for mappings.json.
+// The reader walks the file with a SAX parser and stores each value as a
+// profile field, so no JSON document tree is kept after loading.
+
+#pragma once
+
+#include "mapping_fields.h"
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <string>
+
+// Limits that keep a corrupted or hostile file from exhausting memory.
+// Reading fails when any of them is exceeded.
+constexpr size_t kMaxMappingsFileSize = 64 * 1024 * 1024; // Checked by the caller before reading
+constexpr size_t kMaxMappingDepth = 16;
+constexpr size_t kMaxMappingProfiles = 65536;
+constexpr size_t kMaxProfileFields = 1024;
+constexpr size_t kMaxButtonActions = 16;
+constexpr size_t kMaxMappingStringLength = 256;
+
+// Top-level keys of mappings.json other than "mappings", as JSON text keyed by name
+using MappingDocumentKeys = std::map<std::string, std::string>;
+
+// Reads the "mappings" object of a mappings.json stream into profile layers keyed by GUID.
+// Unknown values inside a profile are kept in the layer's unknown_fields, unknown
+// keys of a button action in the action's unknown_fields, and other top-level keys
+// in document_keys. Values that cannot be kept anywhere (non-object elements of an
+// actions array, values directly inside "mappings", top-level keys when
+// document_keys is null) are counted in dropped_keys. Returns false and fills
+// error if the JSON is malformed or exceeds the limits above; profiles may then
+// be partially filled.
+bool readMappingLayers(std::istream& in, std::map<std::string, MappingLayer>& profiles, std::string& error,
+                       size_t* dropped_keys = nullptr, MappingDocumentKeys* document_keys = nullptr);
+
+// Writes profile layers as a mappings.json document, including their unknown
+// fields, followed by the kept top-level keys.
+void writeMappingLayers(std::ostream& out, const std::map<std::string, MappingLayer>& profiles,
+                        const MappingDocumentKeys& document_keys = {});
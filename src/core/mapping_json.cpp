@@ -0,0 +1,90 @@
+// mapping_json.cpp
+// Implementation for JSON conversion of mapping field values
+
+#include "mapping_json.h"
+#include "mapping_io.h"
+#include <algorithm>
+#include <climits>
+#include <type_traits>
+
+nlohmann::json mappingValueToJson(const MappingValue& value) {
+    return std::visit([](const auto& v) -> nlohmann::json {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, std::vector<ButtonAction>>) {
+            nlohmann::json actions_json = nlohmann::json::array();
+            for (const auto& action : v) {
+                nlohmann::json action_json = {
+                    {"enabled", action.enabled},
+                    {"action_type", buttonActionName(action)},
+                    {"repeat_on_hold", action.repeat_on_hold},
+                    {"repeat_delay", action.repeat_delay},
+                    {"repeat_interval", action.repeat_interval}
+                };
+                // A known key is only kept here when its value could not be
+                // read, so the file's value is written back in its place
+                for (const auto& [key, json_text] : action.unknown_fields) {
+                    action_json[key] = nlohmann::json::parse(json_text, nullptr, false);
+                }
+                actions_json.push_back(std::move(action_json));
+            }
+            return actions_json;
+        } else {
+            return v;
+        }
+    }, value);
+}
+
+bool mappingValueFromJson(const nlohmann::json& json, MappingValue& value) {
+    if (json.is_boolean()) {
+        value = json.get<bool>();
+    } else if (json.is_number_unsigned()) {
+        // Out of range integers are clamped, as the file reader does
+        value = static_cast<int>(std::min<uint64_t>(json.get<uint64_t>(), INT_MAX));
+    } else if (json.is_number_integer()) {
+        value = static_cast<int>(std::clamp<int64_t>(json.get<int64_t>(), INT_MIN, INT_MAX));
+    } else if (json.is_number_float()) {
+        value = json.get<double>();
+    } else if (json.is_string()) {
+        const std::string& text = json.get_ref<const std::string&>();
+        if (text.size() > kMaxMappingStringLength) return false;
+        value = text;
+    } else if (json.is_array()) {
+        if (json.size() > kMaxButtonActions) return false;
+        std::vector<ButtonAction> actions;
+        for (const auto& action_json : json) {
+            if (!action_json.is_object()) return false;
+            ButtonAction& action = actions.emplace_back();
+            for (const auto& [key, field_json] : action_json.items()) {
+                MappingValue field;
+                bool applied = mappingValueFromJson(field_json, field) && applyActionField(action, key, field);
+                // Keys of another version are passed through, as the file reader does
+                if (!applied && action.unknown_fields.size() < kMaxProfileFields) {
+                    action.unknown_fields[key] = field_json.dump();
+                }
+            }
+        }
+        value = std::move(actions);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+nlohmann::json mappingFieldsToJson(const MappingFields& fields) {
+    nlohmann::json json = nlohmann::json::object();
+    for (const auto& [path, value] : fields) {
+        json[path] = mappingValueToJson(value);
+    }
+    return json;
+}
+
+bool mappingFieldsFromJson(const nlohmann::json& json, MappingFields& fields) {
+    if (!json.is_object()) return false;
+    for (const auto& [path, value_json] : json.items()) {
+        MappingValue value;
+        if (fields.size() < kMaxProfileFields && mappingValueFromJson(value_json, value)) {
+            fields[path] = std::move(value);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,22 @@
+// mapping_json.h
+// JSON form of mapping field values, shared by the mappings.json writer and
+// the core control socket
+
+#pragma once
+
+#include "mapping_fields.h"
+#include <nlohmann/json.hpp>
+
+// A value as written to mappings.json; action lists become arrays of action objects
+nlohmann::json mappingValueToJson(const MappingValue& value);
+
+// Reads a value written by mappingValueToJson. Returns false for JSON that is
+// not a mapping value (null, nested objects, malformed actions).
+bool mappingValueFromJson(const nlohmann::json& json, MappingValue& value);
+
+// Flat object of field path -> value
+nlohmann::json mappingFieldsToJson(const MappingFields& fields);
+
+// Reads a flat object written by mappingFieldsToJson, skipping entries that are
+// not mapping values. Returns false if json is not an object.
+bool mappingFieldsFromJson(const nlohmann::json& json, MappingFields& fields);
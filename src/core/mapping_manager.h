@@ -4,15 +4,18 @@
 #pragma once
 
 #include "types.h"
-#include <nlohmann/json.hpp>
 #include <string>
 #include <unordered_map>
 
+class Config;
+class OutputSink;
+struct CompiledProfile;
+
 // Represents the mapping settings for the left stick mouse control.
 
 class MappingManager {
 public:
-    MappingManager(nlohmann::json& mappings_json);
+    MappingManager(Config& config);
 
     // Gets the left stick mapping for a given controller GUID.
     StickMapping getLeftStick(const std::string& guid);
@@ -24,33 +27,48 @@ public:
     // Creates a new mapping from default if the GUID is not found.
     ButtonMapping getButtonMapping(const std::string& guid, const std::string& button_name);
 
-    // Executes all enabled actions for a button mapping
-    static void executeButtonActions(const ButtonMapping& mapping);
+    // Queues a press and release of all enabled actions for a button mapping
+    static void executeButtonActions(const ButtonMapping& mapping, OutputSink& output);
 
     // Gets the trigger mapping for a given controller GUID and trigger (e.g., "left_trigger", "right_trigger").
     // Now also parses scroll_direction for scroll actions.
     TriggerMapping getTriggerMapping(const std::string& guid, const std::string& trigger_name);
 
+    // Gets the virtual gamepad output settings for a given controller GUID.
+    GamepadOutputMapping getGamepadOutput(const std::string& guid);
+
+    // Gets the gyro cursor settings for a given controller GUID.
+    GyroMapping getGyro(const std::string& guid);
+
+    // Gets the trackpad settings for a given controller GUID.
+    TouchpadMapping getTouchpad(const std::string& guid);
+
     // --- ADDED: Setters for updating mappings ---
     void setButtonMapping(const std::string& guid, const std::string& button, const ButtonMapping& mapping);
     void setLeftStickMapping(const std::string& guid, const StickMapping& mapping);
     void setRightStickMapping(const std::string& guid, const StickMapping& mapping);
     void setTriggerMapping(const std::string& guid, const std::string& trigger, const TriggerMapping& mapping);
 
-    // Clear cached mappings to force reload from JSON
+    // Clear cached mappings to force them to be re-read from the profiles
     void clearCache();
 
 private:
     void createMappingFromDefault(const std::string& guid);
 
-    // Helper to parse a ButtonAction from JSON
-    static ButtonAction parseButtonAction(const nlohmann::json& action_json);
-    // Helper to parse a ButtonMapping from JSON
-    static ButtonMapping parseButtonMapping(const nlohmann::json& button_config);
+    // Profile for a GUID owned by Config, created from default if missing
+    const MappingProfile& profileFor(const std::string& guid);
+    // Compiled profile for a GUID from the binary cache, or nullptr
+    const CompiledProfile* findCompiledProfile(const std::string& guid) const;
+    // Compiles every profile in the document and rebuilds the binary cache
+    void rebuildProfileCache();
 
-    nlohmann::json& m_mappings_json;
+    Config& m_config;
+    MappingProfile m_empty_profile; // Served when even the default profile is missing
     std::unordered_map<std::string, StickMapping> m_parsed_left_stick_mappings;
     std::unordered_map<std::string, StickMapping> m_parsed_right_stick_mappings;
     std::unordered_map<std::string, std::unordered_map<std::string, ButtonMapping>> m_parsed_button_mappings;
     std::unordered_map<std::string, std::unordered_map<std::string, TriggerMapping>> m_parsed_trigger_mappings;
+    std::unordered_map<std::string, GamepadOutputMapping> m_parsed_gamepad_outputs;
+    std::unordered_map<std::string, GyroMapping> m_parsed_gyros;
+    std::unordered_map<std::string, TouchpadMapping> m_parsed_touchpads;
 }; 
\ No newline at end of file
@@ -0,0 +1,52 @@
+// output_sink.cpp
+// Implementation for the platform-independent output sinks
+
+#include "output_sink.h"
+
+RecordingOutputSink::RecordingOutputSink(std::unique_ptr<OutputSink> next)
+    : m_next(std::move(next)) {}
+
+bool RecordingOutputSink::supportsRelativeMotion() const {
+    return !m_next || m_next->supportsRelativeMotion();
+}
+
+bool RecordingOutputSink::createVirtualGamepad(int id) {
+    return !m_next || m_next->createVirtualGamepad(id);
+}
+
+void RecordingOutputSink::destroyVirtualGamepad(int id) {
+    if (m_next) {
+        m_next->destroyVirtualGamepad(id);
+    }
+}
+
+void RecordingOutputSink::deliver(const std::vector<OutputCommand>& commands) {
+    m_recorded.insert(m_recorded.end(), commands.begin(), commands.end());
+    if (!m_next) {
+        return;
+    }
+    for (const OutputCommand& command : commands) {
+        switch (command.type) {
+            case OutputCommandType::MOUSE_BUTTON_DOWN: m_next->mouseDown(static_cast<MouseClickType>(command.a)); break;
+            case OutputCommandType::MOUSE_BUTTON_UP: m_next->mouseUp(static_cast<MouseClickType>(command.a)); break;
+            case OutputCommandType::MOUSE_MOVE: m_next->mouseMove(command.a, command.b); break;
+            case OutputCommandType::KEYBOARD_DOWN: m_next->keyDown(static_cast<KeyboardKeyType>(command.a)); break;
+            case OutputCommandType::KEYBOARD_UP: m_next->keyUp(static_cast<KeyboardKeyType>(command.a)); break;
+            case OutputCommandType::SCROLL_VERTICAL: m_next->scrollVertical(command.a); break;
+            case OutputCommandType::SCROLL_HORIZONTAL: m_next->scrollHorizontal(command.a); break;
+            case OutputCommandType::GAMEPAD_BUTTON: m_next->gamepadButton(command.device, command.a, command.b != 0); break;
+            case OutputCommandType::GAMEPAD_AXIS: m_next->gamepadAxis(command.device, command.a, command.b); break;
+        }
+    }
+    m_next->commit();
+}
+
+std::unique_ptr<OutputSink> createOutputSink(const std::string& name) {
+    if (name == "null") {
+        return std::make_unique<NullOutputSink>();
+    }
+    if (name == "recording") {
+        return std::make_unique<RecordingOutputSink>(createPlatformOutputSink());
+    }
+    return createPlatformOutputSink();
+}
@@ -0,0 +1,121 @@
+// output_sink.h
+// Destination for the mouse, keyboard and virtual gamepad output produced by the core.
+// Output is batched: the core appends commands during a poll and commits them once,
+// so a backend can deliver a whole frame with a single system call and the
+// virtual dispatch costs one call per frame rather than one per event.
+
+#pragma once
+
+#include "types.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class OutputCommandType : uint8_t {
+    MOUSE_BUTTON_DOWN, // a = MouseClickType
+    MOUSE_BUTTON_UP,   // a = MouseClickType
+    MOUSE_MOVE,        // a = dx, b = dy in pixels
+    KEYBOARD_DOWN,     // a = KeyboardKeyType
+    KEYBOARD_UP,       // a = KeyboardKeyType
+    SCROLL_VERTICAL,   // a = amount in 1/120 notch units, positive scrolls up
+    SCROLL_HORIZONTAL, // a = amount in 1/120 notch units, positive scrolls right
+    GAMEPAD_BUTTON,    // device = virtual gamepad id, a = SDL_GamepadButton, b = pressed
+    GAMEPAD_AXIS       // device = virtual gamepad id, a = SDL_GamepadAxis, b = value
+};
+
+// Device name of the virtual gamepads a platform sink creates
+constexpr const char* kVirtualGamepadName = "JoyCursor Virtual Gamepad";
+
+struct OutputCommand {
+    OutputCommandType type;
+    int device;
+    int a;
+    int b;
+};
+
+class OutputSink {
+public:
+    virtual ~OutputSink() = default;
+
+    // Short name used in settings.json and logs
+    virtual const char* name() const = 0;
+
+    // Whether MOUSE_MOVE is delivered. Without it the core warps the cursor itself.
+    virtual bool supportsRelativeMotion() const { return false; }
+
+    // Virtual gamepads for GAMEPAD_* commands, keyed by an id chosen by the core
+    virtual bool createVirtualGamepad(int /*id*/) { return false; }
+    virtual void destroyVirtualGamepad(int /*id*/) {}
+
+    // Commands appended since the last commit
+    void mouseDown(MouseClickType click) { append(OutputCommandType::MOUSE_BUTTON_DOWN, 0, static_cast<int>(click)); }
+    void mouseUp(MouseClickType click) { append(OutputCommandType::MOUSE_BUTTON_UP, 0, static_cast<int>(click)); }
+    void mouseMove(int dx, int dy) { append(OutputCommandType::MOUSE_MOVE, 0, dx, dy); }
+    void keyDown(KeyboardKeyType key) { append(OutputCommandType::KEYBOARD_DOWN, 0, static_cast<int>(key)); }
+    void keyUp(KeyboardKeyType key) { append(OutputCommandType::KEYBOARD_UP, 0, static_cast<int>(key)); }
+    void scrollVertical(int amount) { append(OutputCommandType::SCROLL_VERTICAL, 0, amount); }
+    void scrollHorizontal(int amount) { append(OutputCommandType::SCROLL_HORIZONTAL, 0, amount); }
+    void gamepadButton(int id, int button, bool pressed) { append(OutputCommandType::GAMEPAD_BUTTON, id, button, pressed ? 1 : 0); }
+    void gamepadAxis(int id, int axis, int value) { append(OutputCommandType::GAMEPAD_AXIS, id, axis, value); }
+
+    bool hasPendingCommands() const { return !m_commands.empty(); }
+    size_t pendingCommandCount() const { return m_commands.size(); }
+
+    // Delivers the pending commands in order and clears them
+    void commit() {
+        if (!m_commands.empty()) {
+            deliver(m_commands);
+            m_commands.clear();
+        }
+    }
+
+protected:
+    virtual void deliver(const std::vector<OutputCommand>& commands) = 0;
+
+private:
+    void append(OutputCommandType type, int device, int a, int b = 0) {
+        m_commands.push_back({type, device, a, b});
+    }
+
+    std::vector<OutputCommand> m_commands;
+};
+
+// Discards all output; for running the core without injecting input.
+class NullOutputSink final : public OutputSink {
+public:
+    const char* name() const override { return "null"; }
+    bool supportsRelativeMotion() const override { return true; }
+    bool createVirtualGamepad(int /*id*/) override { return true; }
+
+protected:
+    void deliver(const std::vector<OutputCommand>&) override {}
+};
+
+// Keeps every committed command, optionally passing them on to another sink.
+class RecordingOutputSink final : public OutputSink {
+public:
+    explicit RecordingOutputSink(std::unique_ptr<OutputSink> next = nullptr);
+
+    const char* name() const override { return "recording"; }
+    bool supportsRelativeMotion() const override;
+    bool createVirtualGamepad(int id) override;
+    void destroyVirtualGamepad(int id) override;
+
+    const std::vector<OutputCommand>& recorded() const { return m_recorded; }
+    void clearRecorded() { m_recorded.clear(); }
+
+protected:
+    void deliver(const std::vector<OutputCommand>& commands) override;
+
+private:
+    std::unique_ptr<OutputSink> m_next;
+    std::vector<OutputCommand> m_recorded;
+};
+
+// The native backend for this platform (SendInput on Windows, uinput on Linux)
+std::unique_ptr<OutputSink> createPlatformOutputSink();
+
+// Creates a sink by name: "platform", "null" or "recording" (records and
+// forwards to the platform sink). Unknown names give the platform sink.
+std::unique_ptr<OutputSink> createOutputSink(const std::string& name);
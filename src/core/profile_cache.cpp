@@ -0,0 +1,517 @@
+// profile_cache.cpp
+// Implementation for the compiled profile cache
+
+#include "profile_cache.h"
+#include "utils/logging.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const char* const kCompiledButtonNames[kCompiledButtonCount] = {
+    "button_a", "button_b", "button_x", "button_y",
+    "left_shoulder", "right_shoulder", "start", "back", "guide",
+    "dpad_up", "dpad_down", "dpad_left", "dpad_right"
+};
+
+int compiledButtonIndex(const std::string& button_name) {
+    for (int i = 0; i < kCompiledButtonCount; ++i) {
+        if (button_name == kCompiledButtonNames[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const char* const kGamepadButtonNames[kGamepadButtonCount] = {
+    "button_a", "button_b", "button_x", "button_y",
+    "back", "guide", "start", "left_stick", "right_stick",
+    "left_shoulder", "right_shoulder",
+    "dpad_up", "dpad_down", "dpad_left", "dpad_right"
+};
+
+int gamepadButtonIndex(const std::string& button_name) {
+    for (int i = 0; i < kGamepadButtonCount; ++i) {
+        if (button_name == kGamepadButtonNames[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+namespace {
+// Bump whenever the layout of any compiled record changes.
+constexpr uint32_t CACHE_VERSION = 8;
+constexpr char CACHE_MAGIC[8] = {'J', 'C', 'P', 'C', 'A', 'C', 'H', 'E'};
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t entry_size;
+    uint32_t entry_count;
+    uint64_t source_size;
+    int64_t source_mtime;
+    uint64_t source_hash;
+    uint64_t payload_checksum;
+};
+
+struct CacheEntry {
+    char guid[kCompiledGuidSize];
+    CompiledProfile profile;
+};
+
+uint64_t fnv1a64(const uint8_t* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+struct SourceStamp {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+};
+
+bool statSource(const std::string& source_path, SourceStamp& stamp) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(source_path, ec);
+    if (ec) return false;
+    auto mtime = std::filesystem::last_write_time(source_path, ec);
+    if (ec) return false;
+    stamp.size = static_cast<uint64_t>(size);
+    stamp.mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+    return true;
+}
+
+bool hashSource(const std::string& source_path, uint64_t& hash) {
+    std::ifstream in(source_path, std::ios::binary);
+    if (!in) return false;
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    hash = fnv1a64(bytes.data(), bytes.size());
+    return true;
+}
+
+void packAction(const ButtonAction& action, CompiledAction& out) {
+    out.click_type = static_cast<uint8_t>(action.click_type);
+    out.key_type = static_cast<uint8_t>(action.key_type);
+    out.enabled = action.enabled ? 1 : 0;
+    out.repeat_on_hold = action.repeat_on_hold ? 1 : 0;
+    out.repeat_delay = action.repeat_delay;
+    out.repeat_interval = action.repeat_interval;
+}
+
+ButtonAction unpackAction(const CompiledAction& compiled) {
+    ButtonAction action;
+    action.click_type = static_cast<MouseClickType>(compiled.click_type);
+    action.key_type = static_cast<KeyboardKeyType>(compiled.key_type);
+    action.enabled = compiled.enabled != 0;
+    action.repeat_on_hold = compiled.repeat_on_hold != 0;
+    action.repeat_delay = compiled.repeat_delay;
+    action.repeat_interval = compiled.repeat_interval;
+    return action;
+}
+}
+
+// --- Packing helpers ---
+
+bool packStick(const StickMapping& mapping, CompiledStick& out) {
+    out = CompiledStick{};
+    out.enabled = mapping.enabled ? 1 : 0;
+    out.action_type = static_cast<uint8_t>(mapping.action_type);
+    out.calibrate = mapping.calibrate ? 1 : 0;
+    out.deadzone = mapping.deadzone;
+    out.cursor_sensitivity = mapping.cursor_action.sensitivity;
+    out.cursor_boosted_sensitivity = mapping.cursor_action.boosted_sensitivity;
+    out.cursor_smoothing = mapping.cursor_action.smoothing;
+    out.scroll_vertical_sensitivity = mapping.scroll_action.vertical_sensitivity;
+    out.scroll_vertical_max_speed = mapping.scroll_action.vertical_max_speed;
+    out.scroll_horizontal_sensitivity = mapping.scroll_action.horizontal_sensitivity;
+    out.scroll_horizontal_max_speed = mapping.scroll_action.horizontal_max_speed;
+    out.response_exponent = mapping.response_exponent;
+    const AccelerationCurve& curve = mapping.cursor_action.acceleration;
+    if (curve.points.size() > static_cast<size_t>(kAccelerationMaxPoints)) {
+        return false;
+    }
+    out.acceleration_curve = static_cast<uint8_t>(curve.type);
+    out.acceleration_point_count = static_cast<uint8_t>(curve.points.size());
+    out.acceleration_exponent = curve.exponent;
+    for (size_t i = 0; i < curve.points.size(); ++i) {
+        out.acceleration_points[i][0] = curve.points[i].input;
+        out.acceleration_points[i][1] = curve.points[i].output;
+    }
+    out.acceleration_controls[0] = curve.control1_x;
+    out.acceleration_controls[1] = curve.control1_y;
+    out.acceleration_controls[2] = curve.control2_x;
+    out.acceleration_controls[3] = curve.control2_y;
+    out.acceleration_ramp_time = curve.ramp_time;
+    out.acceleration_ramp_gain = curve.ramp_gain;
+    return true;
+}
+
+bool packButton(const ButtonMapping& mapping, CompiledButton& out) {
+    out = CompiledButton{};
+    if (mapping.actions.size() > static_cast<size_t>(kCompiledMaxActions)) {
+        return false;
+    }
+    out.enabled = mapping.enabled ? 1 : 0;
+    out.action_count = static_cast<uint8_t>(mapping.actions.size());
+    for (size_t i = 0; i < mapping.actions.size(); ++i) {
+        packAction(mapping.actions[i], out.actions[i]);
+    }
+    return true;
+}
+
+bool packTrigger(const TriggerMapping& mapping, CompiledTrigger& out) {
+    out = CompiledTrigger{};
+    out.enabled = mapping.enabled ? 1 : 0;
+    out.action_type = static_cast<uint8_t>(mapping.action_type);
+    if (mapping.scroll_direction == "up") {
+        out.scroll_direction = 1;
+    } else if (mapping.scroll_direction == "down") {
+        out.scroll_direction = 2;
+    }
+    out.threshold = mapping.threshold;
+    out.release_threshold = mapping.release_threshold;
+    out.full_pull_threshold = mapping.full_pull_threshold;
+    out.brake_strength = mapping.brake_strength;
+    out.scroll_vertical_sensitivity = mapping.trigger_scroll_action.vertical_sensitivity;
+    out.scroll_vertical_max_speed = mapping.trigger_scroll_action.vertical_max_speed;
+    return packButton(mapping.button_action, out.button_action)
+        && packButton(mapping.full_pull_action, out.full_pull_action);
+}
+
+bool packGamepadOutput(const GamepadOutputMapping& mapping, CompiledGamepadOutput& out) {
+    out = CompiledGamepadOutput{};
+    out.enabled = mapping.enabled ? 1 : 0;
+    for (int i = 0; i < kGamepadButtonCount; ++i) {
+        out.buttons[i] = static_cast<uint8_t>(i);
+    }
+    for (const auto& [source, target] : mapping.buttons) {
+        int source_index = gamepadButtonIndex(source);
+        int target_index = gamepadButtonIndex(target);
+        if (source_index < 0 || target_index < 0) {
+            return false;
+        }
+        out.buttons[source_index] = static_cast<uint8_t>(target_index);
+    }
+    return true;
+}
+
+bool packGyro(const GyroMapping& mapping, CompiledGyro& out) {
+    out = CompiledGyro{};
+    out.enabled = mapping.enabled ? 1 : 0;
+    out.calibrate = mapping.calibrate ? 1 : 0;
+    out.sensitivity = mapping.sensitivity;
+    out.deadzone = mapping.deadzone;
+    out.tightening = mapping.tightening;
+    return true;
+}
+
+bool packTouchpad(const TouchpadMapping& mapping, CompiledTouchpad& out) {
+    out = CompiledTouchpad{};
+    out.enabled = mapping.enabled ? 1 : 0;
+    out.tap_to_click = mapping.tap_to_click ? 1 : 0;
+    out.sensitivity = mapping.sensitivity;
+    out.acceleration = mapping.acceleration;
+    out.scroll_sensitivity = mapping.scroll_sensitivity;
+    out.tap_time = mapping.tap_time;
+    out.tap_distance = mapping.tap_distance;
+    return true;
+}
+
+StickMapping unpackStick(const CompiledStick& compiled) {
+    StickMapping mapping;
+    mapping.enabled = compiled.enabled != 0;
+    mapping.action_type = static_cast<StickActionType>(compiled.action_type);
+    mapping.calibrate = compiled.calibrate != 0;
+    mapping.deadzone = compiled.deadzone;
+    mapping.cursor_action.sensitivity = compiled.cursor_sensitivity;
+    mapping.cursor_action.boosted_sensitivity = compiled.cursor_boosted_sensitivity;
+    mapping.cursor_action.smoothing = compiled.cursor_smoothing;
+    mapping.scroll_action.vertical_sensitivity = compiled.scroll_vertical_sensitivity;
+    mapping.scroll_action.vertical_max_speed = compiled.scroll_vertical_max_speed;
+    mapping.scroll_action.horizontal_sensitivity = compiled.scroll_horizontal_sensitivity;
+    mapping.scroll_action.horizontal_max_speed = compiled.scroll_horizontal_max_speed;
+    mapping.response_exponent = compiled.response_exponent;
+    AccelerationCurve& curve = mapping.cursor_action.acceleration;
+    curve.type = static_cast<AccelerationCurveType>(compiled.acceleration_curve);
+    curve.exponent = compiled.acceleration_exponent;
+    int point_count = std::min<int>(compiled.acceleration_point_count, kAccelerationMaxPoints);
+    for (int i = 0; i < point_count; ++i) {
+        curve.points.push_back({compiled.acceleration_points[i][0], compiled.acceleration_points[i][1]});
+    }
+    curve.control1_x = compiled.acceleration_controls[0];
+    curve.control1_y = compiled.acceleration_controls[1];
+    curve.control2_x = compiled.acceleration_controls[2];
+    curve.control2_y = compiled.acceleration_controls[3];
+    curve.ramp_time = compiled.acceleration_ramp_time;
+    curve.ramp_gain = compiled.acceleration_ramp_gain;
+    return mapping;
+}
+
+ButtonMapping unpackButton(const CompiledButton& compiled) {
+    ButtonMapping mapping;
+    mapping.enabled = compiled.enabled != 0;
+    int count = std::min<int>(compiled.action_count, kCompiledMaxActions);
+    mapping.actions.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        mapping.actions.push_back(unpackAction(compiled.actions[i]));
+    }
+    return mapping;
+}
+
+TriggerMapping unpackTrigger(const CompiledTrigger& compiled) {
+    TriggerMapping mapping;
+    mapping.enabled = compiled.enabled != 0;
+    mapping.action_type = static_cast<TriggerActionType>(compiled.action_type);
+    if (compiled.scroll_direction == 1) {
+        mapping.scroll_direction = "up";
+    } else if (compiled.scroll_direction == 2) {
+        mapping.scroll_direction = "down";
+    }
+    mapping.threshold = compiled.threshold;
+    mapping.release_threshold = compiled.release_threshold;
+    mapping.full_pull_threshold = compiled.full_pull_threshold;
+    mapping.brake_strength = compiled.brake_strength;
+    mapping.trigger_scroll_action.vertical_sensitivity = compiled.scroll_vertical_sensitivity;
+    mapping.trigger_scroll_action.vertical_max_speed = compiled.scroll_vertical_max_speed;
+    mapping.button_action = unpackButton(compiled.button_action);
+    mapping.full_pull_action = unpackButton(compiled.full_pull_action);
+    return mapping;
+}
+
+GamepadOutputMapping unpackGamepadOutput(const CompiledGamepadOutput& compiled) {
+    GamepadOutputMapping mapping;
+    mapping.enabled = compiled.enabled != 0;
+    for (int i = 0; i < kGamepadButtonCount; ++i) {
+        if (compiled.buttons[i] != i && compiled.buttons[i] < kGamepadButtonCount) {
+            mapping.buttons[kGamepadButtonNames[i]] = kGamepadButtonNames[compiled.buttons[i]];
+        }
+    }
+    return mapping;
+}
+
+GyroMapping unpackGyro(const CompiledGyro& compiled) {
+    GyroMapping mapping;
+    mapping.enabled = compiled.enabled != 0;
+    mapping.calibrate = compiled.calibrate != 0;
+    mapping.sensitivity = compiled.sensitivity;
+    mapping.deadzone = compiled.deadzone;
+    mapping.tightening = compiled.tightening;
+    return mapping;
+}
+
+TouchpadMapping unpackTouchpad(const CompiledTouchpad& compiled) {
+    TouchpadMapping mapping;
+    mapping.enabled = compiled.enabled != 0;
+    mapping.tap_to_click = compiled.tap_to_click != 0;
+    mapping.sensitivity = compiled.sensitivity;
+    mapping.acceleration = compiled.acceleration;
+    mapping.scroll_sensitivity = compiled.scroll_sensitivity;
+    mapping.tap_time = compiled.tap_time;
+    mapping.tap_distance = compiled.tap_distance;
+    return mapping;
+}
+
+// --- ProfileCache ---
+
+ProfileCache::~ProfileCache() {
+    close();
+}
+
+bool ProfileCache::open(const std::string& cache_path, const std::string& source_path) {
+    close();
+
+    SourceStamp stamp;
+    if (!statSource(source_path, stamp)) {
+        return false;
+    }
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(cache_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < static_cast<LONGLONG>(sizeof(CacheHeader))) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_fileHandle = file;
+    m_mapHandle = mapping;
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(file_size.QuadPart);
+#else
+    int fd = ::open(cache_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(CacheHeader))) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(st.st_size);
+#endif
+
+    CacheHeader header;
+    std::memcpy(&header, m_data, sizeof(header));
+    bool valid = std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0
+        && header.version == CACHE_VERSION
+        && header.header_size == sizeof(CacheHeader)
+        && header.entry_size == sizeof(CacheEntry)
+        && header.entry_count <= (m_size - sizeof(CacheHeader)) / sizeof(CacheEntry)
+        && m_size == sizeof(CacheHeader) + static_cast<size_t>(header.entry_count) * sizeof(CacheEntry);
+    if (!valid) {
+        logInfo("Profile cache has an unexpected format, ignoring it.");
+        close();
+        return false;
+    }
+
+    // The cache is current if the source is untouched, or if it was only
+    // re-saved with identical contents.
+    if (header.source_size != stamp.size) {
+        close();
+        return false;
+    }
+    if (header.source_mtime != stamp.mtime) {
+        uint64_t hash = 0;
+        if (!hashSource(source_path, hash) || hash != header.source_hash) {
+            close();
+            return false;
+        }
+    }
+
+    const uint8_t* payload = m_data + sizeof(CacheHeader);
+    if (fnv1a64(payload, m_size - sizeof(CacheHeader)) != header.payload_checksum) {
+        logError("Profile cache checksum mismatch, falling back to mappings.json.");
+        close();
+        return false;
+    }
+
+    m_entryCount = header.entry_count;
+    return true;
+}
+
+void ProfileCache::close() {
+#ifdef _WIN32
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapHandle) {
+        CloseHandle(static_cast<HANDLE>(m_mapHandle));
+    }
+    if (m_fileHandle) {
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    }
+#else
+    if (m_data) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_entryCount = 0;
+    m_fileHandle = nullptr;
+    m_mapHandle = nullptr;
+}
+
+const CompiledProfile* ProfileCache::find(const std::string& guid) const {
+    if (!m_data || guid.size() >= static_cast<size_t>(kCompiledGuidSize)) {
+        return nullptr;
+    }
+    const CacheEntry* entries = reinterpret_cast<const CacheEntry*>(m_data + sizeof(CacheHeader));
+    const CacheEntry* end = entries + m_entryCount;
+    const CacheEntry* it = std::lower_bound(entries, end, guid, [](const CacheEntry& entry, const std::string& key) {
+        return std::strncmp(entry.guid, key.c_str(), kCompiledGuidSize) < 0;
+    });
+    if (it != end && std::strncmp(it->guid, guid.c_str(), kCompiledGuidSize) == 0) {
+        return &it->profile;
+    }
+    return nullptr;
+}
+
+bool ProfileCache::write(const std::string& cache_path, const std::string& source_path,
+                         std::vector<std::pair<std::string, CompiledProfile>> profiles) {
+    SourceStamp stamp;
+    uint64_t source_hash = 0;
+    if (!statSource(source_path, stamp) || !hashSource(source_path, source_hash)) {
+        return false;
+    }
+
+    std::sort(profiles.begin(), profiles.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<CacheEntry> entries;
+    entries.reserve(profiles.size());
+    for (const auto& [guid, profile] : profiles) {
+        if (guid.size() >= static_cast<size_t>(kCompiledGuidSize)) {
+            continue;
+        }
+        CacheEntry entry{};
+        std::memcpy(entry.guid, guid.c_str(), guid.size());
+        entry.profile = profile;
+        entries.push_back(entry);
+    }
+
+    CacheHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.header_size = sizeof(CacheHeader);
+    header.entry_size = sizeof(CacheEntry);
+    header.entry_count = static_cast<uint32_t>(entries.size());
+    header.source_size = stamp.size;
+    header.source_mtime = stamp.mtime;
+    header.source_hash = source_hash;
+    header.payload_checksum = fnv1a64(reinterpret_cast<const uint8_t*>(entries.data()), entries.size() * sizeof(CacheEntry));
+
+    // Write to a temporary file and swap it in so readers never see a partial cache.
+    std::string tmp_path = cache_path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(CacheEntry)));
+        if (!out) {
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, cache_path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,171 @@
+// profile_cache.h
+// Versioned binary cache of compiled mapping profiles.
+// The cache is rebuilt whenever mappings.json changes and is memory-mapped
+// read-only at startup so known controllers can be served without parsing JSON.
+
+#pragma once
+
+#include "types.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Buttons stored in a compiled profile, in slot order.
+constexpr int kCompiledButtonCount = 13;
+extern const char* const kCompiledButtonNames[kCompiledButtonCount];
+
+// Returns the compiled slot for a button name, or -1 if the button is not cached.
+int compiledButtonIndex(const std::string& button_name);
+
+// Buttons of a virtual gamepad, in SDL_GamepadButton order (index == SDL value).
+constexpr int kGamepadButtonCount = 15;
+extern const char* const kGamepadButtonNames[kGamepadButtonCount];
+
+// Returns the virtual gamepad button index for a name, or -1 if unknown.
+int gamepadButtonIndex(const std::string& button_name);
+
+// Maximum number of actions per button that fit in a compiled record.
+// Profiles with more actions are left out of the cache and served from JSON.
+constexpr int kCompiledMaxActions = 4;
+
+// Maximum GUID string length (including terminator) stored in the cache.
+constexpr int kCompiledGuidSize = 64;
+
+// --- Fixed-layout, pointer-free records stored in the cache file ---
+
+struct CompiledAction {
+    uint8_t click_type;
+    uint8_t key_type;
+    uint8_t enabled;
+    uint8_t repeat_on_hold;
+    int32_t repeat_delay;
+    int32_t repeat_interval;
+};
+
+struct CompiledButton {
+    uint8_t enabled;
+    uint8_t action_count;
+    uint8_t reserved[2];
+    CompiledAction actions[kCompiledMaxActions];
+};
+
+struct CompiledStick {
+    uint8_t enabled;
+    uint8_t action_type;
+    uint8_t calibrate;
+    uint8_t reserved;
+    int32_t deadzone;
+    float cursor_sensitivity;
+    float cursor_boosted_sensitivity;
+    float cursor_smoothing;
+    float scroll_vertical_sensitivity;
+    int32_t scroll_vertical_max_speed;
+    float scroll_horizontal_sensitivity;
+    int32_t scroll_horizontal_max_speed;
+    float response_exponent;
+    uint8_t acceleration_curve;
+    uint8_t acceleration_point_count;
+    uint8_t reserved2[2];
+    float acceleration_exponent;
+    float acceleration_points[kAccelerationMaxPoints][2]; // input, output
+    float acceleration_controls[4];                       // control1_x, control1_y, control2_x, control2_y
+    float acceleration_ramp_time;
+    float acceleration_ramp_gain;
+};
+
+struct CompiledTrigger {
+    uint8_t enabled;
+    uint8_t action_type;
+    uint8_t scroll_direction; // 0 = unset, 1 = up, 2 = down
+    uint8_t reserved;
+    int32_t threshold;
+    int32_t release_threshold;
+    int32_t full_pull_threshold;
+    float brake_strength;
+    float scroll_vertical_sensitivity;
+    int32_t scroll_vertical_max_speed;
+    CompiledButton button_action;
+    CompiledButton full_pull_action;
+};
+
+struct CompiledGamepadOutput {
+    uint8_t enabled;
+    uint8_t buttons[kGamepadButtonCount]; // Virtual button index for each source button
+};
+
+struct CompiledGyro {
+    uint8_t enabled;
+    uint8_t calibrate;
+    uint8_t reserved[2];
+    float sensitivity;
+    float deadzone;
+    float tightening;
+};
+
+struct CompiledTouchpad {
+    uint8_t enabled;
+    uint8_t tap_to_click;
+    uint8_t reserved[2];
+    float sensitivity;
+    float acceleration;
+    float scroll_sensitivity;
+    int32_t tap_time;
+    float tap_distance;
+};
+
+struct CompiledProfile {
+    CompiledStick left_stick;
+    CompiledStick right_stick;
+    CompiledButton buttons[kCompiledButtonCount];
+    CompiledTrigger triggers[2]; // left_trigger, right_trigger
+    CompiledGamepadOutput gamepad_output;
+    CompiledGyro gyro;
+    CompiledTouchpad touchpad;
+};
+
+// Packing helpers between the runtime mapping types and compiled records.
+// The pack functions return false if the mapping does not fit a record.
+bool packStick(const StickMapping& mapping, CompiledStick& out);
+bool packButton(const ButtonMapping& mapping, CompiledButton& out);
+bool packTrigger(const TriggerMapping& mapping, CompiledTrigger& out);
+bool packGamepadOutput(const GamepadOutputMapping& mapping, CompiledGamepadOutput& out);
+bool packGyro(const GyroMapping& mapping, CompiledGyro& out);
+bool packTouchpad(const TouchpadMapping& mapping, CompiledTouchpad& out);
+StickMapping unpackStick(const CompiledStick& compiled);
+ButtonMapping unpackButton(const CompiledButton& compiled);
+TriggerMapping unpackTrigger(const CompiledTrigger& compiled);
+GamepadOutputMapping unpackGamepadOutput(const CompiledGamepadOutput& compiled);
+GyroMapping unpackGyro(const CompiledGyro& compiled);
+TouchpadMapping unpackTouchpad(const CompiledTouchpad& compiled);
+
+class ProfileCache {
+public:
+    ProfileCache() = default;
+    ~ProfileCache();
+    ProfileCache(const ProfileCache&) = delete;
+    ProfileCache& operator=(const ProfileCache&) = delete;
+
+    // Maps the cache file read-only if it was built from the current contents of
+    // source_path and its checksum verifies. Returns false if the cache is missing,
+    // stale or corrupt; callers then fall back to parsing JSON.
+    bool open(const std::string& cache_path, const std::string& source_path);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    // Looks up a compiled profile by controller GUID (binary search, no allocation).
+    const CompiledProfile* find(const std::string& guid) const;
+    size_t size() const { return m_entryCount; }
+
+    // Writes a new cache for source_path. Entries need not be sorted.
+    static bool write(const std::string& cache_path, const std::string& source_path,
+                      std::vector<std::pair<std::string, CompiledProfile>> profiles);
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_entryCount = 0;
+    void* m_fileHandle = nullptr;
+    void* m_mapHandle = nullptr;
+};
@@ -0,0 +1,60 @@
+// seqlock.h
+// Lock-free publication of a small value from one writer thread to any number
+// of readers
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Single-writer sequence lock around a trivially copyable value. The writer
+// never waits; a reader that overlaps a write retries, and gives up after a
+// few attempts so it never spins on a busy slot. The value is kept in atomic
+// words so concurrent reads and writes are well defined.
+template <typename T>
+class SeqlockSlot {
+    static_assert(std::is_trivially_copyable_v<T>, "seqlock values are copied bytewise");
+
+public:
+    // Writer thread only
+    void store(const T& value) {
+        uint32_t seq = m_seq.load(std::memory_order_relaxed);
+        m_seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (int i = 0; i < kWords; ++i) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+        m_seq.store(seq + 2, std::memory_order_release);
+    }
+
+    // Any thread. Returns false if no consistent copy could be taken.
+    bool load(T& value) const {
+        for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+            uint32_t before = m_seq.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;
+            }
+            uint64_t words[kWords];
+            for (int i = 0; i < kWords; ++i) {
+                words[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_seq.load(std::memory_order_relaxed) == before) {
+                std::memcpy(&value, words, sizeof(T));
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static constexpr int kWords = static_cast<int>((sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    static constexpr int kMaxReadAttempts = 4;
+
+    std::atomic<uint32_t> m_seq{0}; // Odd while a write is in progress
+    std::atomic<uint64_t> m_words[kWords] = {};
+};
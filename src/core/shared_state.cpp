@@ -0,0 +1,106 @@
+// shared_state.cpp
+// Implementation for the shared state page and endpoint names
+
+#include "shared_state.h"
+#include "utils/logging.h"
+#include <cstdlib>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+std::string coreSocketPath() {
+    // XDG_RUNTIME_DIR is private to the user; fall back to a per-user name in /tmp
+    const char* runtime_dir = std::getenv("XDG_RUNTIME_DIR");
+    if (runtime_dir && runtime_dir[0] != '\0') {
+        return std::string(runtime_dir) + "/joycursor.sock";
+    }
+    return "/tmp/joycursor-" + std::to_string(getuid()) + ".sock";
+}
+
+std::string sharedStateName() {
+    return "/joycursor-" + std::to_string(getuid()) + "-state";
+}
+
+std::unique_ptr<SharedStateMapping> SharedStateMapping::map(bool writable) {
+    std::string name = sharedStateName();
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0600);
+    if (fd < 0) {
+        logError(("Failed to open shared state " + name).c_str());
+        return nullptr;
+    }
+    // A new object is empty; whichever side opens it first gives it its size
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (static_cast<size_t>(info.st_size) < sizeof(SharedCoreState)
+                                  && ftruncate(fd, sizeof(SharedCoreState)) != 0)) {
+        logError(("Failed to size shared state " + name).c_str());
+        close(fd);
+        return nullptr;
+    }
+    void* data = mmap(nullptr, sizeof(SharedCoreState), writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                      MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        logError(("Failed to map shared state " + name).c_str());
+        return nullptr;
+    }
+    return std::unique_ptr<SharedStateMapping>(new SharedStateMapping(static_cast<SharedCoreState*>(data)));
+}
+
+std::unique_ptr<SharedStateMapping> SharedStateMapping::create() {
+    auto mapping = map(true);
+    if (mapping) {
+        // Readers see the page as incompatible while it is reset
+        SharedCoreState* state = mapping->m_state;
+        state->magic.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        new (&state->input) InputSnapshotTable();
+        new (&state->stats) SeqlockSlot<LiveStats>();
+        state->version = kSharedStateVersion;
+        state->size = sizeof(SharedCoreState);
+        state->magic.store(kSharedStateMagic, std::memory_order_release);
+    }
+    return mapping;
+}
+
+std::unique_ptr<SharedStateMapping> SharedStateMapping::open() {
+    return map(false);
+}
+
+SharedStateMapping::~SharedStateMapping() {
+    munmap(m_state, sizeof(SharedCoreState));
+}
+#else
+// The headless core is not supported on Windows yet; the UI runs the core in-process there
+std::string coreSocketPath() {
+    return "";
+}
+
+std::string sharedStateName() {
+    return "";
+}
+
+std::unique_ptr<SharedStateMapping> SharedStateMapping::map(bool) {
+    return nullptr;
+}
+
+std::unique_ptr<SharedStateMapping> SharedStateMapping::create() {
+    return nullptr;
+}
+
+std::unique_ptr<SharedStateMapping> SharedStateMapping::open() {
+    return nullptr;
+}
+
+SharedStateMapping::~SharedStateMapping() {}
+#endif
+
+bool SharedStateMapping::isCompatible() const {
+    return m_state->magic.load(std::memory_order_acquire) == kSharedStateMagic
+        && m_state->version == kSharedStateVersion && m_state->size == sizeof(SharedCoreState);
+}
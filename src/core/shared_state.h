@@ -0,0 +1,62 @@
+// shared_state.h
+// Shared-memory page through which a headless core publishes live input and
+// stats to UI processes, and the per-user names of the core's endpoints
+
+#pragma once
+
+#include "core_stats.h"
+#include "input_snapshot.h"
+#include "seqlock.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+constexpr uint32_t kSharedStateMagic = 0x4a435331;  // "JCS1"
+constexpr uint32_t kSharedStateVersion = 2;         // Bumped whenever the layout below changes
+
+// Seqlock slots work unchanged across processes: their atomics are lock-free
+// and so do not depend on the address they are mapped at
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+              "shared state needs lock-free atomics");
+
+// Written only by the core's polling thread. Readers check magic, version and
+// size before trusting the slots.
+struct SharedCoreState {
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    uint32_t size;
+    InputSnapshotTable input;
+    SeqlockSlot<LiveStats> stats;
+};
+
+// Path of the core's control socket and name of the shared-memory object
+std::string coreSocketPath();
+std::string sharedStateName();
+
+// A mapping of the shared state page. The object outlives the core that
+// created it, so a UI mapping stays valid while the core restarts; a
+// restarted core resets the page before publishing again.
+class SharedStateMapping {
+public:
+    // Maps the page writable and resets it. Used by the core; null on failure.
+    static std::unique_ptr<SharedStateMapping> create();
+    // Maps the page read-only, creating an empty one if no core has run yet.
+    // Used by UIs; null on failure or where shared state is not supported.
+    static std::unique_ptr<SharedStateMapping> open();
+
+    ~SharedStateMapping();
+    SharedStateMapping(const SharedStateMapping&) = delete;
+    SharedStateMapping& operator=(const SharedStateMapping&) = delete;
+
+    SharedCoreState* state() const { return m_state; }
+    // True once a core with this layout has initialized the page
+    bool isCompatible() const;
+
+private:
+    explicit SharedStateMapping(SharedCoreState* state) : m_state(state) {}
+    static std::unique_ptr<SharedStateMapping> map(bool writable);
+
+    SharedCoreState* m_state;
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <map>
 #include <vector>
 #include <string>
 
@@ -10,11 +12,45 @@ enum class StickActionType {
     SCROLL      // Scroll mouse wheel
 };
 
+// Shape of the curve from stick deflection (0..1) to cursor speed (0..1 of full speed)
+enum class AccelerationCurveType {
+    LINEAR,  // Speed proportional to deflection
+    POWER,   // deflection ^ exponent
+    POINTS,  // Piecewise-linear through the given points
+    BEZIER   // Cubic Bezier from (0,0) to (1,1), like CSS cubic-bezier()
+};
+
+// Maximum number of points in a piecewise-linear acceleration curve
+constexpr int kAccelerationMaxPoints = 8;
+
+struct AccelerationPoint {
+    float input;
+    float output;
+};
+
+// Pointer acceleration for a stick. Compiled to a lookup table when the mapping
+// is loaded (see acceleration_curve.h).
+struct AccelerationCurve {
+    AccelerationCurveType type = AccelerationCurveType::LINEAR;
+    float exponent = 2.0f;                 // POWER
+    std::vector<AccelerationPoint> points; // POINTS, sorted by input
+    float control1_x = 0.42f;              // BEZIER control points
+    float control1_y = 0.0f;
+    float control2_x = 0.58f;
+    float control2_y = 1.0f;
+
+    // Time ramp: holding the stick at full tilt raises the speed up to
+    // ramp_gain times over ramp_time seconds. 0 disables the ramp.
+    float ramp_time = 0.0f;
+    float ramp_gain = 2.0f;
+};
+
 // Represents cursor movement action settings
 struct CursorAction {
     float sensitivity = 0.05f;
     float boosted_sensitivity = 0.3f; // Used when L3/R3 is held
     float smoothing = 0.2f;
+    AccelerationCurve acceleration;
 };
 
 // Represents scroll action settings
@@ -33,6 +69,8 @@ struct StickMapping {
     bool enabled = false;
     StickActionType action_type = StickActionType::NONE; // No action assigned by default
     int deadzone = 8000;
+    bool calibrate = true; // Learn the stick's rest position and noise, and measure the deadzone from them
+    float response_exponent = 1.0f; // Response curve for virtual gamepad output (1 = linear)
     
     // Action-specific settings - only the one matching action_type is used
     CursorAction cursor_action;
@@ -44,10 +82,14 @@ enum class MouseClickType {
     LEFT_CLICK,
     RIGHT_CLICK,
     MIDDLE_CLICK,
-    NONE
+    NONE,
+    // Side buttons (X1/X2), appended so existing values stay stable
+    BACK_CLICK,
+    FORWARD_CLICK
 };
 
-// Enum for keyboard key types (Windows Virtual Key codes)
+// Enum for keyboard key types. Names and platform key codes live in action_registry.h.
+// New keys are appended so values stored in the profile cache stay stable.
 enum class KeyboardKeyType {
     NONE,
     // Arrow keys
@@ -65,7 +107,26 @@ enum class KeyboardKeyType {
     CTRL,
     SHIFT,
     // Function keys
-    F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11, F12
+    F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11, F12,
+    F13, F14, F15, F16, F17, F18, F19, F20, F21, F22, F23, F24,
+    // Letters and digits
+    A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S, T, U, V, W, X, Y, Z,
+    DIGIT_0, DIGIT_1, DIGIT_2, DIGIT_3, DIGIT_4, DIGIT_5, DIGIT_6, DIGIT_7, DIGIT_8, DIGIT_9,
+    // Punctuation
+    MINUS, EQUAL, LEFT_BRACKET, RIGHT_BRACKET, BACKSLASH, SEMICOLON, APOSTROPHE, GRAVE,
+    COMMA, PERIOD, SLASH,
+    // Editing and navigation
+    BACKSPACE, DEL, INSERT, HOME, END, PAGE_UP, PAGE_DOWN,
+    CAPS_LOCK, NUM_LOCK, SCROLL_LOCK, PRINT_SCREEN, PAUSE, MENU,
+    // Right-hand and system modifiers
+    LEFT_META, RIGHT_META, RIGHT_ALT, RIGHT_CTRL, RIGHT_SHIFT,
+    // Numeric keypad
+    NUMPAD_0, NUMPAD_1, NUMPAD_2, NUMPAD_3, NUMPAD_4, NUMPAD_5, NUMPAD_6, NUMPAD_7, NUMPAD_8, NUMPAD_9,
+    NUMPAD_ADD, NUMPAD_SUBTRACT, NUMPAD_MULTIPLY, NUMPAD_DIVIDE, NUMPAD_DECIMAL, NUMPAD_ENTER,
+    // Media and browser keys
+    VOLUME_UP, VOLUME_DOWN, VOLUME_MUTE, MEDIA_PLAY_PAUSE, MEDIA_NEXT, MEDIA_PREVIOUS, MEDIA_STOP,
+    BROWSER_BACK, BROWSER_FORWARD, BROWSER_REFRESH, BROWSER_HOME,
+    COUNT // Number of key types, not a key
 };
 
 // Represents a single action that can be performed by a button
@@ -78,6 +139,10 @@ struct ButtonAction {
     bool repeat_on_hold = false;     // Whether to repeat key when held
     int repeat_delay = 500;          // Milliseconds before repeat starts
     int repeat_interval = 100;       // Milliseconds between repeats
+
+    // Keys of the action this version does not understand, as JSON text.
+    // They are written back unchanged so other versions keep their settings.
+    std::map<std::string, std::string> unknown_fields;
 };
 
 // Represents the mapping settings for a controller button
@@ -90,7 +155,8 @@ struct ButtonMapping {
 enum class TriggerActionType {
     NONE,
     BUTTON,
-    SCROLL
+    SCROLL,
+    BRAKE  // Pressure slows the cursor down for precise aiming
 };
 
 // Represents scroll action settings for triggers (independent from sticks)
@@ -104,9 +170,85 @@ struct TriggerMapping {
     bool enabled = false;
     TriggerActionType action_type = TriggerActionType::NONE;
     int threshold = 8000; // For button press detection
+    int release_threshold = -1; // Value a held trigger must fall below to release; -1 derives it from threshold
 
     // Action-specific settings
     ButtonMapping button_action; // Used if action_type is BUTTON
+    ButtonMapping full_pull_action; // Second stage pressed past full_pull_threshold if action_type is BUTTON
+    int full_pull_threshold = 32000;
+    float brake_strength = 0.75f; // Fraction of cursor speed removed at full pull if action_type is BRAKE
     TriggerScrollAction trigger_scroll_action; // Used if action_type is SCROLL
     std::string scroll_direction; // "up" or "down" if action_type is SCROLL
-}; 
\ No newline at end of file
+}; 
+
+// Forwarding to a virtual gamepad instead of mouse and keyboard output
+struct GamepadOutputMapping {
+    bool enabled = false;
+    std::map<std::string, std::string> buttons; // Source button -> virtual button, when not the same
+};
+
+// Cursor control from the controller's gyro, for controllers that have one
+struct GyroMapping {
+    bool enabled = false;
+    float sensitivity = 8.0f;  // Pixels per degree of rotation
+    float deadzone = 0.5f;     // Rotation below this many degrees per second is ignored
+    float tightening = 6.0f;   // Rotation below this many degrees per second is scaled down
+    bool calibrate = true;     // Track the gyro's drift while the controller is still
+};
+
+// Trackpad mode for controllers with a touch surface (DualShock 4, DualSense)
+struct TouchpadMapping {
+    bool enabled = false;
+    float sensitivity = 1000.0f;        // Pixels for a swipe across the full width of the pad
+    float acceleration = 0.5f;          // Extra gain per pad width per second of finger speed
+    float scroll_sensitivity = 1200.0f; // Scroll units (1/120 notch) for a two-finger swipe over the full height
+    bool tap_to_click = true;           // One-finger tap left clicks, two-finger tap right clicks
+    int tap_time = 180;                 // Longest touch in milliseconds that counts as a tap
+    float tap_distance = 0.02f;         // Farthest a tapping finger may move, as a fraction of the pad width
+};
+
+// Represents a complete mapping profile for one controller (or the "default" profile)
+struct MappingProfile {
+    std::string name;
+    StickMapping left_stick;
+    StickMapping right_stick;
+    std::map<std::string, ButtonMapping> buttons;   // button name -> mapping
+    std::map<std::string, TriggerMapping> triggers; // "left_trigger" / "right_trigger" -> mapping
+    GamepadOutputMapping gamepad_output;
+    GyroMapping gyro;
+    TouchpadMapping touchpad;
+};
+
+// Rest position and noise of one stick, learned while it is left alone
+struct StickCalibration {
+    float offset_x = 0.0f;  // Axis values reported at rest
+    float offset_y = 0.0f;
+    float deviation = 0.0f; // Mean distance of resting values from the offset
+    uint32_t samples = 0;   // Resting samples seen; 0 means not calibrated yet
+};
+
+// Calibration of a controller's sticks, stored per GUID in controllers.json
+struct ControllerCalibration {
+    StickCalibration left_stick;
+    StickCalibration right_stick;
+};
+
+// How cursor motion from several controllers is combined into the single
+// motion event emitted per frame
+enum class CursorMergePolicy {
+    SUM,           // Add every controller's motion
+    MAX_MAGNITUDE, // Use the controller moving the furthest this frame
+    MOST_RECENT    // Use the controller that most recently started moving
+};
+
+// output_rate value that follows the display refresh rate
+constexpr int OUTPUT_RATE_DISPLAY = -1;
+
+// Settings that apply to the core as a whole rather than to one controller
+struct CoreSettings {
+    CursorMergePolicy cursor_merge = CursorMergePolicy::SUM;
+    int output_rate = 0; // Cursor and scroll output frames per second; 0 sends output on every poll
+    bool kinetic_scroll = false;        // Keep scrolling after scroll inputs are released
+    float kinetic_scroll_decay = 0.05f; // Fraction of coasting speed left after one second
+    std::string output_sink = "platform"; // "platform", "null" (no output) or "recording"
+};
@@ -1,11 +1,111 @@
 #include "core/controller_manager.h"
+#include "core/core_server.h"
+#include "core/joycursor_core.h"
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <thread>
 #include <atomic>
 #include <chrono>
 #include <SDL3/SDL.h>
 
-int main() {
+namespace {
+// Same cadence as the GUI's in-process core, so both report comparable latency
+const int DEFAULT_POLL_INTERVAL_MS = 5;
+
+std::atomic<bool> g_stopRequested{false};
+
+void onStopSignal(int) {
+    g_stopRequested = true;
+}
+
+void printStats(const CoreStats& stats) {
+    std::cout << "Frames: " << stats.frames << ", cursor events: " << stats.cursor_events
+              << ", scroll events: " << stats.scroll_events
+              << ", display round trips: " << stats.round_trips
+              << " (max " << stats.max_frame_round_trips << " per frame)" << std::endl;
+    if (stats.output_time_ns > 0) {
+        double seconds = stats.output_time_ns / 1e9;
+        std::cout << "Output frames/s: " << stats.output_frames / seconds
+                  << ", output events/s: " << (stats.cursor_events + stats.scroll_events) / seconds
+                  << ", interval " << stats.output_interval_mean_us << " us +/- " << stats.output_jitter_us << " us" << std::endl;
+    }
+    if (stats.gamepad_latency.count > 0) {
+        std::cout << "Virtual gamepad latency: p50 " << stats.gamepad_latency.percentile(50)
+                  << " us, p99 " << stats.gamepad_latency.percentile(99) << " us" << std::endl;
+    }
+    if (stats.frame_time.count > 0) {
+        std::cout << "Frame time: p50 " << stats.frame_time.percentile(50)
+                  << " us, p99 " << stats.frame_time.percentile(99) << " us" << std::endl;
+    }
+    if (stats.input_latency.count > 0) {
+        std::cout << "Input to output latency: p50 " << stats.input_latency.percentile(50)
+                  << " us, p99 " << stats.input_latency.percentile(99) << " us" << std::endl;
+    }
+    if (stats.coalesced_frames > 0 || stats.dropped_motions > 0) {
+        std::cout << "Coalesced polls: " << stats.coalesced_frames << ", dropped motions: " << stats.dropped_motions << std::endl;
+    }
+    if (stats.idle_waits > 0) {
+        std::cout << "Idle waits: " << stats.idle_waits << ", resting controllers skipped: " << stats.idle_skips << std::endl;
+    }
+    if (stats.gyro_samples > 0) {
+        std::cout << "Gyro samples: " << stats.gyro_samples << std::endl;
+    }
+}
+
+// Runs the full core without a UI. UIs attach over the control socket (see
+// core_server.h) and may come and go while input keeps flowing. Polls every
+// poll_interval_ms while a controller is active and blocks while all are idle.
+int serve(int poll_interval_ms) {
+    JoyCursorCore core;
+    if (!core.initialize()) {
+        return 1;
+    }
+    CoreServer server(core);
+    if (!server.start()) {
+        return 1;
+    }
+    std::signal(SIGINT, onStopSignal);
+    std::signal(SIGTERM, onStopSignal);
+    std::cout << "Core running headless at " << coreSocketPath() << ". Press Ctrl+C to exit..." << std::endl;
+    const auto interval = std::chrono::milliseconds(poll_interval_ms);
+    auto next_poll = std::chrono::steady_clock::now();
+    while (!g_stopRequested) {
+        core.pollEvents();
+        server.publish();
+        // Bounded so a stop signal is noticed promptly. Input that ends an
+        // idle wait is polled right away and the schedule restarts from it.
+        if (core.waitForInput(50)) {
+            next_poll = std::chrono::steady_clock::now();
+            continue;
+        }
+        // waitForInput returns at once while a controller is active; the
+        // interval keeps that from spinning
+        next_poll += interval;
+        auto now = std::chrono::steady_clock::now();
+        if (next_poll > now) {
+            std::this_thread::sleep_until(next_poll);
+        } else {
+            next_poll = now;
+        }
+    }
+    server.stop();
+    printStats(core.getStats());
+    return 0;
+}
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "--serve") == 0) {
+        int poll_interval_ms = DEFAULT_POLL_INTERVAL_MS;
+        if (argc > 3 && std::strcmp(argv[2], "--poll-interval") == 0) {
+            poll_interval_ms = std::clamp(std::atoi(argv[3]), 1, 100);
+        }
+        return serve(poll_interval_ms);
+    }
+
     ControllerManager* manager = createControllerManager();
     std::cout << "Controller detection running. Press Enter to exit..." << std::endl;
     std::atomic<bool> running{true};
@@ -13,12 +113,15 @@ int main() {
         while (running) {
             manager->pollEvents();
             // std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            SDL_Delay(5);
+            if (!manager->waitForInput(100)) {
+                SDL_Delay(5);
+            }
         }
     });
     std::cin.get();
     running = false;
     pollThread.join();
+    printStats(manager->getStats());
     delete manager;
     return 0;
 } 
\ No newline at end of file
@@ -4,7 +4,10 @@
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
-    MainWindow w;
+    // --attach uses a core already running headless (JoyCursorCore --serve),
+    // so this window can be closed and reopened without interrupting input
+    bool attach = app.arguments().contains("--attach");
+    MainWindow w(attach ? CoreWorker::Mode::Attached : CoreWorker::Mode::InProcess);
     w.show();
     return app.exec();
 } 
\ No newline at end of file
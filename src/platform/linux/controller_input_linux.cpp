@@ -1,2 +1,272 @@
 // controller_input_linux.cpp
-// Implementation for Linux controller input (to be implemented) 
\ No newline at end of file
+// Implementation for Linux controller input
+
+#ifdef __linux__
+
+#include "controller_input_linux.h"
+#include "../../core/action_registry.h"
+#include "../../utils/logging.h"
+#include <cerrno>
+#include <iterator>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <linux/uinput.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace {
+
+const int WHEEL_DELTA = 120; // Scroll units per wheel notch
+
+// Event codes for SDL_GamepadButton and SDL_GamepadAxis values
+const unsigned short kGamepadButtonCodes[] = {
+    BTN_SOUTH, BTN_EAST, BTN_WEST, BTN_NORTH,
+    BTN_SELECT, BTN_MODE, BTN_START, BTN_THUMBL, BTN_THUMBR,
+    BTN_TL, BTN_TR,
+    BTN_DPAD_UP, BTN_DPAD_DOWN, BTN_DPAD_LEFT, BTN_DPAD_RIGHT
+};
+const unsigned short kGamepadAxisCodes[] = {ABS_X, ABS_Y, ABS_RX, ABS_RY, ABS_Z, ABS_RZ};
+const int kGamepadTriggerAxisStart = 4; // ABS_Z and ABS_RZ only report 0..32767
+
+int mouseButtonCode(MouseClickType clickType) {
+    const ActionInfo* info = findAction(clickType);
+    return info ? info->linux_code : 0;
+}
+
+} // namespace
+
+// A uinput device. Event codes are enabled between open() and create();
+// the device is removed when the object is destroyed. Events are queued
+// and written together by flush().
+class UinputDevice {
+public:
+    UinputDevice() = default;
+    UinputDevice(const UinputDevice&) = delete;
+    UinputDevice& operator=(const UinputDevice&) = delete;
+
+    ~UinputDevice() {
+        if (m_fd >= 0) {
+            ioctl(m_fd, UI_DEV_DESTROY);
+            close(m_fd);
+        }
+    }
+
+    bool open() {
+        m_fd = ::open("/dev/uinput", O_WRONLY | O_NONBLOCK);
+        if (m_fd < 0) {
+            logError(("Failed to open /dev/uinput (" + std::string(std::strerror(errno)) + ")").c_str());
+            return false;
+        }
+        return true;
+    }
+
+    void enable(unsigned long request, int code) { ioctl(m_fd, request, code); }
+
+    void enableAbs(int code, int minimum, int maximum) {
+        enable(UI_SET_ABSBIT, code);
+        uinput_abs_setup abs = {};
+        abs.code = static_cast<__u16>(code);
+        abs.absinfo.minimum = minimum;
+        abs.absinfo.maximum = maximum;
+        ioctl(m_fd, UI_ABS_SETUP, &abs);
+    }
+
+    bool create(const char* name) {
+        uinput_setup setup = {};
+        setup.id.bustype = BUS_VIRTUAL;
+        std::strncpy(setup.name, name, UINPUT_MAX_NAME_SIZE - 1);
+        if (ioctl(m_fd, UI_DEV_SETUP, &setup) < 0 || ioctl(m_fd, UI_DEV_CREATE) < 0) {
+            logError(("Failed to create uinput device " + std::string(name) + " (" +
+                      std::string(std::strerror(errno)) + ")").c_str());
+            close(m_fd);
+            m_fd = -1;
+            return false;
+        }
+        logInfo(("Created uinput device " + std::string(name)).c_str());
+        return true;
+    }
+
+    bool valid() const { return m_fd >= 0; }
+
+    void emit(unsigned short type, unsigned short code, int value) {
+        input_event event = {};
+        event.type = type;
+        event.code = code;
+        event.value = value;
+        m_pending.push_back(event);
+    }
+
+    void sync() { emit(EV_SYN, SYN_REPORT, 0); }
+
+    // Ends the current report if anything was emitted since the last one
+    void syncIfPending() {
+        if (!m_pending.empty() && m_pending.back().type != EV_SYN) {
+            sync();
+        }
+    }
+
+    void flush() {
+        if (m_pending.empty()) {
+            return;
+        }
+        // A dropped batch is not retried; the next frame sends fresh state
+        ssize_t written = write(m_fd, m_pending.data(), m_pending.size() * sizeof(input_event));
+        (void)written;
+        m_pending.clear();
+    }
+
+private:
+    int m_fd = -1;
+    std::vector<input_event> m_pending;
+};
+
+LinuxOutputSink::LinuxOutputSink()
+    : m_pointer(std::make_unique<UinputDevice>()) {
+    if (!m_pointer->open()) {
+        logError("Input simulation is disabled");
+        return;
+    }
+    m_pointer->enable(UI_SET_EVBIT, EV_KEY);
+    for (const ActionInfo& action : kActions) {
+        if (action.linux_code != 0) {
+            m_pointer->enable(UI_SET_KEYBIT, action.linux_code);
+        }
+    }
+    m_pointer->enable(UI_SET_EVBIT, EV_REL);
+    m_pointer->enable(UI_SET_RELBIT, REL_X);
+    m_pointer->enable(UI_SET_RELBIT, REL_Y);
+    m_pointer->enable(UI_SET_RELBIT, REL_WHEEL);
+    m_pointer->enable(UI_SET_RELBIT, REL_HWHEEL);
+    m_pointer->enable(UI_SET_RELBIT, REL_WHEEL_HI_RES);
+    m_pointer->enable(UI_SET_RELBIT, REL_HWHEEL_HI_RES);
+    m_pointer->create("JoyCursor Virtual Input");
+}
+
+LinuxOutputSink::~LinuxOutputSink() = default;
+
+bool LinuxOutputSink::supportsRelativeMotion() const {
+    return m_pointer->valid();
+}
+
+int LinuxOutputSink::getKeyCode(KeyboardKeyType keyType) {
+    const ActionInfo* info = findAction(keyType);
+    return info ? info->linux_code : 0;
+}
+
+// Sends the amount as a high-resolution wheel event, which uses the same
+// 1/120 notch units, plus whole notches for clients that only read REL_WHEEL.
+void LinuxOutputSink::appendScroll(unsigned short axis, unsigned short hi_res_axis, int amount, int& remainder) {
+    if (amount == 0) {
+        return;
+    }
+    m_pointer->emit(EV_REL, hi_res_axis, amount);
+    remainder += amount;
+    int notches = remainder / WHEEL_DELTA;
+    if (notches != 0) {
+        remainder -= notches * WHEEL_DELTA;
+        m_pointer->emit(EV_REL, axis, notches);
+    }
+    m_pointer->sync();
+}
+
+void LinuxOutputSink::deliver(const std::vector<OutputCommand>& commands) {
+    bool pointer = m_pointer->valid();
+    for (const OutputCommand& command : commands) {
+        switch (command.type) {
+            case OutputCommandType::MOUSE_BUTTON_DOWN:
+            case OutputCommandType::MOUSE_BUTTON_UP: {
+                int code = mouseButtonCode(static_cast<MouseClickType>(command.a));
+                if (code == 0) {
+                    logError("Unknown mouse click type");
+                } else if (pointer) {
+                    m_pointer->emit(EV_KEY, code, command.type == OutputCommandType::MOUSE_BUTTON_DOWN ? 1 : 0);
+                    m_pointer->sync();
+                }
+                break;
+            }
+            case OutputCommandType::MOUSE_MOVE:
+                if (pointer) {
+                    if (command.a != 0) m_pointer->emit(EV_REL, REL_X, command.a);
+                    if (command.b != 0) m_pointer->emit(EV_REL, REL_Y, command.b);
+                    m_pointer->syncIfPending();
+                }
+                break;
+            case OutputCommandType::KEYBOARD_DOWN:
+            case OutputCommandType::KEYBOARD_UP: {
+                int code = getKeyCode(static_cast<KeyboardKeyType>(command.a));
+                if (code != 0 && pointer) {
+                    m_pointer->emit(EV_KEY, code, command.type == OutputCommandType::KEYBOARD_DOWN ? 1 : 0);
+                    m_pointer->sync();
+                }
+                break;
+            }
+            case OutputCommandType::SCROLL_VERTICAL:
+                if (pointer) appendScroll(REL_WHEEL, REL_WHEEL_HI_RES, command.a, m_scroll_remainder_v);
+                break;
+            case OutputCommandType::SCROLL_HORIZONTAL:
+                if (pointer) appendScroll(REL_HWHEEL, REL_HWHEEL_HI_RES, command.a, m_scroll_remainder_h);
+                break;
+            case OutputCommandType::GAMEPAD_BUTTON: {
+                auto it = m_gamepads.find(command.device);
+                if (it != m_gamepads.end() && command.a >= 0 &&
+                    command.a < static_cast<int>(std::size(kGamepadButtonCodes))) {
+                    it->second->emit(EV_KEY, kGamepadButtonCodes[command.a], command.b);
+                }
+                break;
+            }
+            case OutputCommandType::GAMEPAD_AXIS: {
+                auto it = m_gamepads.find(command.device);
+                if (it != m_gamepads.end() && command.a >= 0 &&
+                    command.a < static_cast<int>(std::size(kGamepadAxisCodes))) {
+                    it->second->emit(EV_ABS, kGamepadAxisCodes[command.a], command.b);
+                }
+                break;
+            }
+        }
+    }
+    if (pointer) {
+        m_pointer->flush();
+    }
+    // Gamepad state changes within a frame form one report per device
+    for (auto& [id, gamepad] : m_gamepads) {
+        gamepad->syncIfPending();
+        gamepad->flush();
+    }
+}
+
+bool LinuxOutputSink::createVirtualGamepad(int id) {
+    if (m_gamepads.count(id)) {
+        return true;
+    }
+    auto gamepad = std::make_unique<UinputDevice>();
+    if (!gamepad->open()) {
+        return false;
+    }
+    gamepad->enable(UI_SET_EVBIT, EV_KEY);
+    for (unsigned short code : kGamepadButtonCodes) {
+        gamepad->enable(UI_SET_KEYBIT, code);
+    }
+    gamepad->enable(UI_SET_EVBIT, EV_ABS);
+    for (int i = 0; i < static_cast<int>(std::size(kGamepadAxisCodes)); ++i) {
+        gamepad->enableAbs(kGamepadAxisCodes[i], i < kGamepadTriggerAxisStart ? -32768 : 0, 32767);
+    }
+    if (!gamepad->create(kVirtualGamepadName)) {
+        return false;
+    }
+    m_gamepads[id] = std::move(gamepad);
+    return true;
+}
+
+void LinuxOutputSink::destroyVirtualGamepad(int id) {
+    m_gamepads.erase(id);
+}
+
+std::unique_ptr<OutputSink> createPlatformOutputSink() {
+    return std::make_unique<LinuxOutputSink>();
+}
+
+#endif // __linux__
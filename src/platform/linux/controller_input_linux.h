@@ -3,8 +3,41 @@
 
 #pragma once
 
-class ControllerInputLinux {
+#include "../../core/output_sink.h"
+#include <memory>
+#include <unordered_map>
+
+class UinputDevice;
+
+// Output is injected through a virtual mouse and keyboard created with
+// /dev/uinput, so it works the same under X11 and Wayland. The user needs
+// write access to /dev/uinput. Each commit is written to each device with
+// one write() call.
+class LinuxOutputSink final : public OutputSink {
 public:
-    void initialize();
-    void pollInput();
-}; 
\ No newline at end of file
+    LinuxOutputSink();
+    ~LinuxOutputSink() override;
+
+    const char* name() const override { return "uinput"; }
+    bool supportsRelativeMotion() const override;
+
+    // Virtual gamepads for profiles that forward to a gamepad. Buttons and
+    // axes use SDL_GamepadButton and SDL_GamepadAxis values.
+    bool createVirtualGamepad(int id) override;
+    void destroyVirtualGamepad(int id) override;
+
+    static int getKeyCode(KeyboardKeyType keyType);
+
+protected:
+    void deliver(const std::vector<OutputCommand>& commands) override;
+
+private:
+    void appendScroll(unsigned short axis, unsigned short hi_res_axis, int amount, int& remainder);
+
+    std::unique_ptr<UinputDevice> m_pointer; // Virtual mouse and keyboard
+    std::unordered_map<int, std::unique_ptr<UinputDevice>> m_gamepads;
+
+    // Scroll amounts below a notch are kept until they add up to one
+    int m_scroll_remainder_v = 0;
+    int m_scroll_remainder_h = 0;
+};
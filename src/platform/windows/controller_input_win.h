@@ -4,39 +4,29 @@
 #pragma once
 
 #include <windows.h>
-#include "../../core/types.h"
+#include "../../core/output_sink.h"
+#include <vector>
 
-class ControllerInputWin {
+// Output is injected with SendInput. Each commit is handed to the system as
+// one SendInput call, which also keeps the events of a frame together.
+class WindowsOutputSink final : public OutputSink {
 public:
-    static void initialize();
-    static void pollInput();
-    static void simulateMouseClick(MouseClickType clickType);
-    static void simulateMouseDown(MouseClickType clickType);
-    static void simulateMouseUp(MouseClickType clickType);
-    
-    // Keyboard simulation functions
-    static void simulateKeyPress(KeyboardKeyType keyType);
-    static void simulateKeyDown(KeyboardKeyType keyType);
-    static void simulateKeyUp(KeyboardKeyType keyType);
+    const char* name() const override { return "sendinput"; }
+    bool supportsRelativeMotion() const override { return true; }
+
+    // Creating a virtual gamepad on Windows needs a bus driver, so profiles
+    // with gamepad output keep using mouse and keyboard output there.
+    bool createVirtualGamepad(int id) override;
+
     static WORD getVirtualKeyCode(KeyboardKeyType keyType);
-    
-    // Scroll simulation functions
-    static void simulateScrollVertical(int amount);
-    static void simulateScrollHorizontal(int amount);
+
+protected:
+    void deliver(const std::vector<OutputCommand>& commands) override;
 
 private:
-    static INPUT createMouseInput(DWORD flags, DWORD data = 0);
-    static INPUT createKeyboardInput(WORD vkCode, DWORD flags = 0);
-};
+    void appendMouseButton(MouseClickType clickType, bool down);
+    void appendMouseInput(DWORD flags, DWORD data = 0, LONG dx = 0, LONG dy = 0);
+    void appendKeyboardInput(WORD vkCode, DWORD flags = 0);
 
-// Platform-agnostic extern C interface for core layer
-extern "C" {
-    void platform_simulate_mouse_click(int clickType);
-    void platform_simulate_mouse_down(int clickType);
-    void platform_simulate_mouse_up(int clickType);
-    void platform_simulate_key_press(int keyType);
-    void platform_simulate_key_down(int keyType);
-    void platform_simulate_key_up(int keyType);
-    void platform_simulate_scroll_vertical(int amount);
-    void platform_simulate_scroll_horizontal(int amount);
-} 
\ No newline at end of file
+    std::vector<INPUT> m_inputs; // Reused between commits
+};
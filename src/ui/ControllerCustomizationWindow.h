@@ -1,18 +1,50 @@
 #pragma once
 #include <QWidget>
 #include <QLabel>
-#include <QSlider>
-#include <QCheckBox>
-#include <QTableWidget>
 #include <QPushButton>
 #include <QVBoxLayout>
-#include <QHBoxLayout>
-#include <QComboBox>
+#include <QFormLayout>
 #include <QGroupBox>
 #include <QMap>
-#include <QSpinBox>
-#include <QStackedWidget>
+#include <QTabWidget>
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QPainterPath>
+#include <functional>
+#include <string>
+#include <vector>
 #include "../workers/CoreWorker.h"
+#include "../core/acceleration_curve.h"
+#include "ControllerVisualizerWidget.h"
+#include "MappingFieldSchema.h"
+
+// Plots an acceleration curve from the same lookup table the core uses
+class CurvePreviewWidget : public QWidget {
+public:
+    explicit CurvePreviewWidget(QWidget* parent = nullptr) : QWidget(parent) {
+        setFixedSize(120, 90);
+        setCurve(AccelerationCurve());
+    }
+    void setCurve(const AccelerationCurve& curve) { m_lut = compileAccelerationCurve(curve); update(); }
+protected:
+    void paintEvent(QPaintEvent*) override {
+        QPainter p(this);
+        p.setRenderHint(QPainter::Antialiasing);
+        QRectF area = QRectF(rect()).adjusted(4, 4, -4, -4);
+        p.setPen(QPen(QColor("#C7C7CC"), 1));
+        p.drawRect(area);
+        QPainterPath path;
+        for (int i = 0; i < kAccelerationLutSize; ++i) {
+            QPointF point(area.left() + area.width() * i / (kAccelerationLutSize - 1),
+                          area.bottom() - area.height() * m_lut.speed[i]);
+            if (i == 0) path.moveTo(point); else path.lineTo(point);
+        }
+        p.setPen(QPen(QColor("#007AFF"), 2));
+        p.drawPath(path);
+    }
+private:
+    AccelerationLut m_lut;
+};
 
 class ControllerCustomizationWindow : public QWidget {
     Q_OBJECT
@@ -28,88 +60,65 @@ public:
     void resetToDefault();
 
 private:
+    // A control generated from the field schema, bound to one mapping field
+    struct FieldBinding {
+        std::string path;              // Full field path, e.g. "left_stick.deadzone"
+        int whenBinding;               // Binding this one's visibility depends on, or -1
+        std::string whenValue;
+        QWidget* label;
+        QWidget* control;
+        std::function<void()> refresh; // Shows the field's current value
+    };
+
+    // Tab pages are built the first time they are shown
+    void ensurePage(int index);
+    QWidget* buildSticksPage();
+    QWidget* buildButtonsPage();
+    QWidget* buildTriggersPage();
+    // Adds the controls of one section's fields to a form
+    void addSectionFields(QFormLayout* form, const FieldSection& section, const std::vector<FieldSpec>& schema);
+    // Creates the control for a field and binds it; returns its binding index
+    int bindField(const std::string& prefix, const FieldSpec& spec, int whenBinding);
+
+    // Stores an edited value in the profile and updates what depends on it
+    void setField(const std::string& path, const MappingValue& value);
+    const MappingValue* fieldValue(const std::string& path) const;
+    bool isBindingVisible(int index) const;
+    // Refreshes every built control from the profile
+    void refreshBindings();
+    void updateVisibility();
+    void applyProfile(const MappingProfile& profile);
+    // Passes the edited deadzones, curves and thresholds to the live input view
+    void updateVisualizerOverlay();
+    void connectCoreWorker();
+
     QString m_guid;
     QString m_name;
     bool m_connected;
     CoreWorker* m_coreWorker = nullptr;
+    // The edited mappings and their flat view; built pages read and write
+    // fields here, so pages never built keep the loaded values
+    MappingProfile m_profile;
+    MappingFields m_fields;
+    std::vector<FieldBinding> m_bindings;
+    bool m_refreshing = false;
+    QElapsedTimer m_openTimer;
+
     // Title and status
     QLabel* titleLabel;
     QLabel* statusLabel;
     QLabel* statusValueLabel;
 
-    // Left Stick
-    QGroupBox* leftStickGroup;
-    QCheckBox* leftStickEnabled;
-    QComboBox* leftStickActionType;
-    QSlider* leftStickDeadzone; // (now unused, kept for compatibility)
-    QSpinBox* leftStickDeadzoneSpin;
-    QStackedWidget* leftStickStack;
-    QWidget* leftStickCursorWidget; // contains sensi, boosted, smoothing
-    QSlider* leftStickCursorSensi;
-    QSlider* leftStickCursorBoosted;
-    QSlider* leftStickCursorSmoothing;
-    QWidget* leftStickScrollWidget; // contains scroll params
-    QSlider* leftStickScrollVSensi;
-    QSlider* leftStickScrollHSensi;
-    QSlider* leftStickScrollVMax;
-    QSlider* leftStickScrollHMax;
-
-    // Right Stick
-    QGroupBox* rightStickGroup;
-    QCheckBox* rightStickEnabled;
-    QComboBox* rightStickActionType;
-    QSlider* rightStickDeadzone; // (now unused, kept for compatibility)
-    QSpinBox* rightStickDeadzoneSpin;
-    QStackedWidget* rightStickStack;
-    QWidget* rightStickCursorWidget;
-    QSlider* rightStickCursorSensi;
-    QSlider* rightStickCursorBoosted;
-    QSlider* rightStickCursorSmoothing;
-    QWidget* rightStickScrollWidget;
-    QSlider* rightStickScrollVSensi;
-    QSlider* rightStickScrollHSensi;
-    QSlider* rightStickScrollVMax;
-    QSlider* rightStickScrollHMax;
-
-    // Buttons
-    QGroupBox* buttonsGroup;
-    QTableWidget* buttonsTable;
-    QMap<int, QCheckBox*> buttonEnabledMap;
-    QMap<int, QComboBox*> buttonActionTypeMap;
-    QMap<int, QComboBox*> buttonKeyMap;
-    QMap<int, QCheckBox*> buttonRepeatMap;
-    QMap<int, QSlider*> buttonDelayMap;
-    QMap<int, QSlider*> buttonIntervalMap;
-    QMap<int, QString> buttonRowToName;
-
-    // Triggers
-    QGroupBox* leftTriggerGroup;
-    QCheckBox* leftTriggerEnabled;
-    QComboBox* leftTriggerActionType;
-    QSlider* leftTriggerThreshold; // (now unused, kept for compatibility)
-    QSpinBox* leftTriggerThresholdSpin;
-    QWidget* leftTriggerScrollWidget;
-    QComboBox* leftTriggerScrollDir;
-    QSlider* leftTriggerScrollVSensi;
-    QSlider* leftTriggerScrollVMax;
-    QWidget* leftTriggerButtonWidget;
-    QComboBox* leftTriggerButtonAction;
+    // Live input
+    QGroupBox* liveInputGroup;
+    ControllerVisualizerWidget* liveVisualizer = nullptr;
 
-    QGroupBox* rightTriggerGroup;
-    QCheckBox* rightTriggerEnabled;
-    QComboBox* rightTriggerActionType;
-    QSlider* rightTriggerThreshold; // (now unused, kept for compatibility)
-    QSpinBox* rightTriggerThresholdSpin;
-    QWidget* rightTriggerScrollWidget;
-    QComboBox* rightTriggerScrollDir;
-    QSlider* rightTriggerScrollVSensi;
-    QSlider* rightTriggerScrollVMax;
-    QWidget* rightTriggerButtonWidget;
-    QComboBox* rightTriggerButtonAction;
+    QTabWidget* pageTabs;
+    std::vector<bool> m_pageBuilt;
 
     // Buttons
     QPushButton* resetButton;
     QPushButton* okButton;
     QVBoxLayout* mainLayout;
     static QMap<QString, ControllerCustomizationWindow*> s_openWindows;
-}; 
\ No newline at end of file
+};
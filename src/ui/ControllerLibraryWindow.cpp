@@ -11,111 +11,6 @@
 #include <QDebug>
 #include <QIcon>
 #include <QPixmap>
-#include <QScrollArea>
-
-// ControllerListItem implementation
-ControllerCard::ControllerCard(const QString& guid, const QString& name, bool connected, QWidget* parent)
-    : QFrame(parent), m_guid(guid), m_name(name) {
-    setupUI();
-    updateStatus(connected);
-    setCursor(Qt::PointingHandCursor);
-    setFrameShape(QFrame::NoFrame);
-    setStyleSheet("QFrame { background: #fff; border: 1px solid #e0e0e0; border-radius: 8px; } QLabel { background: transparent; border: none; }");
-    setFixedHeight(48);
-    installEventFilter(this);
-}
-
-void ControllerCard::setupUI() {
-    QHBoxLayout* layout = new QHBoxLayout(this);
-    layout->setContentsMargins(12, 4, 12, 4);
-    layout->setSpacing(10);
-    // Icon
-    m_iconLabel = new QLabel();
-    m_iconLabel->setStyleSheet("background: transparent; border: none;");
-    QPixmap iconPixmap;
-    if (iconPixmap.load(":/icons/gamepad.svg")) {
-        m_iconLabel->setPixmap(iconPixmap.scaled(36, 36, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-    } else {
-        m_iconLabel->setText("🎮");
-        m_iconLabel->setStyleSheet("font-size: 24px; background: transparent; border: none;");
-    }
-    m_iconLabel->setFixedSize(36, 36);
-    layout->addWidget(m_iconLabel);
-    // Info
-    QVBoxLayout* infoLayout = new QVBoxLayout();
-    infoLayout->setSpacing(0);
-    infoLayout->setContentsMargins(0, 0, 0, 0);
-    m_nameLabel = new QLabel(m_name);
-    QFont nameFont;
-    nameFont.setPointSize(13);
-    nameFont.setBold(true);
-    m_nameLabel->setFont(nameFont);
-    m_nameLabel->setStyleSheet("color: #222; background: transparent; border: none;");
-    m_statusLabel = new QLabel();
-    m_statusLabel->setStyleSheet("color: #555; background: transparent; border: none;");
-    QFont statusFont;
-    statusFont.setPointSize(11);
-    m_statusLabel->setFont(statusFont);
-    infoLayout->addWidget(m_nameLabel);
-    infoLayout->addWidget(m_statusLabel);
-    layout->addLayout(infoLayout);
-    layout->addStretch();
-}
-
-void ControllerCard::setConnected(bool connected) {
-    updateStatus(connected);
-}
-
-void ControllerCard::setName(const QString& name) {
-    m_name = name;
-    m_nameLabel->setText(name);
-}
-
-void ControllerCard::updateStatus(bool connected) {
-    if (connected) {
-        m_statusLabel->setText("Connected");
-        m_statusLabel->setStyleSheet("color: #21c521; font-weight: bold;");
-        m_iconLabel->setStyleSheet("opacity: 1.0;");
-    } else {
-        m_statusLabel->setText("Not Connected");
-        m_statusLabel->setStyleSheet("color: #555;");
-        m_iconLabel->setStyleSheet("opacity: 0.5;");
-    }
-}
-
-void ControllerCard::setHover(bool hover) {
-    m_hovered = hover;
-    if (hover) {
-        setStyleSheet(
-            "QFrame { background: #f5faff; border: 1px solid #b3d4fc; border-radius: 8px; }"
-            "QLabel { background: transparent; border: none; }"
-        );
-    } else {
-        setStyleSheet(
-            "QFrame { background: #fff; border: 1px solid #e0e0e0; border-radius: 8px; }"
-            "QLabel { background: transparent; border: none; }"
-        );
-    }
-}
-
-bool ControllerCard::eventFilter(QObject* obj, QEvent* event) {
-    if (obj == this) {
-        if (event->type() == QEvent::MouseButtonRelease) {
-            emit clicked(m_guid);
-            return true;
-        }
-    }
-    return QFrame::eventFilter(obj, event);
-}
-
-void ControllerCard::enterEvent(QEnterEvent* event) {
-    setHover(true);
-    QFrame::enterEvent(event);
-}
-void ControllerCard::leaveEvent(QEvent* event) {
-    setHover(false);
-    QFrame::leaveEvent(event);
-}
 
 // ControllerLibraryWindow implementation
 ControllerLibraryWindow::ControllerLibraryWindow(CoreWorker* sharedCoreWorker, QWidget* parent)
@@ -146,86 +41,74 @@ void ControllerLibraryWindow::setupUI() {
     m_titleLabel->setFont(titleFont);
     m_titleLabel->setStyleSheet("color: #222; margin-bottom: 8px;");
     m_mainLayout->addWidget(m_titleLabel);
-    // Card list area
-    m_cardListWidget = new QWidget();
-    m_cardListLayout = new QVBoxLayout(m_cardListWidget);
-    m_cardListLayout->setContentsMargins(0, 0, 0, 0);
-    m_cardListLayout->setSpacing(8);
-    // Make the card list scrollable
-    QScrollArea* scrollArea = new QScrollArea(this);
-    scrollArea->setWidgetResizable(true);
-    scrollArea->setFrameShape(QFrame::NoFrame);
-    scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff); // Hide vertical scrollbar
-    scrollArea->setWidget(m_cardListWidget);
-    scrollArea->setStyleSheet("QScrollArea { border: none; background: transparent; } QScrollBar { width: 0px; height: 0px; }");
-    m_mainLayout->addWidget(scrollArea);
-    m_mainLayout->addStretch();
-}
-
-void ControllerLibraryWindow::clearControllerCards() {
-    QLayoutItem* item;
-    while ((item = m_cardListLayout->takeAt(0)) != nullptr) {
-        if (QWidget* w = item->widget()) {
-            w->deleteLater();
-        }
-        delete item;
-    }
-    m_cardWidgets.clear();
+    // Card list: one painted row per controller, all the same height
+    m_model = new ControllerListModel(this);
+    m_listView = new QListView(this);
+    m_listView->setModel(m_model);
+    m_listView->setItemDelegate(new ControllerCardDelegate(m_listView));
+    m_listView->setUniformItemSizes(true);
+    m_listView->setMouseTracking(true);
+    m_listView->setSelectionMode(QAbstractItemView::NoSelection);
+    m_listView->setFocusPolicy(Qt::NoFocus);
+    m_listView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    m_listView->setFrameShape(QFrame::NoFrame);
+    m_listView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    m_listView->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff); // Hide vertical scrollbar
+    m_listView->viewport()->setCursor(Qt::PointingHandCursor);
+    m_listView->setStyleSheet("QListView { border: none; background: transparent; } QScrollBar { width: 0px; height: 0px; }");
+    connect(m_listView, &QListView::clicked, this, &ControllerLibraryWindow::onControllerClicked);
+    m_mainLayout->addWidget(m_listView);
 }
 
 void ControllerLibraryWindow::loadKnownControllers() {
-    if (m_coreWorker && m_coreWorker->getCore()) {
-        auto knownControllers = m_coreWorker->getCore()->getKnownControllers();
-        m_knownControllers.clear();
-        for (const auto& pair : knownControllers) {
-            QString guid = QString::fromStdString(pair.first);
-            QString name = QString::fromStdString(pair.second);
-            m_knownControllers[guid] = name;
-        }
-        // Get currently connected controllers for initial status
-        m_connectedGuids.clear();
-        auto connectedControllers = m_coreWorker->getCore()->getConnectedControllers();
-        for (const auto& pair : connectedControllers) {
-            QString guid = QString::fromStdString(pair.first);
-            m_connectedGuids.insert(guid);
-        }
+    if (!m_coreWorker) {
+        refreshControllerList();
+        return;
     }
-    refreshControllerList();
-}
-
+    m_coreWorker->requestControllers(this,
+        [this](const ControllerLists& lists) {
+            m_knownControllers.clear();
+            for (const auto& pair : lists.first) {
+                QString guid = QString::fromStdString(pair.first);
+                QString name = QString::fromStdString(pair.second);
+                m_knownControllers[guid] = name;
+            }
+            // Get currently connected controllers for initial status
+            m_connectedGuids.clear();
+            for (const auto& pair : lists.second) {
+                QString guid = QString::fromStdString(pair.first);
+                m_connectedGuids.insert(guid);
+            }
+            refreshControllerList();
+        });
+}
+
+// Merges the latest lists into the model; unchanged rows are left alone
 void ControllerLibraryWindow::refreshControllerList() {
-    clearControllerCards();
-    for (auto it = m_knownControllers.begin(); it != m_knownControllers.end(); ++it) {
-        QString guid = it.key();
-        QString name = it.value();
-        bool connected = m_connectedGuids.contains(guid);
-        ControllerCard* card = new ControllerCard(guid, name, connected);
-        connect(card, &ControllerCard::clicked, this, &ControllerLibraryWindow::onControllerCardClicked);
-        m_cardListLayout->addWidget(card);
-        m_cardWidgets[guid] = card;
-    }
-    m_cardListLayout->addStretch();
+    m_model->setControllers(m_knownControllers, m_connectedGuids);
 }
 
 void ControllerLibraryWindow::showEvent(QShowEvent* event) {
     QWidget::showEvent(event);
-    refreshControllerList();
+    loadKnownControllers();
 }
 
 void ControllerLibraryWindow::onControllerConnected(const QString& guid, const QString& name) {
-    if (m_cardWidgets.contains(guid)) {
-        m_cardWidgets[guid]->setConnected(true);
+    // A controller seen for the first time is added to the known list by the core
+    if (!m_knownControllers.contains(guid)) {
+        m_knownControllers[guid] = name;
     }
+    m_connectedGuids.insert(guid);
+    m_model->setConnected(guid, m_knownControllers.value(guid), true);
 }
 
 void ControllerLibraryWindow::onControllerDisconnected(const QString& guid) {
-    if (m_cardWidgets.contains(guid)) {
-        m_cardWidgets[guid]->setConnected(false);
-    }
+    m_connectedGuids.remove(guid);
+    updateControllerStatus(guid, false);
 }
 
-void ControllerLibraryWindow::onControllerCardClicked(const QString& guid) {
+void ControllerLibraryWindow::onControllerClicked(const QModelIndex& index) {
+    QString guid = index.data(ControllerListModel::GuidRole).toString();
     emit controllerSelected(guid);
     openCustomizationWindow(guid);
 }
@@ -237,8 +120,8 @@ void ControllerLibraryWindow::openCustomizationWindow(const QString& guid) {
 }
 
 void ControllerLibraryWindow::updateControllerStatus(const QString& guid, bool connected) {
-    if (m_cardWidgets.contains(guid)) {
-        m_cardWidgets[guid]->setConnected(connected);
+    if (m_model->contains(guid)) {
+        m_model->setConnected(guid, QString(), connected);
     }
 }
 
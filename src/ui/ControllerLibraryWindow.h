@@ -4,42 +4,15 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QPushButton>
-#include <QFrame>
+#include <QListView>
 #include <QThread>
 #include <QTimer>
 #include <QMap>
 #include <QString>
 #include "../workers/CoreWorker.h"
-#include <QEnterEvent>
 #include <QSet>
 #include "ControllerCustomizationWindow.h"
-
-// Card widget for a single controller
-class ControllerCard : public QFrame {
-    Q_OBJECT
-public:
-    explicit ControllerCard(const QString& guid, const QString& name, bool connected, QWidget* parent = nullptr);
-    void setConnected(bool connected);
-    void setName(const QString& name);
-    QString getGuid() const { return m_guid; }
-    QString getName() const { return m_name; }
-protected:
-    bool eventFilter(QObject* obj, QEvent* event) override;
-    void enterEvent(QEnterEvent* event) override;
-    void leaveEvent(QEvent* event) override;
-signals:
-    void clicked(const QString& guid);
-private:
-    QString m_guid;
-    QString m_name;
-    QLabel* m_iconLabel;
-    QLabel* m_nameLabel;
-    QLabel* m_statusLabel;
-    void updateStatus(bool connected);
-    void setupUI();
-    void setHover(bool hover);
-    bool m_hovered = false;
-};
+#include "ControllerListModel.h"
 
 class ControllerLibraryWindow : public QWidget {
     Q_OBJECT
@@ -57,7 +30,7 @@ signals:
 private slots:
     void onControllerConnected(const QString& guid, const QString& name);
     void onControllerDisconnected(const QString& guid);
-    void onControllerCardClicked(const QString& guid);
+    void onControllerClicked(const QModelIndex& index);
     void openCustomizationWindow(const QString& guid);
 
 private:
@@ -65,12 +38,12 @@ private:
     void loadKnownControllers();
     void updateControllerStatus(const QString& guid, bool connected);
     void saveControllerChanges();
-    void clearControllerCards();
 
     QVBoxLayout* m_mainLayout;
     QLabel* m_titleLabel;
-    QWidget* m_cardListWidget;
-    QVBoxLayout* m_cardListLayout;
+    // Only visible rows are painted; connect and disconnect update single rows
+    QListView* m_listView;
+    ControllerListModel* m_model;
 
     CoreWorker* m_coreWorker;
 
@@ -79,6 +52,4 @@ private:
     // Track currently connected controllers: GUID -> name
     QMap<QString, QString> m_connectedControllers;
     QSet<QString> m_connectedGuids; // Track currently connected controller GUIDs
-    // Map GUID to ControllerCard
-    QMap<QString, ControllerCard*> m_cardWidgets;
 }; 
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "ControllerListModel.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <algorithm>
+
+ControllerListModel::ControllerListModel(QObject* parent)
+    : QAbstractListModel(parent) {}
+
+int ControllerListModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_entries.size());
+}
+
+QVariant ControllerListModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= m_entries.size()) return QVariant();
+    const Entry& entry = m_entries[index.row()];
+    switch (role) {
+        case Qt::DisplayRole: return entry.name;
+        case Qt::ToolTipRole:
+        case GuidRole: return entry.guid;
+        case ConnectedRole: return entry.connected;
+        default: return QVariant();
+    }
+}
+
+void ControllerListModel::setControllers(const QMap<QString, QString>& known, const QSet<QString>& connected) {
+    if (m_entries.isEmpty()) {
+        // First load: one reset instead of a signal per row
+        beginResetModel();
+        for (auto it = known.begin(); it != known.end(); ++it) {
+            m_entries.push_back({it.key(), it.value(), connected.contains(it.key())});
+        }
+        reindexFrom(0);
+        endResetModel();
+        return;
+    }
+
+    // Remove rows that are no longer known, bottom up so row numbers stay valid
+    for (int row = static_cast<int>(m_entries.size()) - 1; row >= 0; --row) {
+        if (known.contains(m_entries[row].guid)) continue;
+        int last = row;
+        while (row > 0 && !known.contains(m_entries[row - 1].guid)) --row;
+        beginRemoveRows(QModelIndex(), row, last);
+        m_entries.remove(row, last - row + 1);
+        endRemoveRows();
+    }
+
+    // Both lists are now sorted by GUID and the rows a subsequence of known;
+    // walk them together, inserting new rows and updating changed ones
+    int row = 0;
+    for (auto it = known.begin(); it != known.end(); ++it, ++row) {
+        bool isConnected = connected.contains(it.key());
+        if (row < m_entries.size() && m_entries[row].guid == it.key()) {
+            Entry& entry = m_entries[row];
+            if (entry.name != it.value() || entry.connected != isConnected) {
+                entry.name = it.value();
+                entry.connected = isConnected;
+                emit dataChanged(index(row), index(row));
+            }
+            continue;
+        }
+        beginInsertRows(QModelIndex(), row, row);
+        m_entries.insert(row, {it.key(), it.value(), isConnected});
+        endInsertRows();
+    }
+    reindexFrom(0);
+}
+
+void ControllerListModel::setConnected(const QString& guid, const QString& name, bool connected) {
+    auto found = m_rows.constFind(guid);
+    if (found != m_rows.constEnd()) {
+        Entry& entry = m_entries[*found];
+        bool renamed = !name.isEmpty() && entry.name != name;
+        if (entry.connected == connected && !renamed) return;
+        entry.connected = connected;
+        if (renamed) entry.name = name;
+        emit dataChanged(index(*found), index(*found));
+        return;
+    }
+    int row = insertionRow(guid);
+    beginInsertRows(QModelIndex(), row, row);
+    m_entries.insert(row, {guid, name.isEmpty() ? QString("Unknown Controller") : name, connected});
+    reindexFrom(row);
+    endInsertRows();
+}
+
+QString ControllerListModel::name(const QString& guid) const {
+    auto found = m_rows.constFind(guid);
+    return found != m_rows.constEnd() ? m_entries[*found].name : QString();
+}
+
+bool ControllerListModel::isConnected(const QString& guid) const {
+    auto found = m_rows.constFind(guid);
+    return found != m_rows.constEnd() && m_entries[*found].connected;
+}
+
+int ControllerListModel::insertionRow(const QString& guid) const {
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), guid,
+                               [](const Entry& entry, const QString& key) { return entry.guid < key; });
+    return static_cast<int>(it - m_entries.begin());
+}
+
+void ControllerListModel::reindexFrom(int row) {
+    if (row == 0) m_rows.clear();
+    for (int i = row; i < m_entries.size(); ++i) {
+        m_rows[m_entries[i].guid] = i;
+    }
+}
+
+// ControllerCardDelegate implementation
+namespace {
+const int cardHeight = 48;
+const int cardSpacing = 8;
+const int iconSize = 36;
+}
+
+ControllerCardDelegate::ControllerCardDelegate(QObject* parent)
+    : QStyledItemDelegate(parent) {
+    // Loaded once and shared by every row
+    QPixmap icon;
+    if (icon.load(":/icons/gamepad.svg")) {
+        m_icon = icon.scaled(iconSize, iconSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+}
+
+void ControllerCardDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    bool connected = index.data(ControllerListModel::ConnectedRole).toBool();
+    bool hovered = option.state & QStyle::State_MouseOver;
+    QRectF card = QRectF(option.rect).adjusted(0.5, 0.5, -0.5, -cardSpacing - 0.5);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    QPainterPath path;
+    path.addRoundedRect(card, 8, 8);
+    painter->fillPath(path, hovered ? QColor("#f5faff") : QColor("#fff"));
+    painter->setPen(QPen(hovered ? QColor("#b3d4fc") : QColor("#e0e0e0"), 1));
+    painter->drawPath(path);
+
+    QRectF iconRect(card.left() + 12, card.center().y() - iconSize / 2.0, iconSize, iconSize);
+    painter->setOpacity(connected ? 1.0 : 0.5);
+    if (!m_icon.isNull()) {
+        painter->drawPixmap(iconRect.topLeft(), m_icon);
+    } else {
+        QFont emojiFont = option.font;
+        emojiFont.setPixelSize(24);
+        painter->setFont(emojiFont);
+        painter->drawText(iconRect, Qt::AlignCenter, QString::fromUtf8("🎮"));
+    }
+    painter->setOpacity(1.0);
+
+    QRectF textRect = card.adjusted(12 + iconSize + 10, 4, -12, -4);
+    QFont nameFont = option.font;
+    nameFont.setPointSize(13);
+    nameFont.setBold(true);
+    painter->setFont(nameFont);
+    painter->setPen(QColor("#222"));
+    QRectF nameRect(textRect.left(), textRect.top(), textRect.width(), textRect.height() * 0.55);
+    painter->drawText(nameRect, Qt::AlignLeft | Qt::AlignBottom,
+                      QFontMetrics(nameFont).elidedText(index.data(Qt::DisplayRole).toString(), Qt::ElideRight, static_cast<int>(nameRect.width())));
+
+    QFont statusFont = option.font;
+    statusFont.setPointSize(11);
+    statusFont.setBold(connected);
+    painter->setFont(statusFont);
+    painter->setPen(connected ? QColor("#21c521") : QColor("#555"));
+    QRectF statusRect(textRect.left(), nameRect.bottom(), textRect.width(), textRect.height() - nameRect.height());
+    painter->drawText(statusRect, Qt::AlignLeft | Qt::AlignTop, connected ? "Connected" : "Not Connected");
+    painter->restore();
+}
+
+QSize ControllerCardDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex&) const {
+    return QSize(option.rect.width(), cardHeight + cardSpacing);
+}
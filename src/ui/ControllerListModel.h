@@ -0,0 +1,59 @@
+#pragma once
+#include <QAbstractListModel>
+#include <QStyledItemDelegate>
+#include <QHash>
+#include <QMap>
+#include <QPixmap>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+// Known controllers sorted by GUID, with their connection state. Updates touch
+// only the rows that changed, so views keep their scroll position and only
+// repaint what is visible.
+class ControllerListModel : public QAbstractListModel {
+    Q_OBJECT
+public:
+    enum Role {
+        GuidRole = Qt::UserRole + 1,
+        ConnectedRole
+    };
+
+    explicit ControllerListModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    // Replaces the list by merging: rows missing from known are removed, new
+    // ones inserted and rows whose name or state changed are updated
+    void setControllers(const QMap<QString, QString>& known, const QSet<QString>& connected);
+    // Updates one controller's state, adding it if it is not listed yet
+    void setConnected(const QString& guid, const QString& name, bool connected);
+
+    bool contains(const QString& guid) const { return m_rows.contains(guid); }
+    QString name(const QString& guid) const;
+    bool isConnected(const QString& guid) const;
+
+private:
+    struct Entry {
+        QString guid;
+        QString name;
+        bool connected;
+    };
+    int insertionRow(const QString& guid) const;
+    void reindexFrom(int row);
+
+    QVector<Entry> m_entries;
+    QHash<QString, int> m_rows; // GUID -> row
+};
+
+// Paints a controller row as a card: icon, name and connection state
+class ControllerCardDelegate : public QStyledItemDelegate {
+public:
+    explicit ControllerCardDelegate(QObject* parent = nullptr);
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+private:
+    QPixmap m_icon;
+};
@@ -0,0 +1,156 @@
+#include "ControllerVisualizerWidget.h"
+#include <QPainter>
+#include <QScreen>
+#include <QStringList>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Labels in SDL_GamepadButton order
+const char* const buttonLabels[] = {
+    "A", "B", "X", "Y", "Select", "Guide", "Start", "L3", "R3",
+    "L1", "R1", "D-Up", "D-Down", "D-Left", "D-Right"
+};
+constexpr int buttonLabelCount = sizeof(buttonLabels) / sizeof(buttonLabels[0]);
+constexpr float axisMax = 32767.0f;
+}
+
+ControllerVisualizerWidget::ControllerVisualizerWidget(QWidget* parent)
+    : QWidget(parent) {
+    setMinimumSize(360, 170);
+    m_curves[0] = m_curves[1] = compileAccelerationCurve(AccelerationCurve());
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &ControllerVisualizerWidget::sample);
+}
+
+void ControllerVisualizerWidget::setSource(const InputSnapshotTable* snapshots, const QString& guid) {
+    m_snapshots = snapshots;
+    m_guid = guid.toUtf8();
+    m_connected = false;
+    m_snapshot = InputSnapshot();
+    update();
+}
+
+void ControllerVisualizerWidget::setStickOverlay(int stick, int deadzone, const AccelerationCurve& curve) {
+    if (stick < 0 || stick > 1) return;
+    m_deadzones[stick] = deadzone;
+    m_curves[stick] = compileAccelerationCurve(curve);
+    update();
+}
+
+void ControllerVisualizerWidget::setTriggerThresholds(int left, int right) {
+    m_thresholds[0] = left;
+    m_thresholds[1] = right;
+    update();
+}
+
+void ControllerVisualizerWidget::showEvent(QShowEvent*) {
+    // One sample per display refresh
+    qreal rate = screen() ? screen()->refreshRate() : 60.0;
+    m_timer.start(std::max(1, static_cast<int>(1000.0 / (rate > 0.0 ? rate : 60.0))));
+}
+
+void ControllerVisualizerWidget::hideEvent(QHideEvent*) {
+    m_timer.stop();
+}
+
+void ControllerVisualizerWidget::sample() {
+    if (!m_snapshots) return;
+    InputSnapshot latest;
+    bool busy = false;
+    bool connected = m_snapshots->find(m_guid.constData(), latest, &busy);
+    // A slot mid-write may hold this controller; keep the last good snapshot
+    // rather than flashing it as disconnected
+    if (!connected && busy) return;
+    if (connected == m_connected && (!connected || latest.version == m_snapshot.version)) {
+        return;
+    }
+    m_connected = connected;
+    if (connected) m_snapshot = latest;
+    update();
+}
+
+void ControllerVisualizerWidget::paintEvent(QPaintEvent*) {
+    QPainter p(this);
+    p.setRenderHint(QPainter::Antialiasing);
+    if (!m_connected) {
+        p.setPen(QColor("#8E8E93"));
+        p.drawText(rect(), Qt::AlignCenter, "Connect the controller to see its input");
+        return;
+    }
+    const qreal stickSize = std::min<qreal>(height() - 30, width() / 3.0);
+    paintStick(p, QRectF(0, 0, stickSize, stickSize), 0);
+    paintStick(p, QRectF(width() - stickSize, 0, stickSize, stickSize), 1);
+    qreal middle = stickSize + 8;
+    qreal middleWidth = width() - 2 * middle;
+    paintTrigger(p, QRectF(middle, 0, middleWidth / 2 - 4, stickSize), 0);
+    paintTrigger(p, QRectF(middle + middleWidth / 2 + 4, 0, middleWidth / 2 - 4, stickSize), 1);
+
+    QStringList held;
+    for (int i = 0; i < buttonLabelCount; ++i) {
+        if (m_snapshot.buttons & (1u << i)) held << buttonLabels[i];
+    }
+    p.setPen(QColor("#1C1C1E"));
+    p.drawText(QRectF(0, stickSize + 6, width(), height() - stickSize - 6), Qt::AlignLeft | Qt::AlignVCenter,
+               held.isEmpty() ? QString("Buttons: none") : "Buttons: " + held.join(" "));
+}
+
+// Outer ring is full deflection, the grey disc the deadzone around the
+// calibrated rest position. The grey dot is the raw stick position; the blue
+// dot is its direction from rest scaled by the acceleration curve, i.e. the
+// share of full cursor speed it produces.
+void ControllerVisualizerWidget::paintStick(QPainter& p, const QRectF& area, int stick) const {
+    QRectF circle = area.adjusted(6, 6, -6, -6);
+    QPointF center = circle.center();
+    qreal radius = circle.width() / 2;
+    p.setPen(QPen(QColor("#C7C7CC"), 1));
+    p.setBrush(Qt::NoBrush);
+    p.drawEllipse(center, radius, radius);
+    const int rawX = m_snapshot.axes[stick * 2];
+    const int rawY = m_snapshot.axes[stick * 2 + 1];
+    const int restX = m_snapshot.stick_rest[stick * 2];
+    const int restY = m_snapshot.stick_rest[stick * 2 + 1];
+    QPointF rest = center + QPointF(restX / axisMax * radius, restY / axisMax * radius);
+    qreal deadzone = std::clamp(m_deadzones[stick] / axisMax, 0.0f, 1.0f) * radius;
+    p.setPen(Qt::NoPen);
+    p.setBrush(QColor("#E5E5EA"));
+    p.drawEllipse(rest, deadzone, deadzone);
+
+    float x = std::clamp(rawX / axisMax, -1.0f, 1.0f);
+    float y = std::clamp(rawY / axisMax, -1.0f, 1.0f);
+    p.setBrush(QColor("#8E8E93"));
+    p.drawEllipse(center + QPointF(x * radius, y * radius), 4, 4);
+
+    // The core measures each axis from the rest position, stretched so full
+    // deflection still reaches the edge, and zeroes it inside the deadzone
+    auto fromRest = [this, stick](int value, int restValue) {
+        if (std::abs(value - restValue) < m_deadzones[stick]) return 0.0f;
+        float span = value >= restValue ? axisMax - restValue : axisMax + 1.0f + restValue;
+        return std::clamp((value - restValue) / std::max(span, 1.0f), -1.0f, 1.0f);
+    };
+    float dx = fromRest(rawX, restX);
+    float dy = fromRest(rawY, restY);
+    float deflection = std::min(std::sqrt(dx * dx + dy * dy), 1.0f);
+    if (deflection > 0.0f) {
+        float scale = m_curves[stick].evaluate(deflection) / deflection;
+        p.setBrush(QColor("#007AFF"));
+        p.drawEllipse(center + QPointF(dx * scale * radius, dy * scale * radius), 5, 5);
+    }
+}
+
+void ControllerVisualizerWidget::paintTrigger(QPainter& p, const QRectF& area, int trigger) const {
+    QRectF bar = area.adjusted(area.width() / 2 - 10, 6, -(area.width() / 2 - 10), -20);
+    float value = std::clamp(m_snapshot.axes[4 + trigger] / axisMax, 0.0f, 1.0f);
+    float threshold = std::clamp(m_thresholds[trigger] / axisMax, 0.0f, 1.0f);
+    p.setPen(QPen(QColor("#C7C7CC"), 1));
+    p.setBrush(Qt::NoBrush);
+    p.drawRect(bar);
+    p.setPen(Qt::NoPen);
+    p.setBrush(value >= threshold ? QColor("#007AFF") : QColor("#8E8E93"));
+    p.drawRect(QRectF(bar.left(), bar.bottom() - bar.height() * value, bar.width(), bar.height() * value));
+    qreal thresholdY = bar.bottom() - bar.height() * threshold;
+    p.setPen(QPen(QColor("#FF3B30"), 1));
+    p.drawLine(QPointF(bar.left() - 4, thresholdY), QPointF(bar.right() + 4, thresholdY));
+    p.setPen(QColor("#1C1C1E"));
+    p.drawText(QRectF(area.left(), bar.bottom() + 2, area.width(), 18), Qt::AlignCenter, trigger == 0 ? "LT" : "RT");
+}
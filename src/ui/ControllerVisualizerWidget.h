@@ -0,0 +1,40 @@
+#pragma once
+#include <QWidget>
+#include <QTimer>
+#include <QByteArray>
+#include "../core/acceleration_curve.h"
+#include "../core/input_snapshot.h"
+
+// Live view of one controller's sticks, triggers and held buttons, drawn from
+// the snapshots the core publishes each poll. A timer samples the snapshot at
+// the display refresh rate and asks for a repaint only when it changed, and
+// update() merges repaint requests, so GUI work is bounded by the refresh rate
+// whatever the poll rate.
+class ControllerVisualizerWidget : public QWidget {
+public:
+    explicit ControllerVisualizerWidget(QWidget* parent = nullptr);
+
+    void setSource(const InputSnapshotTable* snapshots, const QString& guid);
+    // Deadzone and acceleration curve drawn over the stick (0 left, 1 right)
+    void setStickOverlay(int stick, int deadzone, const AccelerationCurve& curve);
+    void setTriggerThresholds(int left, int right);
+
+protected:
+    void paintEvent(QPaintEvent*) override;
+    void showEvent(QShowEvent*) override;
+    void hideEvent(QHideEvent*) override;
+
+private:
+    void sample();
+    void paintStick(QPainter& p, const QRectF& area, int stick) const;
+    void paintTrigger(QPainter& p, const QRectF& area, int trigger) const;
+
+    const InputSnapshotTable* m_snapshots = nullptr;
+    QByteArray m_guid;
+    QTimer m_timer;
+    InputSnapshot m_snapshot = {};
+    bool m_connected = false;
+    int m_deadzones[2] = {8000, 8000};
+    AccelerationLut m_curves[2];
+    int m_thresholds[2] = {8000, 8000};
+};
@@ -0,0 +1,101 @@
+#include "CoreStatsPanel.h"
+#include <QApplication>
+#include <QClipboard>
+#include <QGridLayout>
+#include <QPushButton>
+
+namespace {
+const char* const rowLabels[] = {
+    "Poll rate", "Frame time p50 / p99", "Input to output p99", "Output events",
+    "Coalesced / dropped", "Config save / reload"
+};
+const int refreshIntervalMs = 250;
+
+QString milliseconds(uint32_t us) {
+    return QString::number(us / 1000.0, 'f', 2) + " ms";
+}
+}
+
+CoreStatsPanel::CoreStatsPanel(QWidget* parent)
+    : QFrame(parent) {
+    setFrameShape(QFrame::StyledPanel);
+    setStyleSheet("QFrame { border: 1px solid #e0e0e0; border-radius: 10px; background: #fff; } QLabel { border: none; background: transparent; }");
+    QGridLayout* layout = new QGridLayout(this);
+    layout->setContentsMargins(14, 8, 14, 8);
+    layout->setHorizontalSpacing(12);
+    layout->setVerticalSpacing(2);
+    QFont font;
+    font.setPointSize(10);
+    for (int row = 0; row < RowCount; ++row) {
+        QLabel* name = new QLabel(rowLabels[row]);
+        name->setFont(font);
+        name->setStyleSheet("color: #555;");
+        m_values[row] = new QLabel("-");
+        m_values[row]->setFont(font);
+        m_values[row]->setStyleSheet("color: #222;");
+        m_values[row]->setTextInteractionFlags(Qt::TextSelectableByMouse);
+        layout->addWidget(name, row, 0);
+        layout->addWidget(m_values[row], row, 1);
+    }
+    QPushButton* copyButton = new QPushButton("Copy");
+    copyButton->setCursor(Qt::PointingHandCursor);
+    copyButton->setStyleSheet("QPushButton { color: #1565c0; background: transparent; border: none; padding: 0; } QPushButton:hover { text-decoration: underline; }");
+    layout->addWidget(copyButton, 0, 2, Qt::AlignRight | Qt::AlignTop);
+    layout->setColumnStretch(1, 1);
+    connect(copyButton, &QPushButton::clicked, this, [this]() {
+        QApplication::clipboard()->setText(reportText());
+    });
+
+    connect(&m_timer, &QTimer::timeout, this, &CoreStatsPanel::refresh);
+}
+
+void CoreStatsPanel::setSource(const SeqlockSlot<LiveStats>* stats) {
+    m_source = stats;
+    refresh();
+}
+
+void CoreStatsPanel::showEvent(QShowEvent*) {
+    refresh();
+    m_timer.start(refreshIntervalMs);
+}
+
+void CoreStatsPanel::hideEvent(QHideEvent*) {
+    m_timer.stop();
+}
+
+void CoreStatsPanel::refresh() {
+    // A read that keeps overlapping the core's write keeps the last figures
+    if (!m_source || !m_source->load(m_stats)) return;
+    for (int row = 0; row < RowCount; ++row) {
+        m_values[row]->setText(rowText(row));
+    }
+}
+
+QString CoreStatsPanel::rowText(int row) const {
+    switch (row) {
+        case PollRate:
+            return QString::number(m_stats.poll_rate_hz, 'f', 0) + " Hz";
+        case FrameTime:
+            return QString("%1 / %2 us").arg(m_stats.frame_time_p50_us).arg(m_stats.frame_time_p99_us);
+        case InputLatency:
+            return m_stats.input_latency_p99_us > 0 ? milliseconds(m_stats.input_latency_p99_us) : QString("-");
+        case OutputRate:
+            return QString::number(m_stats.output_events_per_second, 'f', 0) + " /s";
+        case Coalesced:
+            return QString("%1 / %2").arg(m_stats.coalesced_frames).arg(m_stats.dropped_motions);
+        case ConfigTimes:
+            if (m_stats.config_save_us == 0 && m_stats.config_load_us == 0) return QString("-");
+            return milliseconds(m_stats.config_save_us) + " / " + milliseconds(m_stats.config_load_us + m_stats.mapping_reload_us);
+        default:
+            return QString();
+    }
+}
+
+QString CoreStatsPanel::reportText() const {
+    QString text;
+    for (int row = 0; row < RowCount; ++row) {
+        text += QString(rowLabels[row]) + ": " + rowText(row) + "\n";
+    }
+    text += QString("Frames: %1, output commands: %2\n").arg(m_stats.frames).arg(m_stats.output_commands);
+    return text;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <QFrame>
+#include <QLabel>
+#include <QTimer>
+#include "../core/core_stats.h"
+#include "../core/seqlock.h"
+
+// Compact live view of the core's poll loop: poll rate, frame time, input to
+// output latency, output rate, coalesced and dropped motion, and configuration
+// save and reload times. Reads the stats the core publishes each poll, four
+// times a second while shown.
+class CoreStatsPanel : public QFrame {
+public:
+    explicit CoreStatsPanel(QWidget* parent = nullptr);
+
+    void setSource(const SeqlockSlot<LiveStats>* stats);
+    // The figures as plain text, for pasting into a bug report
+    QString reportText() const;
+
+protected:
+    void showEvent(QShowEvent*) override;
+    void hideEvent(QHideEvent*) override;
+
+private:
+    enum Row { PollRate, FrameTime, InputLatency, OutputRate, Coalesced, ConfigTimes, RowCount };
+    void refresh();
+    QString rowText(int row) const;
+
+    const SeqlockSlot<LiveStats>* m_source = nullptr;
+    LiveStats m_stats;
+    QTimer m_timer;
+    QLabel* m_values[RowCount] = {};
+};
@@ -12,12 +12,12 @@
 #include <QStyleOption>
 #include <QFont>
 
-MainWindow::MainWindow(QWidget* parent)
+MainWindow::MainWindow(CoreWorker::Mode coreMode, QWidget* parent)
     : QMainWindow(parent)
 {
     setStyleSheet("QMainWindow { background: #f9fafb; border-radius: 16px; } ");
     // resize(400, 260);
-    setFixedSize(400,260);
+    setFixedSize(400,290);
     QWidget* central = new QWidget(this);
     setCentralWidget(central);
     central->setStyleSheet("background: #f9fafb; border-radius: 16px;");
@@ -98,15 +98,26 @@ MainWindow::MainWindow(QWidget* parent)
     connect(manageButton, &QPushButton::clicked, this, &MainWindow::onManageControllersClicked);
     mainLayout->addWidget(manageButton, 0, Qt::AlignLeft);
 
+    // Diagnostics panel, hidden until asked for
+    diagnosticsButton = new QPushButton("Show Diagnostics");
+    diagnosticsButton->setStyleSheet("QPushButton { color: #1565c0; background: transparent; border: none; text-align: left; font-size: 15px; padding: 0; } QPushButton:hover { text-decoration: underline; }");
+    diagnosticsButton->setCursor(Qt::PointingHandCursor);
+    connect(diagnosticsButton, &QPushButton::clicked, this, &MainWindow::onDiagnosticsClicked);
+    mainLayout->addWidget(diagnosticsButton, 0, Qt::AlignLeft);
+    statsPanel = new CoreStatsPanel();
+    statsPanel->hide();
+    mainLayout->addWidget(statsPanel);
+
     // --- Worker thread setup ---
     workerThread = new QThread(this);
-    coreWorker = new CoreWorker();
+    coreWorker = new CoreWorker(coreMode);
     coreWorker->moveToThread(workerThread);
     
     connect(workerThread, &QThread::started, coreWorker, &CoreWorker::start);
     connect(workerThread, &QThread::finished, coreWorker, &CoreWorker::stop);
     connect(coreWorker, &CoreWorker::controllerConnected, this, &MainWindow::onControllerConnected);
     connect(coreWorker, &CoreWorker::controllerDisconnected, this, &MainWindow::onControllerDisconnected);
+    statsPanel->setSource(coreWorker->liveStats());
     
     workerThread->start();
     
@@ -170,4 +181,12 @@ void MainWindow::onConfigureControllerClicked() {
     if (!m_currentControllerConnected)
         return;
     ControllerCustomizationWindow::openForController(m_currentControllerGuid, m_currentControllerName, m_currentControllerConnected, coreWorker);
-} 
\ No newline at end of file
+}
+
+void MainWindow::onDiagnosticsClicked() {
+    bool show = !statsPanel->isVisible();
+    statsPanel->setVisible(show);
+    diagnosticsButton->setText(show ? "Hide Diagnostics" : "Show Diagnostics");
+    // The window has a fixed size; grow it to make room for the panel
+    setFixedSize(400, show ? 290 + statsPanel->sizeHint().height() + 18 : 290);
+}
@@ -9,6 +9,7 @@
 #include "../workers/CoreWorker.h"
 #include "ControllerLibraryWindow.h"
 #include "ControllerCustomizationWindow.h"
+#include "CoreStatsPanel.h"
 
 // Custom widget for a perfect green dot
 class DotWidget : public QWidget {
@@ -30,7 +31,7 @@ private:
 class MainWindow : public QMainWindow {
     Q_OBJECT
 public:
-    explicit MainWindow(QWidget* parent = nullptr);
+    explicit MainWindow(CoreWorker::Mode coreMode = CoreWorker::Mode::InProcess, QWidget* parent = nullptr);
     ~MainWindow();
 
 private:
@@ -42,6 +43,8 @@ private:
     QLabel* profileNameLabel;
     QPushButton* configureButton;
     QPushButton* manageButton;
+    QPushButton* diagnosticsButton;
+    CoreStatsPanel* statsPanel;
     QString m_currentControllerGuid;
     QString m_currentControllerName;
     bool m_currentControllerConnected = false;
@@ -52,6 +55,7 @@ private slots:
     void onManageControllersClicked();
     void onControllerLibraryClosed();
     void onConfigureControllerClicked();
+    void onDiagnosticsClicked();
 
 private:
     QThread* workerThread;
@@ -0,0 +1,188 @@
+#include "MappingFieldSchema.h"
+
+namespace {
+const std::vector<FieldChoice> stickActionChoices = {
+    {"None", "none"}, {"Cursor", "cursor"}, {"Scroll", "scroll"}
+};
+const std::vector<FieldChoice> triggerActionChoices = {
+    {"None", "none"}, {"Scroll", "scroll"}, {"Button", "button"}, {"Precision Brake", "brake"}
+};
+// Point and Bezier curves are edited in mappings.json
+const std::vector<FieldChoice> curveChoices = {
+    {"Linear", "linear"}, {"Power", "power"}, {"Points", "points"}, {"Bezier", "bezier"}
+};
+const std::vector<FieldChoice> scrollDirectionChoices = {
+    {"Up", "up"}, {"Down", "down"}
+};
+
+// One action list holding the named action, or an empty disabled action
+std::vector<ButtonAction> actionList(const char* name) {
+    ButtonAction action;
+    if (name) {
+        parseButtonActionName(name, action);
+        action.enabled = true;
+    }
+    return {action};
+}
+}
+
+const std::vector<FieldSpec>& stickFieldSchema() {
+    static const std::vector<FieldSpec> fields = {
+        {"enabled", "Enabled:", FieldControl::Check, 0, 0, 0, {}, nullptr, nullptr},
+        {"action_type", "Action Type:", FieldControl::Choice, 0, 0, 0, stickActionChoices, nullptr, nullptr},
+        {"deadzone", "Deadzone:", FieldControl::Spin, 0, 32767, 100, {}, nullptr, nullptr},
+        {"calibrate", "Auto-Calibrate:", FieldControl::Check, 0, 0, 0, {}, nullptr, nullptr},
+        {"cursor_action.sensitivity", "Sensitivity:", FieldControl::RealSlider, 0.01, 10.0, 0.01, {}, "action_type", "cursor"},
+        {"cursor_action.boosted_sensitivity", "Boosted Sensitivity:", FieldControl::RealSlider, 0.01, 10.0, 0.01, {}, "action_type", "cursor"},
+        {"cursor_action.smoothing", "Smoothing:", FieldControl::RealSlider, 0.0, 1.0, 0.01, {}, "action_type", "cursor"},
+        {"cursor_action.acceleration.curve", "Acceleration:", FieldControl::Choice, 0, 0, 0, curveChoices, "action_type", "cursor"},
+        {"cursor_action.acceleration.exponent", "Exponent:", FieldControl::Real, 0.1, 5.0, 0.1, {}, "cursor_action.acceleration.curve", "power"},
+        {"cursor_action.acceleration", "", FieldControl::CurvePreview, 0, 0, 0, {}, "action_type", "cursor"},
+        {"scroll_action.vertical_sensitivity", "Vertical Sensitivity:", FieldControl::RealSlider, 0.01, 10.0, 0.01, {}, "action_type", "scroll"},
+        {"scroll_action.horizontal_sensitivity", "Horizontal Sensitivity:", FieldControl::RealSlider, 0.01, 10.0, 0.01, {}, "action_type", "scroll"},
+        {"scroll_action.vertical_max_speed", "Vertical Max Speed:", FieldControl::Slider, 1, 50, 1, {}, "action_type", "scroll"},
+        {"scroll_action.horizontal_max_speed", "Horizontal Max Speed:", FieldControl::Slider, 1, 50, 1, {}, "action_type", "scroll"},
+    };
+    return fields;
+}
+
+const std::vector<FieldSpec>& buttonFieldSchema() {
+    static const std::vector<FieldSpec> fields = {
+        {"enabled", "Enabled", FieldControl::Check, 0, 0, 0, {}, nullptr, nullptr},
+        {"actions", "Action", FieldControl::Action, 0, 0, 0, {}, nullptr, nullptr},
+    };
+    return fields;
+}
+
+const std::vector<FieldSpec>& triggerFieldSchema() {
+    static const std::vector<FieldSpec> fields = {
+        {"enabled", "Enabled:", FieldControl::Check, 0, 0, 0, {}, nullptr, nullptr},
+        {"action_type", "Action Type:", FieldControl::Choice, 0, 0, 0, triggerActionChoices, nullptr, nullptr},
+        {"threshold", "Threshold:", FieldControl::Spin, 0, 32767, 100, {}, nullptr, nullptr},
+        // -1 releases slightly below the threshold
+        {"release_threshold", "Release Threshold:", FieldControl::Spin, -1, 32767, 100, {}, nullptr, nullptr},
+        {"scroll_direction", "Direction:", FieldControl::Choice, 0, 0, 0, scrollDirectionChoices, "action_type", "scroll"},
+        {"trigger_scroll_action.vertical_sensitivity", "Vertical Sensitivity:", FieldControl::RealSlider, 0.01, 10.0, 0.01, {}, "action_type", "scroll"},
+        {"trigger_scroll_action.vertical_max_speed", "Vertical Max Speed:", FieldControl::Slider, 1, 100, 1, {}, "action_type", "scroll"},
+        {"button_action.actions", "Button Action:", FieldControl::Action, 0, 0, 0, {}, "action_type", "button"},
+        {"full_pull_threshold", "Full Pull Threshold:", FieldControl::Spin, 0, 32767, 100, {}, "action_type", "button"},
+        {"full_pull_action.actions", "Full Pull Action:", FieldControl::Action, 0, 0, 0, {}, "action_type", "button"},
+        {"brake_strength", "Brake Strength:", FieldControl::RealSlider, 0.0, 1.0, 0.01, {}, "action_type", "brake"},
+    };
+    return fields;
+}
+
+const std::vector<FieldSection>& stickSections() {
+    static const std::vector<FieldSection> sections = {
+        {"Left Stick", "left_stick."},
+        {"Right Stick", "right_stick."},
+    };
+    return sections;
+}
+
+const std::vector<FieldSection>& buttonSections() {
+    static const std::vector<FieldSection> sections = {
+        {"A", "buttons.button_a."},
+        {"B", "buttons.button_b."},
+        {"X", "buttons.button_x."},
+        {"Y", "buttons.button_y."},
+        {"L1", "buttons.left_shoulder."},
+        {"R1", "buttons.right_shoulder."},
+        {"Start", "buttons.start."},
+        {"Select", "buttons.back."},
+        {"D-Up", "buttons.dpad_up."},
+        {"D-Down", "buttons.dpad_down."},
+        {"D-Left", "buttons.dpad_left."},
+        {"D-Right", "buttons.dpad_right."},
+    };
+    return sections;
+}
+
+const std::vector<FieldSection>& triggerSections() {
+    static const std::vector<FieldSection> sections = {
+        {"Left Trigger", "triggers.left_trigger."},
+        {"Right Trigger", "triggers.right_trigger."},
+    };
+    return sections;
+}
+
+const MappingFields& defaultMappingFields() {
+    static const MappingFields fields = {
+        {"left_stick.enabled", true},
+        {"left_stick.action_type", std::string("cursor")},
+        {"left_stick.deadzone", 8000},
+        {"left_stick.calibrate", true},
+        {"left_stick.cursor_action.sensitivity", 0.15},
+        {"left_stick.cursor_action.boosted_sensitivity", 0.6},
+        {"left_stick.cursor_action.smoothing", 0.2},
+        {"left_stick.cursor_action.acceleration.curve", std::string("linear")},
+        {"left_stick.cursor_action.acceleration.exponent", 2.0},
+        {"left_stick.scroll_action.vertical_sensitivity", 1.0},
+        {"left_stick.scroll_action.horizontal_sensitivity", 0.5},
+        {"left_stick.scroll_action.vertical_max_speed", 20},
+        {"left_stick.scroll_action.horizontal_max_speed", 10},
+
+        {"right_stick.enabled", true},
+        {"right_stick.action_type", std::string("scroll")},
+        {"right_stick.deadzone", 8000},
+        {"right_stick.calibrate", true},
+        {"right_stick.cursor_action.sensitivity", 0.4},
+        {"right_stick.cursor_action.boosted_sensitivity", 0.8},
+        {"right_stick.cursor_action.smoothing", 0.2},
+        {"right_stick.cursor_action.acceleration.curve", std::string("linear")},
+        {"right_stick.cursor_action.acceleration.exponent", 2.0},
+        {"right_stick.scroll_action.vertical_sensitivity", 1.0},
+        {"right_stick.scroll_action.horizontal_sensitivity", 0.5},
+        {"right_stick.scroll_action.vertical_max_speed", 20},
+        {"right_stick.scroll_action.horizontal_max_speed", 10},
+
+        {"buttons.button_a.enabled", true},
+        {"buttons.button_a.actions", actionList("mouse_left_click")},
+        {"buttons.button_b.enabled", true},
+        {"buttons.button_b.actions", actionList("keyboard_escape")},
+        {"buttons.button_x.enabled", true},
+        {"buttons.button_x.actions", actionList("keyboard_enter")},
+        {"buttons.button_y.enabled", false},
+        {"buttons.button_y.actions", actionList(nullptr)},
+        {"buttons.left_shoulder.enabled", false},
+        {"buttons.left_shoulder.actions", actionList(nullptr)},
+        {"buttons.right_shoulder.enabled", true},
+        {"buttons.right_shoulder.actions", actionList("mouse_right_click")},
+        {"buttons.start.enabled", true},
+        {"buttons.start.actions", actionList("keyboard_tab")},
+        {"buttons.back.enabled", true},
+        {"buttons.back.actions", actionList("keyboard_alt")},
+        {"buttons.dpad_up.enabled", true},
+        {"buttons.dpad_up.actions", actionList("keyboard_up")},
+        {"buttons.dpad_down.enabled", true},
+        {"buttons.dpad_down.actions", actionList("keyboard_down")},
+        {"buttons.dpad_left.enabled", true},
+        {"buttons.dpad_left.actions", actionList("keyboard_left")},
+        {"buttons.dpad_right.enabled", true},
+        {"buttons.dpad_right.actions", actionList("keyboard_right")},
+
+        {"triggers.left_trigger.enabled", true},
+        {"triggers.left_trigger.action_type", std::string("scroll")},
+        {"triggers.left_trigger.threshold", 8000},
+        {"triggers.left_trigger.release_threshold", -1},
+        {"triggers.left_trigger.scroll_direction", std::string("up")},
+        {"triggers.left_trigger.trigger_scroll_action.vertical_sensitivity", 1.0},
+        {"triggers.left_trigger.trigger_scroll_action.vertical_max_speed", 40},
+        {"triggers.left_trigger.button_action.actions", actionList(nullptr)},
+        {"triggers.left_trigger.full_pull_threshold", 32000},
+        {"triggers.left_trigger.full_pull_action.actions", actionList(nullptr)},
+        {"triggers.left_trigger.brake_strength", 0.75},
+        {"triggers.right_trigger.enabled", true},
+        {"triggers.right_trigger.action_type", std::string("scroll")},
+        {"triggers.right_trigger.threshold", 8000},
+        {"triggers.right_trigger.release_threshold", -1},
+        {"triggers.right_trigger.scroll_direction", std::string("down")},
+        {"triggers.right_trigger.trigger_scroll_action.vertical_sensitivity", 1.0},
+        {"triggers.right_trigger.trigger_scroll_action.vertical_max_speed", 40},
+        {"triggers.right_trigger.button_action.actions", actionList(nullptr)},
+        {"triggers.right_trigger.full_pull_threshold", 32000},
+        {"triggers.right_trigger.full_pull_action.actions", actionList(nullptr)},
+        {"triggers.right_trigger.brake_strength", 0.75},
+    };
+    return fields;
+}
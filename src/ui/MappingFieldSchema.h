@@ -0,0 +1,58 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "../core/mapping_fields.h"
+
+// Describes the mapping settings the customization window edits. Each entry
+// names a field by its path (see mapping_fields.h) relative to a section such
+// as "left_stick." or "buttons.button_a.", so the window builds its controls
+// and reads and writes values from this table instead of per-field code.
+
+// Control a field is edited with
+enum class FieldControl {
+    Check,        // Check box (bool)
+    Choice,       // Combo box over named values (string)
+    Spin,         // Spin box (int)
+    Slider,       // Slider with a spin box (int)
+    RealSlider,   // Slider with a spin box in steps of 0.01 (double)
+    Real,         // Spin box (double)
+    Action,       // Action type and action combo boxes for the first action of a list
+    CurvePreview  // Read-only plot of the acceleration curve at path
+};
+
+struct FieldChoice {
+    const char* label;
+    const char* value;
+};
+
+struct FieldSpec {
+    const char* path;
+    const char* label;
+    FieldControl control;
+    double minimum;
+    double maximum;
+    double step;
+    std::vector<FieldChoice> choices;
+    // The field is shown only while the field at whenPath (same section) holds
+    // whenValue, and that field is itself shown
+    const char* whenPath;
+    const char* whenValue;
+};
+
+// A group of fields edited together, e.g. one stick
+struct FieldSection {
+    const char* title;
+    std::string prefix;
+};
+
+const std::vector<FieldSpec>& stickFieldSchema();
+const std::vector<FieldSpec>& buttonFieldSchema();
+const std::vector<FieldSpec>& triggerFieldSchema();
+
+const std::vector<FieldSection>& stickSections();
+const std::vector<FieldSection>& buttonSections();
+const std::vector<FieldSection>& triggerSections();
+
+// Values "Reset to Default" applies, by full path. Fields not listed keep their
+// current value.
+const MappingFields& defaultMappingFields();
@@ -1,10 +1,18 @@
 #include "CoreWorker.h"
+#include "../core/mapping_json.h"
 #include <QDebug>
 #include <QThread>
 
-CoreWorker::CoreWorker(QObject* parent)
-    : QObject(parent), m_core(std::make_unique<JoyCursorCore>()), m_timer(nullptr) {
-    
+CoreWorker::CoreWorker(Mode mode, QObject* parent)
+    : QObject(parent), m_timer(nullptr) {
+    if (mode == Mode::Attached) {
+        // Mapped up front so live displays get a stable pointer; it stays
+        // valid while the core process restarts
+        m_shared = SharedStateMapping::open();
+        return;
+    }
+    m_core = std::make_unique<JoyCursorCore>();
+
     // Set up core callbacks
     m_core->setControllerConnectedCallback(
         [this](const std::string& guid, const std::string& name) {
@@ -51,6 +59,25 @@ CoreWorker::~CoreWorker() {
 }
 
 void CoreWorker::start() {
+    if (isAttached()) {
+        if (!m_socket) {
+            m_socket = new QLocalSocket(this);
+            connect(m_socket, &QLocalSocket::connected, this, &CoreWorker::onSocketConnected);
+            connect(m_socket, &QLocalSocket::disconnected, this, &CoreWorker::onSocketDisconnected);
+            connect(m_socket, &QLocalSocket::readyRead, this, &CoreWorker::onSocketReadyRead);
+            connect(m_socket, &QLocalSocket::errorOccurred, this, [this]() {
+                if (m_socket->state() == QLocalSocket::UnconnectedState) {
+                    m_reconnectTimer->start();
+                }
+            });
+            m_reconnectTimer = new QTimer(this);
+            m_reconnectTimer->setSingleShot(true);
+            m_reconnectTimer->setInterval(1000);
+            connect(m_reconnectTimer, &QTimer::timeout, this, &CoreWorker::connectToCore);
+        }
+        connectToCore();
+        return;
+    }
     if (m_timer && !m_timer->isActive()) {
         m_timer->start(5); // Poll every 5ms
         qDebug() << "CoreWorker started";
@@ -58,6 +85,12 @@ void CoreWorker::start() {
 }
 
 void CoreWorker::stop() {
+    if (m_reconnectTimer) {
+        m_reconnectTimer->stop();
+    }
+    if (m_socket) {
+        m_socket->abort();
+    }
     if (m_timer && m_timer->isActive()) {
         m_timer->stop();
         qDebug() << "CoreWorker stopped";
@@ -67,6 +100,175 @@ void CoreWorker::stop() {
 void CoreWorker::poll() {
     if (m_core) {
         m_core->pollEvents();
+        // Idle controllers park the worker until input arrives instead of
+        // polling every 5 ms; the wait is short so queued calls still run promptly.
+        // Input that ends the wait is handled now, not on the next timer tick.
+        if (m_core->waitForInput(50)) {
+            m_core->pollEvents();
+        }
+    }
+}
+
+const InputSnapshotTable* CoreWorker::inputSnapshots() const {
+    if (m_core) {
+        return m_core->inputSnapshots();
+    }
+    return m_shared ? &m_shared->state()->input : nullptr;
+}
+
+const SeqlockSlot<LiveStats>* CoreWorker::liveStats() const {
+    if (m_core) {
+        return m_core->liveStats();
+    }
+    return m_shared ? &m_shared->state()->stats : nullptr;
+}
+
+void CoreWorker::post(CoreCommand command) {
+    if (m_core) {
+        m_core->post(std::move(command));
+    }
+}
+
+void CoreWorker::requestControllers(QObject* receiver, std::function<void(const ControllerLists&)> handler) {
+    if (m_core) {
+        request(receiver, [](JoyCursorCore& core) {
+            return ControllerLists(core.getKnownControllers(), core.getConnectedControllers());
+        }, handler);
+        return;
+    }
+    QPointer<QObject> guard(receiver);
+    sendRequest({{"cmd", "controllers"}}, [guard, handler](const nlohmann::json& reply) {
+        ControllerLists lists;
+        for (const auto& [guid, name] : reply.value("known", nlohmann::json::object()).items()) {
+            if (name.is_string()) lists.first[guid] = name.get<std::string>();
+        }
+        for (const auto& [guid, name] : reply.value("connected", nlohmann::json::object()).items()) {
+            if (name.is_string()) lists.second[guid] = name.get<std::string>();
+        }
+        deliver(guard, handler, lists);
+    });
+}
+
+void CoreWorker::requestMappingProfile(QObject* receiver, const std::string& guid, const std::vector<std::string>& buttons,
+                                       const std::vector<std::string>& triggers, std::function<void(const MappingProfile&)> handler) {
+    if (m_core) {
+        request(receiver, [guid, buttons, triggers](JoyCursorCore& core) {
+            return core.getMappingProfile(guid, buttons, triggers);
+        }, handler);
+        return;
+    }
+    QPointer<QObject> guard(receiver);
+    sendRequest({{"cmd", "get_mappings"}, {"guid", guid}, {"buttons", buttons}, {"triggers", triggers}},
+        [guard, handler](const nlohmann::json& reply) {
+            MappingFields fields;
+            if (!mappingFieldsFromJson(reply.value("fields", nlohmann::json()), fields)) {
+                qWarning() << "Core sent no mappings";
+                return;
+            }
+            MappingProfile profile;
+            for (const auto& [path, value] : fields) {
+                applyMappingField(profile, path, value);
+            }
+            deliver(guard, handler, profile);
+        });
+}
+
+void CoreWorker::saveMappingProfile(QObject* receiver, const std::string& guid, const MappingProfile& profile,
+                                    std::function<void(bool saved)> handler) {
+    if (m_core) {
+        request(receiver, [guid, profile](JoyCursorCore& core) {
+            return core.applyMappingProfile(guid, profile);
+        }, handler);
+        return;
+    }
+    QPointer<QObject> guard(receiver);
+    sendRequest({{"cmd", "save_mappings"}, {"guid", guid}, {"fields", mappingFieldsToJson(flattenMappingProfile(profile))}},
+        [guard, handler](const nlohmann::json& reply) {
+            deliver(guard, handler, reply.value("ok", false));
+        });
+}
+
+void CoreWorker::sendRequest(nlohmann::json request, std::function<void(const nlohmann::json&)> onReply) {
+    // The socket belongs to the worker thread
+    QMetaObject::invokeMethod(this, [this, request, onReply]() mutable {
+        if (!m_socket || m_socket->state() != QLocalSocket::ConnectedState) {
+            qWarning() << "Core is not attached, dropping request" << QString::fromStdString(request.value("cmd", ""));
+            return;
+        }
+        int id = ++m_nextRequestId;
+        request["id"] = id;
+        if (onReply) {
+            m_pending[id] = std::move(onReply);
+        }
+        m_socket->write(QByteArray::fromStdString(request.dump() + "\n"));
+    }, Qt::QueuedConnection);
+}
+
+void CoreWorker::connectToCore() {
+    if (m_socket && m_socket->state() == QLocalSocket::UnconnectedState) {
+        m_socket->connectToServer(QString::fromStdString(coreSocketPath()));
+    }
+}
+
+void CoreWorker::onSocketConnected() {
+    qDebug() << "Attached to core at" << QString::fromStdString(coreSocketPath());
+    if (m_shared && !m_shared->isCompatible()) {
+        qWarning() << "Core shared state has a different layout; live displays stay empty";
+    }
+    // Controllers already connected to the core produce no events, so report them now
+    sendRequest({{"cmd", "controllers"}}, [this](const nlohmann::json& reply) {
+        for (const auto& [guid, name] : reply.value("connected", nlohmann::json::object()).items()) {
+            if (name.is_string() && m_attachedConnected.insert(guid).second) {
+                onControllerConnected(guid, name.get<std::string>());
+            }
+        }
+    });
+}
+
+void CoreWorker::onSocketDisconnected() {
+    qDebug() << "Detached from core, retrying";
+    m_pending.clear();
+    // The core is gone, and with it its controllers
+    std::set<std::string> connected;
+    connected.swap(m_attachedConnected);
+    for (const std::string& guid : connected) {
+        onControllerDisconnected(guid);
+    }
+    m_reconnectTimer->start();
+}
+
+void CoreWorker::onSocketReadyRead() {
+    while (m_socket->canReadLine()) {
+        QByteArray line = m_socket->readLine();
+        nlohmann::json message = nlohmann::json::parse(line.constData(), line.constData() + line.size(), nullptr, false);
+        if (!message.is_object()) {
+            qWarning() << "Malformed message from core";
+            continue;
+        }
+        // A core of another version may send fields of unexpected types
+        try {
+            std::string event = message.value("event", "");
+            std::string guid = message.value("guid", "");
+            if (event == "connected") {
+                m_attachedConnected.insert(guid);
+                onControllerConnected(guid, message.value("name", ""));
+            } else if (event == "disconnected") {
+                m_attachedConnected.erase(guid);
+                onControllerDisconnected(guid);
+            } else if (message.contains("id")) {
+                auto pending = m_pending.find(message.value("id", 0));
+                if (pending == m_pending.end()) continue;
+                auto onReply = std::move(pending->second);
+                m_pending.erase(pending);
+                if (message.contains("error")) {
+                    qWarning() << "Core request failed:" << QString::fromStdString(message.value("error", ""));
+                    continue;
+                }
+                onReply(message);
+            }
+        } catch (const nlohmann::json::exception& e) {
+            qWarning() << "Unexpected message from core:" << e.what();
+        }
     }
 }
 
@@ -1,20 +1,73 @@
 #pragma once
 
+#include <QCoreApplication>
+#include <QLocalSocket>
 #include <QObject>
+#include <QPointer>
 #include <QTimer>
+#include <functional>
+#include <map>
 #include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
 #include "../core/joycursor_core.h"
+#include "../core/shared_state.h"
+
+// Known and connected controllers, each guid -> name
+using ControllerLists = std::pair<std::map<std::string, std::string>, std::map<std::string, std::string>>;
 
 class CoreWorker : public QObject {
     Q_OBJECT
 
 public:
-    explicit CoreWorker(QObject* parent = nullptr);
+    enum class Mode {
+        InProcess, // Runs the core on the worker thread
+        Attached   // Talks to a core running headless in another process (JoyCursorCore --serve)
+    };
+
+    explicit CoreWorker(Mode mode = Mode::InProcess, QObject* parent = nullptr);
     ~CoreWorker();
 
-    // Core access
-    JoyCursorCore* getCore() { return m_core.get(); }
-    const JoyCursorCore* getCore() const { return m_core.get(); }
+    // The core belongs to the worker thread, or to the core process when
+    // attached. Other threads reach it only through commands, which run
+    // between polls, so the poll loop never has to pause.
+
+    bool isAttached() const { return !m_core; }
+
+    // Controller input for live displays. Safe to read from any thread.
+    const InputSnapshotTable* inputSnapshots() const;
+
+    // Poll loop figures for diagnostics. Safe to read from any thread.
+    const SeqlockSlot<LiveStats>* liveStats() const;
+
+    // Requests that work in both modes. Safe to call from any thread; handlers
+    // run on the GUI thread and are dropped if receiver is destroyed first or
+    // the attached core goes away before replying.
+    void requestControllers(QObject* receiver, std::function<void(const ControllerLists&)> handler);
+    void requestMappingProfile(QObject* receiver, const std::string& guid, const std::vector<std::string>& buttons,
+                               const std::vector<std::string>& triggers, std::function<void(const MappingProfile&)> handler);
+    // Stores the profile's sticks, buttons and triggers and reloads the
+    // configuration. handler learns whether mappings.json was saved.
+    void saveMappingProfile(QObject* receiver, const std::string& guid, const MappingProfile& profile,
+                            std::function<void(bool saved)> handler);
+
+    // Runs a command on the worker thread. Safe to call from any thread.
+    // In-process core only; ignored when attached.
+    void post(CoreCommand command);
+
+    // Runs query on the worker thread and passes its result to handler on the
+    // GUI thread. The handler is dropped if receiver is destroyed first.
+    // In-process core only; ignored when attached.
+    template <typename Query, typename Handler>
+    void request(QObject* receiver, Query query, Handler handler) {
+        QPointer<QObject> guard(receiver);
+        post([guard, query, handler](JoyCursorCore& core) {
+            deliver(guard, handler, query(core));
+        });
+    }
 
 signals:
     void controllerConnected(const QString& guid, const QString& name);
@@ -30,8 +83,32 @@ public slots:
     void poll();
 
 private:
-    std::unique_ptr<JoyCursorCore> m_core;
+    template <typename Handler, typename Result>
+    static void deliver(QPointer<QObject> guard, Handler handler, Result result) {
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [guard, handler, result]() {
+            if (guard) {
+                handler(result);
+            }
+        }, Qt::QueuedConnection);
+    }
+
+    // Attached mode: sends a request line to the core; onReply runs on the worker thread
+    void sendRequest(nlohmann::json request, std::function<void(const nlohmann::json&)> onReply);
+    void connectToCore();
+    void onSocketConnected();
+    void onSocketDisconnected();
+    void onSocketReadyRead();
+
+    std::unique_ptr<JoyCursorCore> m_core;     // Null when attached
     QTimer* m_timer;
+
+    // Attached mode; the socket and timer live on the worker thread
+    std::unique_ptr<SharedStateMapping> m_shared;
+    QLocalSocket* m_socket = nullptr;
+    QTimer* m_reconnectTimer = nullptr;
+    int m_nextRequestId = 0;
+    std::map<int, std::function<void(const nlohmann::json&)>> m_pending;
+    std::set<std::string> m_attachedConnected; // Controllers reported connected by the core
     
     // Core event handlers
     void onControllerConnected(const std::string& guid, const std::string& name);
@@ -0,0 +1,79 @@
+// acceleration_curve_tests.cpp
+// The compiled acceleration table against the curve it samples: exact at
+// the endpoints and within one table step of the closed form in between.
+
+#include "test_support.h"
+#include "core/acceleration_curve.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace {
+
+using CurveFunction = std::function<double(double)>;
+
+// Deflections checked on each curve, on and between table samples
+const double kDeflections[] = {0.0, 0.01, 0.1, 0.25, 1.0 / 3.0, 0.5, 0.62, 0.75, 0.9, 0.999, 1.0};
+
+double cubicBezier(double p1, double p2, double t) {
+    double u = 1.0 - t;
+    return 3.0 * u * u * t * p1 + 3.0 * u * t * t * p2 + t * t * t;
+}
+
+// The Bezier curve's y at x, with t solved to double precision
+double bezierAt(const AccelerationCurve& curve, double x) {
+    double low = 0.0;
+    double high = 1.0;
+    for (int i = 0; i < 60; ++i) {
+        double mid = (low + high) / 2.0;
+        (cubicBezier(curve.control1_x, curve.control2_x, mid) < x ? low : high) = mid;
+    }
+    return cubicBezier(curve.control1_y, curve.control2_y, (low + high) / 2.0);
+}
+
+// Checks the table against exact at every deflection. Between samples the
+// table interpolates linearly, so it may differ from the curve by at most
+// how much the curve changes over the step holding the deflection.
+void checkLut(const AccelerationCurve& curve, const CurveFunction& exact) {
+    AccelerationLut lut = compileAccelerationCurve(curve);
+    constexpr double kStep = 1.0 / (kAccelerationLutSize - 1);
+    CHECK(std::abs(lut.evaluate(0.0f) - exact(0.0)) < 1e-6);
+    CHECK(std::abs(lut.evaluate(1.0f) - exact(1.0)) < 1e-6);
+    for (double x : kDeflections) {
+        int index = std::min(static_cast<int>(x / kStep), kAccelerationLutSize - 2);
+        double step_change = std::abs(exact((index + 1) * kStep) - exact(index * kStep));
+        double error = std::abs(lut.evaluate(static_cast<float>(x)) - exact(x));
+        CHECK(error <= step_change + 1e-5);
+    }
+}
+
+} // namespace
+
+JOYCURSOR_TEST(acceleration_lut_matches_curve) {
+    AccelerationCurve curve;
+    checkLut(curve, [](double x) { return x; });
+
+    curve.type = AccelerationCurveType::POWER;
+    for (double exponent : {0.5, 2.0, 3.5}) {
+        curve.exponent = static_cast<float>(exponent);
+        checkLut(curve, [exponent](double x) { return std::pow(x, exponent); });
+    }
+
+    // Ends flat after the last point
+    curve.type = AccelerationCurveType::POINTS;
+    curve.points = {{0.2f, 0.05f}, {0.6f, 0.3f}, {0.9f, 0.8f}};
+    checkLut(curve, [](double x) {
+        if (x <= 0.2) return x / 0.2 * 0.05;
+        if (x <= 0.6) return 0.05 + (x - 0.2) / 0.4 * 0.25;
+        if (x <= 0.9) return 0.3 + (x - 0.6) / 0.3 * 0.5;
+        return 0.8;
+    });
+
+    curve.type = AccelerationCurveType::BEZIER;
+    checkLut(curve, [&curve](double x) { return bezierAt(curve, x); });
+    curve.control1_x = 0.1f;
+    curve.control1_y = 0.6f;
+    curve.control2_x = 0.3f;
+    curve.control2_y = 1.0f;
+    checkLut(curve, [&curve](double x) { return bezierAt(curve, x); });
+}
@@ -0,0 +1,175 @@
+// calibration_tests.cpp
+// Stick rest calibration on a noisy virtual stick: the learned rest position
+// follows a slow drift and ignores outliers, and it is saved to
+// calibration.json and used by the next run from its first poll.
+
+#include "test_support.h"
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+
+constexpr uint64_t kFrameMs = 10;
+constexpr int kFramesPerSecond = 1000 / kFrameMs;
+constexpr int kDeadzone = 2000;
+// How close the learned rest position must be to the true one
+constexpr int kRestTolerance = 150;
+
+nlohmann::json calibratedProfile() {
+    return {{"left_stick", {
+        {"enabled", true},
+        {"action_type", "cursor"},
+        {"deadzone", kDeadzone},
+        {"calibrate", true},
+        {"cursor_action", {{"sensitivity", 1.0}, {"smoothing", 1.0},
+                           {"acceleration", {{"curve", "linear"}, {"ramp_time", 0.0}}}}}
+    }}};
+}
+
+void writeCalibrationFiles() {
+    writeJsonFile("settings.json", testSettings());
+    writeMappings(calibratedProfile());
+}
+
+// A left stick resting at (rest_x, rest_y) with sensor noise of up to
+// +-kNoise, so it reports a new value every poll as a worn stick does
+class RestingStick {
+public:
+    static constexpr int kNoise = 300;
+
+    RestingStick(CoreDriver& core, VirtualPad& pad) : m_core(core), m_pad(pad) {}
+
+    void rest(double x, double y, int frames, double drift_x = 0.0, double drift_y = 0.0) {
+        for (int frame = 0; frame < frames; ++frame) {
+            x += drift_x;
+            y += drift_y;
+            set(static_cast<int>(x) + noise(), static_cast<int>(y) + noise());
+            m_core.frame(kFrameMs);
+        }
+    }
+
+    void set(int x, int y) {
+        m_pad.setAxis(SDL_GAMEPAD_AXIS_LEFTX, static_cast<Sint16>(x));
+        m_pad.setAxis(SDL_GAMEPAD_AXIS_LEFTY, static_cast<Sint16>(y));
+    }
+
+private:
+    int noise() {
+        m_step = (m_step * 1103515245u + 12345u) & 0x7fffffffu;
+        return static_cast<int>(m_step % (2 * kNoise + 1)) - kNoise;
+    }
+
+    CoreDriver& m_core;
+    VirtualPad& m_pad;
+    uint32_t m_step = 1;
+};
+
+// The left stick's rest position as the core publishes it
+void publishedRest(CoreDriver& core, int& x, int& y) {
+    x = y = 0;
+    for (const auto& slot : core.manager().inputSnapshots().slots) {
+        InputSnapshot snapshot;
+        if (slot.load(snapshot) && snapshot.guid[0] != '\0') {
+            x = snapshot.stick_rest[0];
+            y = snapshot.stick_rest[1];
+            return;
+        }
+    }
+}
+
+bool restNear(CoreDriver& core, int x, int y) {
+    int rest_x, rest_y;
+    publishedRest(core, rest_x, rest_y);
+    return std::abs(rest_x - x) <= kRestTolerance && std::abs(rest_y - y) <= kRestTolerance;
+}
+
+int cursorMotion(const CoreDriver& core) {
+    return std::abs(core.sumA(OutputCommandType::MOUSE_MOVE)) + std::abs(core.sumB(OutputCommandType::MOUSE_MOVE));
+}
+
+} // namespace
+
+JOYCURSOR_TEST(stick_calibration_drift) {
+    ScratchDirectory scratch;
+    writeCalibrationFiles();
+    CoreDriver core;
+    VirtualPad pad;
+    RestingStick stick(core, pad);
+    core.frame(kFrameMs);
+
+    // Off center by more than the deadzone, the resting stick moves the
+    // cursor until its rest position is learned
+    stick.rest(3000, -2500, 10 * kFramesPerSecond);
+    CHECK(restNear(core, 3000, -2500));
+    core.clearOutput();
+    stick.rest(3000, -2500, kFramesPerSecond);
+    CHECK_EQ(cursorMotion(core), 0);
+
+    // A slow drift of 60 units per second over 10 seconds is followed
+    stick.rest(3000, -2500, 10 * kFramesPerSecond, 0.6, 0.4);
+    stick.rest(3600, -2100, 3 * kFramesPerSecond);
+    CHECK(restNear(core, 3600, -2100));
+
+    // A spike past the still band is not sampled, and sampling waits for the
+    // stick to settle again before it resumes
+    int before_x, before_y;
+    publishedRest(core, before_x, before_y);
+    stick.set(3600 + 8000, -2100 - 8000);
+    core.frame(kFrameMs);
+    stick.rest(3600, -2100, kFramesPerSecond * 4 / 10);
+    int after_x, after_y;
+    publishedRest(core, after_x, after_y);
+    CHECK_EQ(after_x, before_x);
+    CHECK_EQ(after_y, before_y);
+
+    // Knocks within the band move it by at most a small step each, which
+    // the resting samples around them undo
+    for (int i = 0; i < 40; ++i) {
+        stick.rest(3600, -2100, 4);
+        stick.set(3600 + 900, -2100 - 900);
+        core.frame(kFrameMs);
+    }
+    stick.rest(3600, -2100, kFramesPerSecond);
+    CHECK(restNear(core, 3600, -2100));
+
+    // A real push is still a push
+    core.clearOutput();
+    stick.set(32767, -2100);
+    core.frames(10, kFrameMs);
+    CHECK(core.sumA(OutputCommandType::MOUSE_MOVE) > 0);
+}
+
+JOYCURSOR_TEST(stick_calibration_persists) {
+    ScratchDirectory scratch;
+    writeCalibrationFiles();
+    {
+        CoreDriver core;
+        VirtualPad pad;
+        RestingStick stick(core, pad);
+        core.frame(kFrameMs);
+        stick.rest(-2800, 2400, 10 * kFramesPerSecond);
+        CHECK(restNear(core, -2800, 2400));
+        // Shutting down stores the calibration; the config writer finishes
+        // the write before the core is gone
+    }
+
+    std::ifstream in("calibration.json");
+    CHECK(in.good());
+    nlohmann::json saved = nlohmann::json::parse(in, nullptr, false);
+    CHECK(saved.is_object() && saved.size() == 1);
+    const nlohmann::json& left = saved.begin().value()["left_stick"];
+    CHECK(std::abs(left.value("offset_x", 0.0) + 2800) <= kRestTolerance);
+    CHECK(std::abs(left.value("offset_y", 0.0) - 2400) <= kRestTolerance);
+    CHECK(left.value("samples", 0) > 0);
+
+    // The next run starts calibrated: the same stick moves nothing from the first poll
+    CoreDriver core;
+    VirtualPad pad;
+    RestingStick stick(core, pad);
+    stick.set(-2800, 2400);
+    core.frame(kFrameMs);
+    CHECK(restNear(core, -2800, 2400));
+    core.clearOutput();
+    stick.rest(-2800, 2400, kFramesPerSecond / 4);
+    CHECK_EQ(cursorMotion(core), 0);
+}
@@ -0,0 +1,115 @@
+// clock_tests.cpp
+// Frame timing on the simulated clock: cursor motion scales with the time
+// step, a stall restarts motion from rest, and the poll after an idle wait
+// steps by an ordinary frame.
+
+#include "test_support.h"
+#include <cstdlib>
+
+namespace {
+
+// Full tilt moves 100 * sensitivity * 60 pixels per second
+constexpr int kFullTiltPixelsPerSecond = 6000;
+
+// Left stick cursor with a linear response and no ramp, so speed depends
+// only on deflection; smoothing 1 follows the stick without lag
+nlohmann::json cursorProfile(double smoothing) {
+    return {{"left_stick", {
+        {"enabled", true},
+        {"action_type", "cursor"},
+        {"deadzone", 8000},
+        {"calibrate", false},
+        {"cursor_action", {{"sensitivity", 1.0}, {"boosted_sensitivity", 1.0}, {"smoothing", smoothing},
+                           {"acceleration", {{"curve", "linear"}, {"ramp_time", 0.0}}}}}
+    }}};
+}
+
+void writeCursorFiles(double smoothing) {
+    writeJsonFile("settings.json", testSettings());
+    writeMappings(cursorProfile(smoothing));
+}
+
+// Horizontal cursor motion sent by the next frame
+int frameMotion(CoreDriver& core, uint64_t ms) {
+    core.clearOutput();
+    core.frame(ms);
+    return core.sumA(OutputCommandType::MOUSE_MOVE);
+}
+
+// Pixels moved in total_ms of full tilt polled every step_ms
+int heldMotion(uint64_t step_ms, uint64_t total_ms) {
+    ScratchDirectory scratch;
+    writeCursorFiles(1.0);
+    CoreDriver core;
+    VirtualPad pad;
+    core.frame(step_ms);
+    pad.setAxis(SDL_GAMEPAD_AXIS_LEFTX, 32767);
+    core.clearOutput();
+    core.frames(static_cast<int>(total_ms / step_ms), step_ms);
+    return core.sumA(OutputCommandType::MOUSE_MOVE);
+}
+
+} // namespace
+
+JOYCURSOR_TEST(frame_step_scaling) {
+    // The same stretch of time covers the same distance at any poll rate
+    constexpr uint64_t kTotalMs = 400;
+    const int expected = kFullTiltPixelsPerSecond * kTotalMs / 1000;
+    for (uint64_t step_ms : {1, 2, 5, 10, 20, 50}) {
+        int moved = heldMotion(step_ms, kTotalMs);
+        CHECK(std::abs(moved - expected) <= 2);
+    }
+}
+
+JOYCURSOR_TEST(frame_gap_resets_motion) {
+    ScratchDirectory scratch;
+    writeCursorFiles(0.2);
+    CoreDriver core;
+    VirtualPad pad;
+    core.frame(10);
+    pad.setAxis(SDL_GAMEPAD_AXIS_LEFTX, 32767);
+    int first_frame = frameMotion(core, 10);
+    int second_frame = frameMotion(core, 10);
+    CHECK(first_frame > 0);
+    CHECK(second_frame > first_frame);
+    core.frames(30, 10);
+
+    // A long frame under the limit is integrated at the smoothed speed
+    int long_frame = frameMotion(core, kMaxFrameGapNs / kNsPerMs);
+    CHECK(long_frame > kFullTiltPixelsPerSecond / 10 * 8 / 10);
+
+    // A stall moves nothing and smoothing starts over from rest. The stalled
+    // frame stands in for the first frame of the press, so the next one moves
+    // like the second frame did.
+    CHECK_EQ(frameMotion(core, kMaxFrameGapNs / kNsPerMs + 400), 0);
+    int after_gap = frameMotion(core, 10);
+    CHECK(std::abs(after_gap - second_frame) <= 1);
+    CHECK(after_gap < long_frame / 10);
+}
+
+JOYCURSOR_TEST(idle_resume_step) {
+    ScratchDirectory scratch;
+    writeCursorFiles(1.0);
+    CoreDriver core;
+    VirtualPad pad;
+    core.frames(20, 10);
+
+    // Everything is at rest, so the loop blocks; a zero timeout returns at once
+    // and reports that no input arrived
+    uint64_t waits = core.manager().getStats().idle_waits;
+    CHECK(!core.manager().waitForInput(0));
+    CHECK_EQ(core.manager().getStats().idle_waits, waits + 1);
+    // A pending event ends the wait and asks for a poll now
+    core.manager().wake();
+    CHECK(core.manager().waitForInput(0));
+
+    // Input ends a long wait; its poll moves the cursor by one ordinary 10 ms frame
+    core.clock().advance(5 * kNsPerSecond);
+    pad.setAxis(SDL_GAMEPAD_AXIS_LEFTX, 32767);
+    int resumed = frameMotion(core, 0);
+    CHECK(std::abs(resumed - kFullTiltPixelsPerSecond / 100) <= 1);
+
+    // Polls after that step by the time that actually passed
+    int next = frameMotion(core, 5);
+    CHECK(std::abs(next - kFullTiltPixelsPerSecond / 200) <= 1);
+}
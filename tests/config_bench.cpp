@@ -0,0 +1,142 @@
+// config_bench.cpp
+// Scalability of mappings.json and controllers.json handling: loading,
+// first and repeated mapping lookups and saving, for files from 10 to 10,000
+// controllers plus deeply nested, malformed and truncated files.
+//
+//   JoyCursorTests --bench config [guid counts...]
+
+#include "test_support.h"
+#include "core/config.h"
+#include "core/mapping_io.h"
+#include "core/mapping_manager.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+// A profile holding one unknown field nested depth levels below the profile
+void writeDeepFile(int depth) {
+    nlohmann::json nested = 1;
+    for (int i = 0; i < depth; ++i) {
+        nested = {{"level" + std::to_string(i), nested}};
+    }
+    nlohmann::json profile = fullDefaultProfile();
+    profile["experimental"] = nested;
+    writeJsonFile("mappings.json", {{"mappings", {{"default", profile}}}});
+    writeJsonFile("controllers.json", nlohmann::json::object());
+}
+
+double elapsedMs(uint64_t start_ns) {
+    return (steadyNowNs() - start_ns) / 1e6;
+}
+
+// Times each stage of using the files in the working directory and prints one row
+void measure(const std::string& label, int guid_count) {
+    long rss_before = peakRssKb();
+    uint64_t start = steadyNowNs();
+    Config config;
+    double load_ms = elapsedMs(start);
+
+    start = steadyNowNs();
+    MappingManager mappings(config);
+    double cache_ms = elapsedMs(start);
+
+    int lookups = std::max(guid_count, 1);
+    start = steadyNowNs();
+    for (int i = 0; i < lookups; ++i) {
+        mappings.getButtonMapping(testGuid(i), kProfileButtons[i % kProfileButtonCount]);
+    }
+    double cold_us = elapsedMs(start) * 1000.0 / lookups;
+
+    start = steadyNowNs();
+    for (int i = 0; i < lookups; ++i) {
+        mappings.getButtonMapping(testGuid(i), kProfileButtons[i % kProfileButtonCount]);
+    }
+    double warm_us = elapsedMs(start) * 1000.0 / lookups;
+
+    // Edit one profile so the save has something to write
+    config.storeProfile(testGuid(0), *config.findProfile(testGuid(0)));
+    start = steadyNowNs();
+    config.saveMappings();
+    double save_ms = elapsedMs(start);
+
+    std::error_code ec;
+    uintmax_t file_size = std::filesystem::file_size("mappings.json", ec);
+    std::printf("%-18s %8.2f %9.2f %9.3f %9.3f %8.2f %10ju %9ld %9ld\n", label.c_str(), load_ms, cache_ms,
+                cold_us, warm_us, save_ms, ec ? uintmax_t(0) : file_size, peakRssKb(), peakRssKb() - rss_before);
+    std::fflush(stdout);
+}
+
+// Runs a scenario in a child process so peak RSS covers that scenario alone
+void runIsolated(const std::string& label, int guid_count, void (*prepare)(int), int prepare_arg) {
+    std::fflush(stdout);
+    pid_t child = fork();
+    if (child == 0) {
+        int status = 0;
+        try {
+            ScratchDirectory scratch;
+            writeJsonFile("settings.json", testSettings());
+            prepare(prepare_arg);
+            measure(label, guid_count);
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "%s: %s\n", label.c_str(), e.what());
+            status = 1;
+        }
+        std::fflush(stdout);
+        _exit(status);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        throw std::runtime_error("scenario " + label + " failed");
+    }
+}
+
+void prepareGuids(int guid_count) {
+    writeProfileFiles(guid_count);
+}
+
+void prepareMalformed(int guid_count) {
+    writeProfileFiles(guid_count);
+    // A value cut out of the middle of the file
+    std::ifstream in("mappings.json");
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    size_t colon = text.find(':', text.size() / 2);
+    text.replace(colon, 1, ": ,");
+    writeTextFile("mappings.json", text);
+}
+
+void prepareTruncated(int guid_count) {
+    writeProfileFiles(guid_count);
+    std::filesystem::resize_file("mappings.json", std::filesystem::file_size("mappings.json") / 2);
+    std::filesystem::resize_file("controllers.json", std::filesystem::file_size("controllers.json") / 2);
+}
+
+} // namespace
+
+JOYCURSOR_BENCH(config) {
+    std::vector<int> guid_counts = {10, 100, 1000, 10000};
+    if (!args.empty()) {
+        guid_counts.clear();
+        for (const std::string& arg : args) {
+            guid_counts.push_back(std::stoi(arg));
+        }
+    }
+
+    std::printf("%-18s %8s %9s %9s %9s %8s %10s %9s %9s\n", "file", "load_ms", "cache_ms", "cold_us",
+                "warm_us", "save_ms", "bytes", "peak_kb", "delta_kb");
+    for (int count : guid_counts) {
+        runIsolated(std::to_string(count) + " guids", count, prepareGuids, count);
+    }
+    int largest = guid_counts.back();
+    // The root, "mappings" and the profile take three of the nesting levels
+    runIsolated("deep (at limit)", 1, writeDeepFile, static_cast<int>(kMaxMappingDepth) - 3);
+    runIsolated("deep (over limit)", 1, writeDeepFile, 64);
+    runIsolated("malformed", largest, prepareMalformed, largest);
+    runIsolated("truncated", largest, prepareTruncated, largest);
+}
@@ -0,0 +1,39 @@
+// fuzz_mappings.cpp
+// libFuzzer entry point for the mappings.json reader. Any input must be
+// rejected or read without crashing, and whatever is read must survive a
+// save: writing the profiles and reading them back gives the same document.
+//
+// Built as JoyCursorFuzzMappings with -DJOYCURSOR_FUZZ=ON and clang:
+//   JoyCursorFuzzMappings -max_len=65536 corpus/
+
+#include "core/mapping_io.h"
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size > kMaxMappingsFileSize) {
+        return 0;
+    }
+    std::istringstream in(std::string(reinterpret_cast<const char*>(data), size));
+    std::map<std::string, MappingLayer> profiles;
+    std::string error;
+    if (!readMappingLayers(in, profiles, error)) {
+        return 0;
+    }
+
+    std::ostringstream saved;
+    writeMappingLayers(saved, profiles);
+    std::istringstream saved_in(saved.str());
+    std::map<std::string, MappingLayer> reloaded;
+    if (!readMappingLayers(saved_in, reloaded, error)) {
+        std::abort(); // A saved file must always load
+    }
+    std::ostringstream resaved;
+    writeMappingLayers(resaved, reloaded);
+    if (resaved.str() != saved.str()) {
+        std::abort(); // Loading and saving again must not change the file
+    }
+    return 0;
+}
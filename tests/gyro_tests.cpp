@@ -0,0 +1,163 @@
+// gyro_tests.cpp
+// Gyro cursor fed through a virtual pad's gyro: the drift bias is learned
+// while the pad is still, slow rotation is cut or scaled down, and motion is
+// integrated over sensor time rather than poll time.
+
+#include "test_support.h"
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+constexpr uint64_t kFrameMs = 10;
+constexpr uint64_t kSamplePeriodNs = static_cast<uint64_t>(kNsPerSecond / kVirtualGyroRate);
+constexpr int kSamplesPerFrame = static_cast<int>(kFrameMs * kNsPerMs / kSamplePeriodNs);
+constexpr float kPixelsPerDegree = 8.0f;
+constexpr float kDeadzone = 0.5f;   // Degrees per second
+constexpr float kTightening = 6.0f; // Degrees per second
+
+nlohmann::json gyroProfile(bool calibrate) {
+    return {{"gyro", {{"enabled", true}, {"sensitivity", kPixelsPerDegree}, {"deadzone", kDeadzone},
+                      {"tightening", kTightening}, {"calibrate", calibrate}}}};
+}
+
+struct Motion {
+    int x = 0;
+    int y = 0;
+};
+
+// A pad with a gyro and the sensor clock it reports on
+class GyroRig {
+public:
+    explicit GyroRig(bool calibrate) {
+        writeJsonFile("settings.json", testSettings());
+        writeMappings(gyroProfile(calibrate));
+        m_core = std::make_unique<CoreDriver>();
+        m_pad = std::make_unique<VirtualPad>("JoyCursor Gyro Pad", VirtualPadOptions{true});
+        m_core->frame(kFrameMs);
+        // The first reading only starts the sensor clock
+        m_pad->sendGyro(m_sensorNs, 0.0f, 0.0f);
+        m_core->frame(kFrameMs);
+        m_core->clearOutput();
+    }
+
+    CoreDriver& core() { return *m_core; }
+    VirtualPad& pad() { return *m_pad; }
+    uint64_t& sensorNs() { return m_sensorNs; }
+
+    // Holds a steady rotation for the given sensor time at the gyro's rate,
+    // polling every frame, and returns the cursor motion it caused
+    Motion rotate(float pitch, float yaw, uint64_t duration_ms) {
+        m_core->clearOutput();
+        uint64_t frames = duration_ms / kFrameMs;
+        for (uint64_t frame = 0; frame < frames; ++frame) {
+            for (int i = 0; i < kSamplesPerFrame; ++i) {
+                m_sensorNs += kSamplePeriodNs;
+                m_pad->sendGyro(m_sensorNs, pitch, yaw);
+            }
+            m_core->frame(kFrameMs);
+        }
+        return output();
+    }
+
+    Motion output() const {
+        return {m_core->sumA(OutputCommandType::MOUSE_MOVE), m_core->sumB(OutputCommandType::MOUSE_MOVE)};
+    }
+
+private:
+    std::unique_ptr<CoreDriver> m_core;
+    std::unique_ptr<VirtualPad> m_pad;
+    uint64_t m_sensorNs = kNsPerSecond;
+};
+
+} // namespace
+
+JOYCURSOR_TEST(gyro_stillness_calibration) {
+    // A resting gyro that reads 2 degrees per second of yaw: under the
+    // stillness threshold, but over the deadzone until the bias is learned
+    constexpr float kDrift = 2.0f;
+    ScratchDirectory scratch;
+    {
+        GyroRig rig(false);
+        CHECK(rig.rotate(0.0f, kDrift, 1000).x < 0);
+        CHECK(rig.rotate(0.0f, kDrift, 1000).x < 0);
+    }
+
+    GyroRig rig(true);
+    // The bias starts following after half a second of stillness
+    CHECK(rig.rotate(0.0f, kDrift, 1000).x < 0);
+    rig.rotate(0.0f, kDrift, 9000);
+    Motion settled = rig.rotate(0.0f, kDrift, 1000);
+    CHECK_EQ(settled.x, 0);
+    CHECK_EQ(settled.y, 0);
+
+    // A real turn moves by its rate less the learned bias, and does not
+    // pull the bias along with it
+    constexpr float kTurn = 30.0f;
+    Motion turn = rig.rotate(0.0f, kTurn, 500);
+    int expected = static_cast<int>(-(kTurn - kDrift) * kPixelsPerDegree * 0.5f);
+    CHECK(std::abs(turn.x - expected) <= 2);
+    CHECK_EQ(turn.y, 0);
+    settled = rig.rotate(0.0f, kDrift, 1000);
+    CHECK_EQ(settled.x, 0);
+}
+
+JOYCURSOR_TEST(gyro_tightening_deadzone) {
+    ScratchDirectory scratch;
+    GyroRig rig(false);
+
+    // Under the deadzone nothing moves, in any direction
+    Motion still = rig.rotate(kDeadzone * 0.8f, -kDeadzone * 0.5f, 1000);
+    CHECK_EQ(still.x, 0);
+    CHECK_EQ(still.y, 0);
+
+    // Under the tightening rate speed is scaled by rate / tightening
+    const float slow = kTightening / 2.0f;
+    Motion tightened = rig.rotate(slow, 0.0f, 1000);
+    int expected_slow = static_cast<int>(-slow * (slow / kTightening) * kPixelsPerDegree);
+    CHECK(std::abs(tightened.y - expected_slow) <= 1);
+    CHECK_EQ(tightened.x, 0);
+
+    // Over it the full rate is used
+    const float fast = kTightening * 2.0f;
+    Motion full = rig.rotate(-fast, 0.0f, 1000);
+    int expected_fast = static_cast<int>(fast * kPixelsPerDegree);
+    CHECK(std::abs(full.y - expected_fast) <= 1);
+}
+
+JOYCURSOR_TEST(gyro_integrates_sensor_time) {
+    constexpr float kYaw = -20.0f;
+    const int per_second = static_cast<int>(-kYaw * kPixelsPerDegree);
+    ScratchDirectory scratch;
+    GyroRig rig(false);
+
+    // Readings 1 and 9 ms apart cover one second of sensor time however the
+    // polls fall
+    uint64_t& sensor_ns = rig.sensorNs();
+    rig.core().clearOutput();
+    for (int frame = 0; frame < 100; ++frame) {
+        sensor_ns += kNsPerMs;
+        rig.pad().sendGyro(sensor_ns, 0.0f, kYaw);
+        sensor_ns += 9 * kNsPerMs;
+        rig.pad().sendGyro(sensor_ns, 0.0f, kYaw);
+        rig.core().frame(frame % 2 ? 4 : 16);
+    }
+    CHECK(std::abs(rig.output().x - per_second) <= 1);
+
+    // A burst of readings delivered in one poll counts for the sensor time it covers
+    rig.core().clearOutput();
+    for (int i = 0; i < 100; ++i) {
+        sensor_ns += 5 * kNsPerMs;
+        rig.pad().sendGyro(sensor_ns, 0.0f, kYaw);
+    }
+    rig.core().frame(kFrameMs);
+    CHECK(std::abs(rig.output().x - per_second / 2) <= 1);
+
+    // A reading after a dropout is not integrated over the gap
+    rig.core().clearOutput();
+    sensor_ns += kNsPerSecond;
+    rig.pad().sendGyro(sensor_ns, 0.0f, kYaw);
+    rig.core().frame(kFrameMs);
+    CHECK(rig.core().output().empty());
+    CHECK(std::abs(rig.rotate(0.0f, kYaw, 500).x - per_second / 2) <= 1);
+}
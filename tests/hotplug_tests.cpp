@@ -0,0 +1,71 @@
+// hotplug_tests.cpp
+// Connects and disconnects controllers thousands of times, each time
+// unplugged with its triggers held, and checks that nothing about them
+// outlives the connection.
+
+#include "test_support.h"
+
+namespace {
+
+constexpr int kWarmupCycles = 500;
+constexpr int kCycles = 5000;
+// Allowance for allocator and SDL bookkeeping; a leak of even a few dozen
+// bytes per connection exceeds it
+constexpr long kMaxRssGrowthKb = 256;
+
+nlohmann::json hotplugProfile() {
+    nlohmann::json enter = {{"enabled", true}, {"actions", {{{"action_type", "keyboard_enter"}, {"enabled", true}}}}};
+    return {
+        {"left_stick", {{"enabled", true}, {"action_type", "cursor"}, {"deadzone", 8000}, {"calibrate", false}}},
+        {"triggers", {
+            {"left_trigger", {{"enabled", true}, {"action_type", "button"}, {"threshold", 16000},
+                              {"button_action", enter}}},
+            {"right_trigger", {{"enabled", true}, {"action_type", "scroll"}, {"threshold", 8000},
+                               {"scroll_direction", "down"},
+                               {"trigger_scroll_action", {{"vertical_sensitivity", 1.0}, {"vertical_max_speed", 10}}}}}
+        }}
+    };
+}
+
+// One connection: the pad is used, then pulled out mid-press
+void plugCycle(CoreDriver& core) {
+    VirtualPad pad;
+    core.frame(5);
+    pad.setTrigger(SDL_GAMEPAD_AXIS_LEFT_TRIGGER, 32767);
+    pad.setTrigger(SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, 32767);
+    pad.setAxis(SDL_GAMEPAD_AXIS_LEFTX, 32767);
+    core.frames(3, 5);
+    pad.detach();
+    core.frame(5);
+}
+
+} // namespace
+
+JOYCURSOR_TEST(hotplug_stress) {
+    ScratchDirectory scratch;
+    writeJsonFile("settings.json", testSettings());
+    writeMappings(hotplugProfile());
+    CoreDriver core;
+
+    // The first connections fill caches and pools that are then reused
+    for (int i = 0; i < kWarmupCycles; ++i) {
+        plugCycle(core);
+    }
+    // Each unplug released the held trigger button
+    CHECK(core.count(OutputCommandType::KEYBOARD_DOWN) > 0);
+    CHECK_EQ(core.count(OutputCommandType::KEYBOARD_UP), core.count(OutputCommandType::KEYBOARD_DOWN));
+    core.clearOutput();
+
+    long rss_before = currentRssKb();
+    for (int i = 0; i < kCycles; ++i) {
+        plugCycle(core);
+        core.clearOutput();
+    }
+    long growth = currentRssKb() - rss_before;
+    CHECK(growth < kMaxRssGrowthKb);
+    CHECK(!core.manager().hasActiveController());
+
+    // Nothing keeps acting after the last controller left
+    core.frames(100, 5);
+    CHECK(core.output().empty());
+}
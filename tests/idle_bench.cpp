@@ -0,0 +1,78 @@
+// idle_bench.cpp
+// Per-frame polling cost with N connected controllers, all at rest or all
+// with a stick held, and how often the loop could block instead of polling.
+//
+//   JoyCursorTests --bench idle_pads [pad counts...]
+
+#include "test_support.h"
+#include <cstdio>
+
+namespace {
+
+constexpr uint64_t kFrameMs = 5;
+constexpr int kSettleFrames = 400;
+constexpr int kMeasuredFrames = 2000;
+
+void measure(int pad_count, bool active) {
+    ScratchDirectory scratch;
+    writeJsonFile("settings.json", testSettings());
+    writeMappings(fullDefaultProfile());
+
+    CoreDriver core;
+    std::vector<std::unique_ptr<VirtualPad>> pads;
+    for (int i = 0; i < pad_count; ++i) {
+        pads.push_back(std::make_unique<VirtualPad>());
+        if (active) {
+            pads.back()->setAxis(SDL_GAMEPAD_AXIS_LEFTX, 20000);
+        }
+    }
+    // Lets cursor smoothing run down so resting controllers settle
+    core.frames(kSettleFrames, kFrameMs);
+    core.clearOutput();
+
+    CoreStats before = core.manager().getStats();
+    std::vector<double> frame_us;
+    frame_us.reserve(kMeasuredFrames);
+    for (int i = 0; i < kMeasuredFrames; ++i) {
+        core.clock().advanceMs(kFrameMs);
+        uint64_t start = steadyNowNs();
+        core.manager().pollEvents();
+        frame_us.push_back((steadyNowNs() - start) / 1e3);
+        // Counts an idle wait when the loop would block; a zero timeout returns at once
+        core.manager().waitForInput(0);
+        core.clearOutput();
+    }
+    CoreStats after = core.manager().getStats();
+
+    double mean = 0.0;
+    for (double us : frame_us) {
+        mean += us;
+    }
+    mean /= frame_us.size();
+    double skips = double(after.idle_skips - before.idle_skips) / kMeasuredFrames;
+    double waits = 100.0 * (after.idle_waits - before.idle_waits) / kMeasuredFrames;
+    std::printf("%5d %-7s %9.2f %9.2f %9.2f %12.2f %8.1f\n", pad_count, active ? "active" : "idle", mean,
+                percentile(frame_us, 50), percentile(frame_us, 99), skips, waits);
+    std::fflush(stdout);
+}
+
+} // namespace
+
+JOYCURSOR_BENCH(idle_pads) {
+    std::vector<int> pad_counts = {0, 1, 4, 16, 64};
+    if (!args.empty()) {
+        pad_counts.clear();
+        for (const std::string& arg : args) {
+            pad_counts.push_back(std::stoi(arg));
+        }
+    }
+
+    std::printf("%5s %-7s %9s %9s %9s %12s %8s\n", "pads", "state", "mean_us", "p50_us", "p99_us",
+                "skips/frame", "waits_%");
+    for (int count : pad_counts) {
+        measure(count, false);
+        if (count > 0) {
+            measure(count, true);
+        }
+    }
+}
@@ -0,0 +1,145 @@
+// list_model_bench.cpp
+// Cost of showing and refreshing the controller library list with many
+// known controllers: the model update and the repaint that follows it.
+//
+//   JoyCursorTests --bench controller_list [controller counts...]
+
+#include "test_support.h"
+#include "ui/ControllerListModel.h"
+#include <QApplication>
+#include <QListView>
+#include <cstdio>
+#include <functional>
+
+namespace {
+
+constexpr int kIterations = 20;
+
+// Counts painted rows, to show that only visible rows that changed are drawn
+class CountingDelegate : public ControllerCardDelegate {
+public:
+    using ControllerCardDelegate::ControllerCardDelegate;
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override {
+        ++painted;
+        ControllerCardDelegate::paint(painter, option, index);
+    }
+    mutable int painted = 0;
+};
+
+QString guidAt(int index) {
+    return QString::fromStdString(testGuid(index));
+}
+
+QMap<QString, QString> knownControllers(int count) {
+    QMap<QString, QString> known;
+    for (int i = 0; i < count; ++i) {
+        known.insert(guidAt(i), QString("Test Controller %1").arg(i));
+    }
+    return known;
+}
+
+// A view laid out like the library window's
+struct ListWindow {
+    ControllerListModel model;
+    QListView view;
+    CountingDelegate* delegate;
+
+    ListWindow() : delegate(new CountingDelegate(&view)) {
+        view.setModel(&model);
+        view.setItemDelegate(delegate);
+        view.setUniformItemSizes(true);
+        view.resize(400, 600);
+    }
+
+    // Runs update, then lets the event loop repaint what it invalidated
+    double timeUpdate(const std::function<void()>& update) {
+        uint64_t start = steadyNowNs();
+        update();
+        QApplication::processEvents();
+        return (steadyNowNs() - start) / 1e6;
+    }
+};
+
+void printRow(int count, const char* operation, std::vector<double>& ms, int painted) {
+    std::printf("%7d %-22s %9.3f %9.3f %8d\n", count, operation, percentile(ms, 50), percentile(ms, 100),
+                painted);
+}
+
+void measure(int count) {
+    QMap<QString, QString> known = knownControllers(count);
+    QSet<QString> connected = {guidAt(0), guidAt(count / 2)};
+
+    // First show: the list is filled and the window painted for the first time
+    std::vector<double> show_ms;
+    int painted = 0;
+    for (int i = 0; i < kIterations; ++i) {
+        ListWindow window;
+        show_ms.push_back(window.timeUpdate([&] {
+            window.model.setControllers(known, connected);
+            window.view.show();
+        }));
+        painted = window.delegate->painted;
+    }
+    printRow(count, "show", show_ms, painted);
+
+    ListWindow window;
+    window.model.setControllers(known, connected);
+    window.view.show();
+    QApplication::processEvents();
+
+    auto measureRefresh = [&](const char* operation, const std::function<void(int)>& update) {
+        std::vector<double> ms;
+        window.delegate->painted = 0;
+        for (int i = 0; i < kIterations; ++i) {
+            ms.push_back(window.timeUpdate([&] { update(i); }));
+        }
+        printRow(count, operation, ms, window.delegate->painted / kIterations);
+    };
+
+    // The window is shown again with nothing changed
+    measureRefresh("refresh (unchanged)", [&](int) { window.model.setControllers(known, connected); });
+
+    // A visible controller connects and disconnects
+    measureRefresh("connect (visible)", [&](int i) {
+        window.model.setConnected(guidAt(1), QString(), i % 2 == 0);
+    });
+
+    // A controller scrolled out of view connects and disconnects
+    measureRefresh("connect (off-screen)", [&](int i) {
+        window.model.setConnected(guidAt(count - 1), QString(), i % 2 == 0);
+    });
+
+    // A new controller is added at the top and removed again
+    measureRefresh("add and remove", [&](int i) {
+        QMap<QString, QString> changed = known;
+        if (i % 2 == 0) {
+            changed.insert("00000000000000000000000000000000", "New Controller");
+        }
+        window.model.setControllers(changed, connected);
+    });
+}
+
+} // namespace
+
+JOYCURSOR_BENCH(controller_list) {
+    std::vector<int> counts = {1000};
+    if (!args.empty()) {
+        counts.clear();
+        for (const std::string& arg : args) {
+            counts.push_back(std::stoi(arg));
+        }
+    }
+
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    int argc = 1;
+    char name[] = "JoyCursorTests";
+    char* argv[] = {name, nullptr};
+    QApplication app(argc, argv);
+
+    std::printf("%7s %-22s %9s %9s %8s\n", "rows", "operation", "p50_ms", "max_ms", "painted");
+    for (int count : counts) {
+        measure(count);
+    }
+}
@@ -0,0 +1,90 @@
+// mapping_io_tests.cpp
+// Saves an edited mappings.json written by another version and checks that
+// every key this version does not understand comes back unchanged.
+
+#include "test_support.h"
+#include "core/config.h"
+#include <fstream>
+
+namespace {
+
+// A file from a newer version: top-level keys besides "mappings", and button
+// actions with keys, nested values and out of range numbers this version lacks
+const char* const kNewerMappings = R"({
+    "version": 3,
+    "sync": {"device": "laptop", "revision": 9007199254740993, "peers": [1, {"name": null}]},
+    "mappings": {
+        "default": {
+            "left_stick": {"enabled": true, "action_type": "cursor", "deadzone": 8000},
+            "buttons": {
+                "button_a": {"enabled": true, "actions": [{
+                    "enabled": true,
+                    "action_type": "keyboard_enter",
+                    "hold_ms": 5000000000,
+                    "macro": {"steps": ["ctrl", "c"], "gap": 0.5},
+                    "repeat_delay": "slow",
+                    "comment": null
+                }]}
+            }
+        }
+    }
+})";
+
+nlohmann::json readJsonFile(const std::string& path) {
+    std::ifstream in(path);
+    return nlohmann::json::parse(in);
+}
+
+// Edits the default profile's left stick deadzone
+void editDeadzone(Config& config, int deadzone) {
+    MappingProfile profile = *config.findProfile("default");
+    profile.left_stick.deadzone = deadzone;
+    config.storeProfile("default", profile);
+}
+
+} // namespace
+
+JOYCURSOR_TEST(mappings_unknown_keys_round_trip) {
+    ScratchDirectory scratch;
+    writeTextFile("mappings.json", kNewerMappings);
+    nlohmann::json original = readJsonFile("mappings.json");
+
+    Config config;
+    editDeadzone(config, 9000);
+    CHECK(config.saveMappings());
+
+    nlohmann::json saved = readJsonFile("mappings.json");
+    CHECK(saved["mappings"]["default"]["left_stick"]["deadzone"] == 9000);
+    CHECK(saved["version"] == original["version"]);
+    CHECK(saved["sync"] == original["sync"]);
+    const nlohmann::json& action = saved["mappings"]["default"]["buttons"]["button_a"]["actions"][0];
+    const nlohmann::json& original_action = original["mappings"]["default"]["buttons"]["button_a"]["actions"][0];
+    for (const char* key : {"hold_ms", "macro", "comment"}) {
+        CHECK(action.contains(key) && action[key] == original_action[key]);
+    }
+    // A known key with a value of the wrong type is written back as it was
+    CHECK(action["repeat_delay"] == "slow");
+    CHECK(action["action_type"] == "keyboard_enter");
+
+    // The saved file reads back the same
+    Config reloaded;
+    const MappingProfile* profile = reloaded.findProfile("default");
+    CHECK(profile && profile->left_stick.deadzone == 9000);
+    CHECK(profile->buttons.at("button_a").actions.size() == 1);
+    CHECK(profile->buttons.at("button_a").actions[0].unknown_fields.size() == 4);
+}
+
+JOYCURSOR_TEST(mappings_unsaveable_file_is_kept) {
+    ScratchDirectory scratch;
+    // An actions array element that is not an action object has nowhere to be kept
+    nlohmann::json file = nlohmann::json::parse(kNewerMappings);
+    file["mappings"]["default"]["buttons"]["button_a"]["actions"].push_back("legacy");
+    writeJsonFile("mappings.json", file);
+
+    Config config;
+    editDeadzone(config, 9000);
+    CHECK(!config.saveMappings());
+    CHECK(readJsonFile("mappings.json") == file);
+    // The edit is still in memory
+    CHECK(config.findProfile("default")->left_stick.deadzone == 9000);
+}
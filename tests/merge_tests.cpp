@@ -0,0 +1,109 @@
+// merge_tests.cpp
+// Two controllers move the cursor at once under each cursor_merge policy:
+// their motion is added, the larger one wins, or the one that started
+// moving last wins.
+
+#include "test_support.h"
+#include <cstdlib>
+
+namespace {
+
+constexpr uint64_t kFrameMs = 10;
+constexpr int kMeasuredFrames = 10;
+
+// Left stick cursor with a linear response and no ramp or smoothing, so
+// each pad moves at a steady speed set by its deflection
+nlohmann::json cursorProfile() {
+    return {{"left_stick", {
+        {"enabled", true},
+        {"action_type", "cursor"},
+        {"deadzone", 8000},
+        {"calibrate", false},
+        {"cursor_action", {{"sensitivity", 1.0}, {"boosted_sensitivity", 1.0}, {"smoothing", 1.0},
+                           {"acceleration", {{"curve", "linear"}, {"ramp_time", 0.0}}}}}
+    }}};
+}
+
+struct Motion {
+    int x = 0;
+    int y = 0;
+};
+
+// Cursor motion over the next kMeasuredFrames frames
+Motion measure(CoreDriver& core) {
+    core.clearOutput();
+    core.frames(kMeasuredFrames, kFrameMs);
+    return {core.sumA(OutputCommandType::MOUSE_MOVE), core.sumB(OutputCommandType::MOUSE_MOVE)};
+}
+
+bool near(const Motion& actual, const Motion& expected) {
+    return std::abs(actual.x - expected.x) <= 1 && std::abs(actual.y - expected.y) <= 1;
+}
+
+// What the cursor did in each step of a two-pad session: pad A pushes right
+// at full tilt, pad B joins pushing up at half tilt, A lets go, A comes back
+struct Session {
+    Motion a_alone;
+    Motion both;
+    Motion b_alone;
+    Motion a_returns;
+    uint64_t dropped_motions = 0;
+};
+
+Session playSession(const char* policy) {
+    ScratchDirectory scratch;
+    nlohmann::json settings = testSettings();
+    settings["cursor_merge"] = policy;
+    writeJsonFile("settings.json", settings);
+    writeMappings(cursorProfile());
+    CoreDriver core;
+    VirtualPad pad_a("JoyCursor Test Pad A");
+    VirtualPad pad_b("JoyCursor Test Pad B");
+    core.frame(kFrameMs);
+
+    Session session;
+    pad_a.setAxis(SDL_GAMEPAD_AXIS_LEFTX, 32767);
+    core.frame(kFrameMs);
+    session.a_alone = measure(core);
+    pad_b.setAxis(SDL_GAMEPAD_AXIS_LEFTY, -16384);
+    core.frame(kFrameMs);
+    session.both = measure(core);
+    pad_a.setAxis(SDL_GAMEPAD_AXIS_LEFTX, 0);
+    core.frame(kFrameMs);
+    session.b_alone = measure(core);
+    pad_a.setAxis(SDL_GAMEPAD_AXIS_LEFTX, 32767);
+    core.frame(kFrameMs);
+    session.a_returns = measure(core);
+    session.dropped_motions = core.manager().getStats().dropped_motions;
+    return session;
+}
+
+} // namespace
+
+JOYCURSOR_TEST(cursor_merge_sum) {
+    Session session = playSession("sum");
+    CHECK(session.a_alone.x > 0 && session.a_alone.y == 0);
+    CHECK(session.b_alone.x == 0 && session.b_alone.y < 0);
+    // Both pads move the cursor together
+    Motion sum = {session.a_alone.x, session.b_alone.y};
+    CHECK(near(session.both, sum));
+    CHECK(near(session.a_returns, sum));
+    CHECK_EQ(session.dropped_motions, 0u);
+}
+
+JOYCURSOR_TEST(cursor_merge_max_magnitude) {
+    Session session = playSession("max_magnitude");
+    CHECK(session.a_alone.x > -session.b_alone.y);
+    // The full tilt wins over the half tilt whichever started first
+    CHECK(near(session.both, session.a_alone));
+    CHECK(near(session.a_returns, session.a_alone));
+    CHECK(session.dropped_motions > 0);
+}
+
+JOYCURSOR_TEST(cursor_merge_most_recent) {
+    Session session = playSession("most_recent");
+    // The pad that started moving last wins, even with the smaller push
+    CHECK(near(session.both, session.b_alone));
+    CHECK(near(session.a_returns, session.a_alone));
+    CHECK(session.dropped_motions > 0);
+}
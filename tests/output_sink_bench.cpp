@@ -0,0 +1,69 @@
+// output_sink_bench.cpp
+// Per-frame cost of sending output through an OutputSink against the direct
+// per-event calls it replaced, for frames with no commands (most polls) up
+// to a few dozen.
+//
+//   JoyCursorTests --bench output_sink [frames]
+
+#include "test_support.h"
+#include <cstdio>
+
+namespace {
+
+constexpr int kDefaultFrames = 1000000;
+constexpr int kRepeats = 5;
+
+volatile int g_delivered = 0;
+
+// Stands in for the old extern "C" platform_simulate_* calls: one
+// out-of-line call per event. Called through a volatile pointer so it is
+// never inlined or dropped.
+void simulateEvent(int type, int a, int b) {
+    g_delivered = g_delivered + type + a + b;
+}
+void (*volatile g_simulateEvent)(int, int, int) = &simulateEvent;
+
+// What the core does at the end of every poll before and after the change
+double directFrameNs(int frames, int commands) {
+    uint64_t start = steadyNowNs();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int i = 0; i < commands; ++i) {
+            g_simulateEvent(static_cast<int>(OutputCommandType::MOUSE_MOVE), i, frame);
+        }
+    }
+    return double(steadyNowNs() - start) / frames;
+}
+
+double sinkFrameNs(OutputSink& sink, int frames, int commands) {
+    uint64_t start = steadyNowNs();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int i = 0; i < commands; ++i) {
+            sink.mouseMove(i, frame);
+        }
+        g_delivered = g_delivered + static_cast<int>(sink.pendingCommandCount());
+        sink.commit();
+    }
+    return double(steadyNowNs() - start) / frames;
+}
+
+} // namespace
+
+JOYCURSOR_BENCH(output_sink) {
+    int frames = args.empty() ? kDefaultFrames : std::stoi(args[0]);
+    // Held through the base class, as the controller manager holds its sink
+    std::unique_ptr<OutputSink> sink = std::make_unique<NullOutputSink>();
+
+    std::printf("%9s %10s %10s %10s\n", "commands", "direct_ns", "sink_ns", "delta_ns");
+    for (int commands : {0, 1, 4, 16, 64}) {
+        std::vector<double> direct_ns;
+        std::vector<double> sink_ns;
+        for (int repeat = 0; repeat < kRepeats; ++repeat) {
+            direct_ns.push_back(directFrameNs(frames, commands));
+            sink_ns.push_back(sinkFrameNs(*sink, frames, commands));
+        }
+        double direct = percentile(direct_ns, 50);
+        double batched = percentile(sink_ns, 50);
+        std::printf("%9d %10.2f %10.2f %10.2f\n", commands, direct, batched, batched - direct);
+        std::fflush(stdout);
+    }
+}
@@ -0,0 +1,77 @@
+// pacing_tests.cpp
+// Cursor output paced to 60 frames per second while the core polls every
+// millisecond: motion goes out on the paced ticks, button edges go out on
+// the poll that saw them.
+
+#include "test_support.h"
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+constexpr int kOutputRate = 60;
+constexpr uint64_t kFrameMs = 1;
+constexpr int kFramesPerSecond = 1000;
+// Button A is pressed or released every this many polls, which falls
+// between paced ticks most of the time
+constexpr int kButtonTogglePolls = 7;
+
+nlohmann::json pacedProfile() {
+    return {
+        {"left_stick", {{"enabled", true}, {"action_type", "cursor"}, {"deadzone", 8000}, {"calibrate", false},
+                        {"cursor_action", {{"sensitivity", 1.0}, {"smoothing", 1.0},
+                                           {"acceleration", {{"curve", "linear"}, {"ramp_time", 0.0}}}}}}},
+        {"buttons", {{"button_a", {{"enabled", true},
+                                   {"actions", {{{"action_type", "keyboard_enter"}, {"enabled", true}}}}}}}}
+    };
+}
+
+} // namespace
+
+JOYCURSOR_TEST(output_pacing_60hz) {
+    ScratchDirectory scratch;
+    nlohmann::json settings = testSettings();
+    settings["output_rate"] = kOutputRate;
+    writeJsonFile("settings.json", settings);
+    writeMappings(pacedProfile());
+    CoreDriver core;
+    VirtualPad pad;
+    core.frame(kFrameMs);
+    pad.setAxis(SDL_GAMEPAD_AXIS_LEFTX, 32767);
+    core.frames(100, kFrameMs);
+    core.clearOutput();
+
+    size_t motion_commits = 0;
+    size_t edges = 0;
+    size_t edges_between_ticks = 0;
+    bool down = false;
+    for (int frame = 1; frame <= kFramesPerSecond; ++frame) {
+        bool toggled = frame % kButtonTogglePolls == 0;
+        if (toggled) {
+            down = !down;
+            pad.setButton(SDL_GAMEPAD_BUTTON_SOUTH, down);
+        }
+        core.frame(kFrameMs);
+        size_t moves = core.count(OutputCommandType::MOUSE_MOVE);
+        size_t key_edges = core.count(OutputCommandType::KEYBOARD_DOWN) + core.count(OutputCommandType::KEYBOARD_UP);
+        // An edge is sent by the poll that saw it, never held for the next tick
+        CHECK_EQ(key_edges, toggled ? 1u : 0u);
+        motion_commits += moves;
+        edges += key_edges;
+        if (key_edges && !moves) {
+            edges_between_ticks++;
+        }
+        core.clearOutput();
+    }
+
+    // One motion commit per paced tick, give or take the tick at the edge of the second
+    CHECK(std::abs(static_cast<int>(motion_commits) - kOutputRate) <= 1);
+    CHECK_EQ(edges, static_cast<size_t>(kFramesPerSecond / kButtonTogglePolls));
+    CHECK(edges_between_ticks > edges / 2);
+
+    // Ticks land on whole polls, 16 or 17 ms apart around the 16.667 ms interval
+    CoreStats stats = core.manager().getStats();
+    CHECK(std::abs(stats.output_interval_mean_us - 1e6 / kOutputRate) < 100.0);
+    CHECK(stats.output_jitter_us > 0.0);
+    CHECK(stats.output_jitter_us < kFrameMs * 1000.0);
+}
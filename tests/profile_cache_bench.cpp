@@ -0,0 +1,96 @@
+// profile_cache_bench.cpp
+// Startup cost of serving mapping profiles: from a current binary cache,
+// after the cache fails its checksum, and from mappings.json alone.
+//
+//   JoyCursorTests --bench profile_cache [iterations]
+
+#include "test_support.h"
+#include "core/config.h"
+#include "core/mapping_manager.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+const char* kCachePath = "mappings.cache";
+
+std::string readFile(const char* path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+struct StartupTimes {
+    std::vector<double> load_us;    // Config: the cache is mapped or mappings.json parsed
+    std::vector<double> manager_us; // MappingManager: rebuilds the cache if it was not used
+    std::vector<double> lookup_us;  // First mapping lookups of every controller
+};
+
+// Starts like the core does and looks up every controller's mappings once
+void startup(int guid_count, StartupTimes& times) {
+    uint64_t start = steadyNowNs();
+    Config config;
+    uint64_t loaded = steadyNowNs();
+    MappingManager mappings(config);
+    uint64_t managed = steadyNowNs();
+    for (int i = 0; i < guid_count; ++i) {
+        std::string guid = testGuid(i);
+        mappings.getLeftStick(guid);
+        mappings.getRightStick(guid);
+        for (const char* button : kProfileButtons) {
+            mappings.getButtonMapping(guid, button);
+        }
+    }
+    uint64_t looked_up = steadyNowNs();
+    times.load_us.push_back((loaded - start) / 1e3);
+    times.manager_us.push_back((managed - loaded) / 1e3);
+    times.lookup_us.push_back((looked_up - managed) / 1e3);
+}
+
+void printRow(int guid_count, const char* path, StartupTimes& times) {
+    double load = percentile(times.load_us, 50);
+    double manager = percentile(times.manager_us, 50);
+    double lookup = percentile(times.lookup_us, 50);
+    std::printf("%6d %-10s %10.1f %12.1f %11.1f %10.1f\n", guid_count, path, load, manager, lookup,
+                load + manager + lookup);
+}
+
+} // namespace
+
+JOYCURSOR_BENCH(profile_cache) {
+    int iterations = args.empty() ? 20 : std::stoi(args[0]);
+
+    std::printf("%6s %-10s %10s %12s %11s %10s\n", "guids", "path", "load_us", "manager_us", "lookup_us",
+                "total_us");
+    for (int guid_count : {1, 1000}) {
+        ScratchDirectory scratch;
+        writeJsonFile("settings.json", testSettings());
+        writeProfileFiles(guid_count);
+        {
+            // Builds the cache for the current mappings.json
+            Config config;
+            MappingManager mappings(config);
+        }
+        std::string cache = readFile(kCachePath);
+        if (cache.empty()) {
+            throw std::runtime_error("the profile cache was not written");
+        }
+        // The last payload byte belongs to the last entry, so only the checksum catches it
+        std::string corrupt = cache;
+        corrupt.back() ^= 0x5a;
+
+        StartupTimes hit, checksum, json;
+        for (int i = 0; i < iterations; ++i) {
+            writeTextFile(kCachePath, cache);
+            startup(guid_count, hit);
+            writeTextFile(kCachePath, corrupt);
+            startup(guid_count, checksum);
+            std::filesystem::remove(kCachePath);
+            startup(guid_count, json);
+        }
+        printRow(guid_count, "cache hit", hit);
+        printRow(guid_count, "checksum", checksum);
+        printRow(guid_count, "json", json);
+    }
+}
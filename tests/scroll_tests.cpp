@@ -0,0 +1,95 @@
+// scroll_tests.cpp
+// Replays a stick scroll gesture and compares the scroll output with
+// kinetic scrolling on and off.
+
+#include "test_support.h"
+
+namespace {
+
+constexpr uint64_t kFrameMs = 10;
+constexpr int kHeldFrames = 30;
+constexpr int kReleasedFrames = 300;
+
+nlohmann::json scrollProfile() {
+    return {{"right_stick", {
+        {"enabled", true},
+        {"action_type", "scroll"},
+        {"deadzone", 8000},
+        {"calibrate", false},
+        {"scroll_action", {{"vertical_sensitivity", 1.0}, {"vertical_max_speed", 20},
+                           {"horizontal_sensitivity", 0.0}, {"horizontal_max_speed", 0}}}
+    }}};
+}
+
+// Vertical scroll sent in each frame of the gesture: the right stick held
+// fully up, then released
+std::vector<int> replayScroll(bool kinetic) {
+    ScratchDirectory scratch;
+    nlohmann::json settings = testSettings();
+    settings["kinetic_scroll"] = kinetic;
+    settings["kinetic_scroll_decay"] = 0.05;
+    writeJsonFile("settings.json", settings);
+    writeMappings(scrollProfile());
+
+    CoreDriver core;
+    VirtualPad pad;
+    core.frame(kFrameMs);
+    CHECK(core.manager().hasActiveController());
+
+    std::vector<int> scroll;
+    auto record = [&] {
+        scroll.push_back(core.sumA(OutputCommandType::SCROLL_VERTICAL));
+        core.clearOutput();
+    };
+    pad.setAxis(SDL_GAMEPAD_AXIS_RIGHTY, -32767);
+    for (int i = 0; i < kHeldFrames; ++i) {
+        core.frame(kFrameMs);
+        record();
+    }
+    pad.setAxis(SDL_GAMEPAD_AXIS_RIGHTY, 0);
+    for (int i = 0; i < kReleasedFrames; ++i) {
+        core.frame(kFrameMs);
+        record();
+    }
+    return scroll;
+}
+
+int sum(const std::vector<int>& values, size_t begin, size_t end) {
+    int total = 0;
+    for (size_t i = begin; i < end; ++i) {
+        total += values[i];
+    }
+    return total;
+}
+
+} // namespace
+
+JOYCURSOR_TEST(kinetic_scroll_replay) {
+    std::vector<int> plain = replayScroll(false);
+    std::vector<int> kinetic = replayScroll(true);
+    CHECK_EQ(plain.size(), kinetic.size());
+
+    // While the stick is held both scroll the same, upwards
+    for (int i = 0; i < kHeldFrames; ++i) {
+        CHECK_EQ(kinetic[i], plain[i]);
+    }
+    int held = sum(plain, 0, kHeldFrames);
+    CHECK(held > 0);
+
+    // Without kinetic scrolling the release stops it at once
+    CHECK_EQ(sum(plain, kHeldFrames, plain.size()), 0);
+
+    // With it the page coasts on in the same direction, slowing down until it stops
+    size_t released = kHeldFrames;
+    int coasted = sum(kinetic, released, kinetic.size());
+    CHECK(coasted > 0);
+    CHECK(coasted < held * 4);
+    int first_window = sum(kinetic, released, released + 20);
+    int second_window = sum(kinetic, released + 20, released + 40);
+    CHECK(first_window > 0);
+    CHECK(second_window <= first_window);
+    for (size_t i = released; i < kinetic.size(); ++i) {
+        CHECK(kinetic[i] >= 0);
+    }
+    CHECK_EQ(sum(kinetic, kinetic.size() - 50, kinetic.size()), 0);
+}
@@ -0,0 +1,243 @@
+// split_latency_bench.cpp
+// Latency with the UI in the core's process and with the core headless and
+// the UI attached through CoreServer. A pad's stick flips every frame while a
+// UI thread follows the live input and sends one command per frame.
+//
+//   JoyCursorTests --bench split_latency [frames]
+//
+// Columns: time from a stick change to the UI seeing it (the snapshot table
+// in-process, the shared state page split), command round trip (call() or
+// the control socket), and the core's own input to output latency and
+// frame time while the UI is busy.
+
+#include "test_support.h"
+#include "core/core_server.h"
+#include "core/joycursor_core.h"
+#include "core/shared_state.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#ifdef __linux__
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr auto kFrameInterval = std::chrono::milliseconds(5);
+constexpr int kSettleFrames = 20;
+constexpr Sint16 kStickValue = 20000;
+constexpr int kStartRing = 64;
+
+Sint16 stickValue(uint64_t frame) {
+    return frame % 2 ? kStickValue : -kStickValue;
+}
+
+// Left stick X of the first controller in the table
+bool readStickX(const InputSnapshotTable& table, Sint16& value) {
+    for (const auto& slot : table.slots) {
+        InputSnapshot snapshot;
+        if (slot.load(snapshot) && snapshot.guid[0] != '\0') {
+            value = snapshot.axes[SDL_GAMEPAD_AXIS_LEFTX];
+            return true;
+        }
+    }
+    return false;
+}
+
+// A blocking connection to the core's control socket
+class SocketClient {
+public:
+    SocketClient() {
+        m_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        std::string path = coreSocketPath();
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        if (m_fd < 0 || connect(m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            throw std::runtime_error("cannot connect to " + path);
+        }
+    }
+    ~SocketClient() { close(m_fd); }
+    SocketClient(const SocketClient&) = delete;
+    SocketClient& operator=(const SocketClient&) = delete;
+
+    // Sends a request and returns its reply, skipping pushed events
+    std::string request(const std::string& line) {
+        std::string message = line + "\n";
+        if (send(m_fd, message.data(), message.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(message.size())) {
+            throw std::runtime_error("control socket closed");
+        }
+        for (;;) {
+            size_t newline;
+            while ((newline = m_input.find('\n')) == std::string::npos) {
+                char buffer[4096];
+                ssize_t count = recv(m_fd, buffer, sizeof(buffer), 0);
+                if (count <= 0) {
+                    throw std::runtime_error("control socket closed");
+                }
+                m_input.append(buffer, static_cast<size_t>(count));
+            }
+            std::string reply = m_input.substr(0, newline);
+            m_input.erase(0, newline + 1);
+            if (reply.rfind("{\"event\"", 0) != 0) {
+                return reply;
+            }
+        }
+    }
+
+private:
+    int m_fd = -1;
+    std::string m_input;
+};
+
+// Written by the polling thread before each frame, read by the UI thread
+struct FrameClock {
+    std::atomic<uint64_t> frame{0};
+    uint64_t start_ns[kStartRing] = {};
+    std::atomic<bool> stop{false};
+    std::atomic<bool> ui_done{false};
+};
+
+struct UiSamples {
+    std::vector<double> visible_us;
+    std::vector<double> command_us;
+};
+
+// Follows the stick through table and runs one command per frame, like a UI
+// showing the live visualizer
+void followInput(const InputSnapshotTable& table, FrameClock& clock, const std::function<void()>& command,
+                 UiSamples& samples) {
+    uint64_t seen = clock.frame.load(std::memory_order_acquire);
+    while (!clock.stop.load(std::memory_order_relaxed)) {
+        uint64_t frame = clock.frame.load(std::memory_order_acquire);
+        if (frame == seen) {
+            std::this_thread::yield();
+            continue;
+        }
+        seen = frame;
+        uint64_t start = clock.start_ns[frame % kStartRing];
+        Sint16 value = 0;
+        // A frame that ends before its input shows up is not sampled
+        while (clock.frame.load(std::memory_order_acquire) == frame && !clock.stop.load(std::memory_order_relaxed)) {
+            if (readStickX(table, value) && value == stickValue(frame)) {
+                samples.visible_us.push_back((steadyNowNs() - start) / 1e3);
+                break;
+            }
+            std::this_thread::yield();
+        }
+        uint64_t command_start = steadyNowNs();
+        command();
+        samples.command_us.push_back((steadyNowNs() - command_start) / 1e3);
+    }
+    clock.ui_done = true;
+}
+
+void measure(bool split, int frames) {
+    ScratchDirectory scratch;
+    writeJsonFile("settings.json", testSettings());
+    writeMappings(fullDefaultProfile());
+
+    JoyCursorCore core;
+    if (!core.initialize()) {
+        throw std::runtime_error("the core failed to initialize");
+    }
+    std::unique_ptr<CoreServer> server;
+    if (split) {
+        server = std::make_unique<CoreServer>(core);
+        if (!server->start()) {
+            throw std::runtime_error("cannot serve the core; stop any running core first");
+        }
+    }
+    VirtualPad pad;
+    auto poll = [&] {
+        core.pollEvents();
+        if (server) {
+            server->publish();
+        }
+    };
+    for (int i = 0; i < kSettleFrames; ++i) {
+        poll();
+    }
+
+    FrameClock clock;
+    UiSamples samples;
+    std::thread ui;
+    std::unique_ptr<SharedStateMapping> page;
+    std::unique_ptr<SocketClient> client;
+    if (split) {
+        page = SharedStateMapping::open();
+        if (!page || !page->isCompatible()) {
+            throw std::runtime_error("cannot map the shared state page");
+        }
+        client = std::make_unique<SocketClient>();
+        ui = std::thread([&] {
+            followInput(page->state()->input, clock,
+                        [&] { client->request(R"({"id":1,"cmd":"controllers"})"); }, samples);
+        });
+    } else {
+        ui = std::thread([&] {
+            followInput(*core.inputSnapshots(), clock,
+                        [&] { core.call([](JoyCursorCore& c) { return c.getConnectedControllers(); }).get(); },
+                        samples);
+        });
+    }
+
+    CoreStats before = core.getStats();
+    auto next_frame = std::chrono::steady_clock::now();
+    for (int i = 1; i <= frames; ++i) {
+        clock.start_ns[i % kStartRing] = steadyNowNs();
+        pad.setAxis(SDL_GAMEPAD_AXIS_LEFTX, stickValue(i));
+        clock.frame.store(i, std::memory_order_release);
+        poll();
+        next_frame += kFrameInterval;
+        std::this_thread::sleep_until(next_frame);
+    }
+    clock.stop = true;
+    // The UI may be waiting on a command that needs another poll
+    while (!clock.ui_done.load()) {
+        poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ui.join();
+    CoreStats after = core.getStats();
+    if (server) {
+        server->stop();
+    }
+
+    LatencyHistogram frame_time = after.frame_time;
+    DelayHistogram input_latency = after.input_latency;
+    for (int i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+        frame_time.buckets[i] -= before.frame_time.buckets[i];
+    }
+    frame_time.count -= before.frame_time.count;
+    for (int i = 0; i < DelayHistogram::kBucketCount; ++i) {
+        input_latency.buckets[i] -= before.input_latency.buckets[i];
+    }
+    input_latency.count -= before.input_latency.count;
+
+    std::printf("%-10s %8zu %9.1f %9.1f %9.1f %9.1f %10llu %10llu %9llu\n", split ? "split" : "in-process",
+                samples.visible_us.size(), percentile(samples.visible_us, 50), percentile(samples.visible_us, 99),
+                percentile(samples.command_us, 50), percentile(samples.command_us, 99),
+                static_cast<unsigned long long>(input_latency.percentile(50)),
+                static_cast<unsigned long long>(input_latency.percentile(99)),
+                static_cast<unsigned long long>(frame_time.percentile(99)));
+    std::fflush(stdout);
+}
+
+} // namespace
+
+JOYCURSOR_BENCH(split_latency) {
+    int frames = args.empty() ? 2000 : std::stoi(args[0]);
+    std::printf("%-10s %8s %9s %9s %9s %9s %10s %10s %9s\n", "ui", "samples", "seen_p50", "seen_p99", "cmd_p50",
+                "cmd_p99", "in_out_p50", "in_out_p99", "frame_p99");
+    measure(false, frames);
+    measure(true, frames);
+}
+
+#endif // __linux__
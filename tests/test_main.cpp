@@ -0,0 +1,105 @@
+// test_main.cpp
+// Entry point of JoyCursorTests. Runs the named tests, or all of them, and
+// runs benchmarks with --bench <name> [args]. A skipped test exits with
+// kSkipExitCode so ctest can report it separately.
+
+#include "test_support.h"
+#include <cstdlib>
+#include <iostream>
+#include <map>
+
+namespace {
+
+constexpr int kSkipExitCode = 77;
+
+std::map<std::string, TestFunction>& tests() {
+    static std::map<std::string, TestFunction> registry;
+    return registry;
+}
+
+std::map<std::string, BenchFunction>& benches() {
+    static std::map<std::string, BenchFunction> registry;
+    return registry;
+}
+
+void printUsage() {
+    std::cout << "Usage: JoyCursorTests [test...]\n"
+              << "       JoyCursorTests --list\n"
+              << "       JoyCursorTests --bench <name> [args...]\n";
+}
+
+} // namespace
+
+TestRegistrar::TestRegistrar(const char* name, TestFunction run) {
+    tests()[name] = run;
+}
+
+BenchRegistrar::BenchRegistrar(const char* name, BenchFunction run) {
+    benches()[name] = run;
+}
+
+int main(int argc, char* argv[]) {
+    // The core initializes SDL video for the display refresh rate only; no
+    // window system is needed
+    setenv("SDL_VIDEO_DRIVER", "dummy", 0);
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (!args.empty() && (args[0] == "--help" || args[0] == "-h")) {
+        printUsage();
+        return 0;
+    }
+    if (!args.empty() && args[0] == "--list") {
+        for (const auto& [name, run] : tests()) {
+            std::cout << name << "\n";
+        }
+        for (const auto& [name, run] : benches()) {
+            std::cout << "--bench " << name << "\n";
+        }
+        return 0;
+    }
+    if (!args.empty() && args[0] == "--bench") {
+        auto bench = args.size() > 1 ? benches().find(args[1]) : benches().end();
+        if (bench == benches().end()) {
+            printUsage();
+            return 2;
+        }
+        try {
+            bench->second(std::vector<std::string>(args.begin() + 2, args.end()));
+        } catch (const std::exception& e) {
+            std::cerr << "Benchmark " << bench->first << " failed: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    std::vector<std::string> selected = args;
+    if (selected.empty()) {
+        for (const auto& [name, run] : tests()) {
+            selected.push_back(name);
+        }
+    }
+    int failed = 0;
+    int skipped = 0;
+    for (const std::string& name : selected) {
+        auto test = tests().find(name);
+        if (test == tests().end()) {
+            std::cerr << "Unknown test " << name << "\n";
+            return 2;
+        }
+        try {
+            test->second();
+            std::cout << "PASS " << name << "\n";
+        } catch (const TestSkipped& e) {
+            std::cout << "SKIP " << name << ": " << e.what() << "\n";
+            skipped++;
+        } catch (const std::exception& e) {
+            std::cout << "FAIL " << name << ": " << e.what() << "\n";
+            failed++;
+        }
+    }
+    if (failed > 0) {
+        return 1;
+    }
+    // Only a run where every selected test was skipped counts as skipped
+    return skipped > 0 && skipped == static_cast<int>(selected.size()) ? kSkipExitCode : 0;
+}
@@ -0,0 +1,265 @@
+// test_support.cpp
+// Implementation for the shared test and benchmark helpers
+
+#include "test_support.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sys/resource.h>
+#include <unistd.h>
+
+void failCheck(const char* file, int line, const std::string& message) {
+    throw TestFailure(std::string(file) + ":" + std::to_string(line) + ": check failed: " + message);
+}
+
+// --- Files ---
+
+ScratchDirectory::ScratchDirectory() : m_previous(std::filesystem::current_path()) {
+    static std::atomic<int> counter{0};
+    std::random_device random;
+    std::filesystem::path base = std::filesystem::temp_directory_path();
+    do {
+        m_path = base / ("joycursor-test-" + std::to_string(getpid()) + "-" + std::to_string(counter++) + "-" +
+                         std::to_string(random() % 100000));
+    } while (!std::filesystem::create_directory(m_path));
+    std::filesystem::current_path(m_path);
+}
+
+ScratchDirectory::~ScratchDirectory() {
+    std::error_code ec;
+    std::filesystem::current_path(m_previous, ec);
+    std::filesystem::remove_all(m_path, ec);
+}
+
+void writeTextFile(const std::string& path, const std::string& text) {
+    std::ofstream out(path, std::ios::binary);
+    out << text;
+    if (!out) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+}
+
+void writeJsonFile(const std::string& path, const nlohmann::json& json) {
+    writeTextFile(path, json.dump(4));
+}
+
+nlohmann::json testSettings() {
+    return {
+        {"cursor_merge", "sum"},
+        {"output_rate", 0},
+        {"kinetic_scroll", false},
+        {"output_sink", "null"}
+    };
+}
+
+void writeMappings(const nlohmann::json& default_profile) {
+    writeJsonFile("mappings.json", {{"mappings", {{"default", default_profile}}}});
+}
+
+const char* const kProfileButtons[kProfileButtonCount] = {
+    "button_a", "button_b", "button_x", "button_y", "start", "back"
+};
+
+std::string testGuid(int index) {
+    char guid[33];
+    std::snprintf(guid, sizeof(guid), "03000000%08x0000%012x", 0x5e04u + index % 7, index);
+    return guid;
+}
+
+namespace {
+
+nlohmann::json buttonJson(const char* action) {
+    return {{"enabled", true}, {"actions", {{{"action_type", action}, {"enabled", true}}}}};
+}
+
+} // namespace
+
+nlohmann::json fullDefaultProfile() {
+    nlohmann::json stick = {
+        {"enabled", true},
+        {"action_type", "cursor"},
+        {"deadzone", 8000},
+        {"cursor_action", {{"sensitivity", 0.15}, {"boosted_sensitivity", 0.6}, {"smoothing", 0.2}}},
+        {"scroll_action", {{"vertical_sensitivity", 1.0}, {"horizontal_sensitivity", 0.5},
+                           {"vertical_max_speed", 20}, {"horizontal_max_speed", 10}}}
+    };
+    nlohmann::json profile = {{"name", "Default Profile"}, {"left_stick", stick}, {"right_stick", stick}};
+    profile["right_stick"]["action_type"] = "scroll";
+    for (const char* button : kProfileButtons) {
+        profile["buttons"][button] = buttonJson("mouse_left_click");
+    }
+    return profile;
+}
+
+void writeProfileFiles(int guid_count) {
+    nlohmann::json mappings = {{"mappings", {{"default", fullDefaultProfile()}}}};
+    nlohmann::json controllers = nlohmann::json::object();
+    for (int i = 0; i < guid_count; ++i) {
+        std::string guid = testGuid(i);
+        nlohmann::json profile = {{"left_stick", {{"cursor_action", {{"sensitivity", 0.1 + (i % 10) * 0.05}}}}}};
+        profile["buttons"][kProfileButtons[i % kProfileButtonCount]] =
+            buttonJson(i % 2 ? "keyboard_enter" : "mouse_right_click");
+        mappings["mappings"][guid] = profile;
+        controllers[guid] = "Test Controller " + std::to_string(i);
+    }
+    writeJsonFile("mappings.json", mappings);
+    writeJsonFile("controllers.json", controllers);
+}
+
+// --- Measurements ---
+
+long peakRssKb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+long currentRssKb() {
+    std::ifstream statm("/proc/self/statm");
+    long pages = 0;
+    long resident = 0;
+    statm >> pages >> resident;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+double percentile(std::vector<double>& samples, double p) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t rank = static_cast<size_t>(p / 100.0 * (samples.size() - 1) + 0.5);
+    return samples[std::min(rank, samples.size() - 1)];
+}
+
+uint64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// --- Controllers ---
+
+VirtualPad::VirtualPad(const char* name, VirtualPadOptions options) {
+    SDL_VirtualJoystickDesc desc;
+    SDL_INIT_INTERFACE(&desc);
+    desc.type = SDL_JOYSTICK_TYPE_GAMEPAD;
+    desc.naxes = SDL_GAMEPAD_AXIS_COUNT;
+    desc.nbuttons = SDL_GAMEPAD_BUTTON_COUNT;
+    desc.name = name;
+    SDL_VirtualJoystickSensorDesc gyro = {SDL_SENSOR_GYRO, kVirtualGyroRate};
+    if (options.gyro) {
+        desc.nsensors = 1;
+        desc.sensors = &gyro;
+    }
+    SDL_VirtualJoystickTouchpadDesc touchpad = {};
+    touchpad.nfingers = 2;
+    if (options.touchpad) {
+        desc.ntouchpads = 1;
+        desc.touchpads = &touchpad;
+    }
+    m_id = SDL_AttachVirtualJoystick(&desc);
+    if (m_id == 0) {
+        throw std::runtime_error(std::string("Failed to attach a virtual joystick: ") + SDL_GetError());
+    }
+    m_joystick = SDL_OpenJoystick(m_id);
+    if (!m_joystick) {
+        SDL_DetachVirtualJoystick(m_id);
+        throw std::runtime_error(std::string("Failed to open the virtual joystick: ") + SDL_GetError());
+    }
+    // Triggers rest released, at the bottom of the joystick range
+    setTrigger(SDL_GAMEPAD_AXIS_LEFT_TRIGGER, 0);
+    setTrigger(SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, 0);
+}
+
+VirtualPad::~VirtualPad() {
+    detach();
+}
+
+void VirtualPad::setAxis(SDL_GamepadAxis axis, Sint16 value) {
+    SDL_SetJoystickVirtualAxis(m_joystick, axis, value);
+}
+
+void VirtualPad::setTrigger(SDL_GamepadAxis axis, int pull) {
+    // SDL maps the full joystick range of a trigger axis onto 0..32767
+    int value = std::clamp(pull * 2 - 32768, -32768, 32767);
+    SDL_SetJoystickVirtualAxis(m_joystick, axis, static_cast<Sint16>(value));
+}
+
+void VirtualPad::setButton(SDL_GamepadButton button, bool down) {
+    SDL_SetJoystickVirtualButton(m_joystick, button, down);
+}
+
+void VirtualPad::sendGyro(uint64_t sensor_timestamp_ns, float pitch, float yaw) {
+    // SDL reports gyro rates in radians per second
+    constexpr float kRadiansPerDegree = 0.017453293f;
+    const float data[3] = {pitch * kRadiansPerDegree, yaw * kRadiansPerDegree, 0.0f};
+    SDL_SendJoystickVirtualSensorData(m_joystick, SDL_SENSOR_GYRO, sensor_timestamp_ns, data, 3);
+}
+
+void VirtualPad::setFinger(int finger, bool down, float x, float y) {
+    SDL_SetJoystickVirtualTouchpad(m_joystick, 0, finger, down, x, y, down ? 1.0f : 0.0f);
+}
+
+void VirtualPad::detach() {
+    if (m_joystick) {
+        SDL_CloseJoystick(m_joystick);
+        m_joystick = nullptr;
+    }
+    if (m_id != 0) {
+        SDL_DetachVirtualJoystick(m_id);
+        m_id = 0;
+    }
+}
+
+CoreDriver::CoreDriver(std::unique_ptr<OutputSink> forward_to)
+    : m_manager(createControllerManager()), m_clock(std::make_shared<ManualClock>(kNsPerSecond)) {
+    auto output = std::make_unique<RecordingOutputSink>(std::move(forward_to));
+    m_output = output.get();
+    m_manager->setOutputSink(std::move(output));
+    m_manager->setClock(m_clock);
+}
+
+CoreDriver::~CoreDriver() = default;
+
+void CoreDriver::frame(uint64_t ms) {
+    m_clock->advanceMs(ms);
+    m_manager->pollEvents();
+}
+
+void CoreDriver::frames(int count, uint64_t ms) {
+    for (int i = 0; i < count; ++i) {
+        frame(ms);
+    }
+}
+
+int CoreDriver::sumA(OutputCommandType type) const {
+    int sum = 0;
+    for (const OutputCommand& command : output()) {
+        if (command.type == type) {
+            sum += command.a;
+        }
+    }
+    return sum;
+}
+
+int CoreDriver::sumB(OutputCommandType type) const {
+    int sum = 0;
+    for (const OutputCommand& command : output()) {
+        if (command.type == type) {
+            sum += command.b;
+        }
+    }
+    return sum;
+}
+
+size_t CoreDriver::count(OutputCommandType type) const {
+    return std::count_if(output().begin(), output().end(),
+                         [type](const OutputCommand& command) { return command.type == type; });
+}
+
+size_t CoreDriver::count(OutputCommandType type, int a) const {
+    return std::count_if(output().begin(), output().end(),
+                         [type, a](const OutputCommand& command) { return command.type == type && command.a == a; });
+}
@@ -0,0 +1,187 @@
+// test_support.h
+// Shared pieces of the JoyCursorTests executable: test and benchmark
+// registration, checks, a scratch working directory for the config files,
+// SDL virtual gamepads and a core driven by a simulated clock.
+
+#pragma once
+
+#include "core/clock.h"
+#include "core/controller_manager.h"
+#include "core/output_sink.h"
+#include <SDL3/SDL.h>
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// --- Registration ---
+
+using TestFunction = void (*)();
+using BenchFunction = void (*)(const std::vector<std::string>& args);
+
+struct TestRegistrar {
+    TestRegistrar(const char* name, TestFunction run);
+};
+struct BenchRegistrar {
+    BenchRegistrar(const char* name, BenchFunction run);
+};
+
+// A test passes when it returns and fails when a CHECK throws
+#define JOYCURSOR_TEST(name)                                    \
+    static void name();                                         \
+    static const TestRegistrar name##_registrar(#name, &name); \
+    static void name()
+
+// A benchmark prints its measurements; args are the command line after its name
+#define JOYCURSOR_BENCH(name)                                                 \
+    static void name(const std::vector<std::string>& args);                   \
+    static const BenchRegistrar name##_registrar(#name, &name);               \
+    static void name(const std::vector<std::string>& args)
+
+struct TestFailure : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+// Thrown when the machine lacks something the test needs (ctest reports it as skipped)
+struct TestSkipped : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+[[noreturn]] void failCheck(const char* file, int line, const std::string& message);
+
+#define CHECK(condition)                                        \
+    do {                                                        \
+        if (!(condition)) failCheck(__FILE__, __LINE__, #condition); \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                         \
+    do {                                                                                   \
+        auto check_actual_ = (actual);                                                     \
+        auto check_expected_ = (expected);                                                 \
+        if (!(check_actual_ == check_expected_)) {                                         \
+            failCheck(__FILE__, __LINE__, std::string(#actual " == " #expected " (got ") + \
+                      std::to_string(check_actual_) + ", expected " +                      \
+                      std::to_string(check_expected_) + ")");                              \
+        }                                                                                  \
+    } while (0)
+
+// --- Files ---
+
+// Creates an empty temporary directory and makes it the working directory,
+// where the core reads and writes its config files. Both are undone on destruction.
+class ScratchDirectory {
+public:
+    ScratchDirectory();
+    ~ScratchDirectory();
+    ScratchDirectory(const ScratchDirectory&) = delete;
+    ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+    const std::filesystem::path& path() const { return m_path; }
+
+private:
+    std::filesystem::path m_path;
+    std::filesystem::path m_previous;
+};
+
+void writeTextFile(const std::string& path, const std::string& text);
+void writeJsonFile(const std::string& path, const nlohmann::json& json);
+
+// settings.json for a core whose output is replaced by the test
+nlohmann::json testSettings();
+// mappings.json with only a "default" profile. Inputs the profile leaves
+// out are disabled, so a test switches on just what it exercises.
+void writeMappings(const nlohmann::json& default_profile);
+
+// Buttons set in fullDefaultProfile() and overridden by writeProfileFiles()
+constexpr int kProfileButtonCount = 6;
+extern const char* const kProfileButtons[kProfileButtonCount];
+
+// A distinct controller GUID for each index
+std::string testGuid(int index);
+// A "default" profile with both sticks and kProfileButtons mapped
+nlohmann::json fullDefaultProfile();
+// mappings.json with fullDefaultProfile() and a profile for each of guid_count
+// controllers overriding a few of its fields, and the matching controllers.json
+void writeProfileFiles(int guid_count);
+
+// --- Measurements ---
+
+// Peak resident set size of the process so far, in KiB
+long peakRssKb();
+// Current resident set size, in KiB
+long currentRssKb();
+
+// Percentile (0-100) of the samples, which are sorted in place
+double percentile(std::vector<double>& samples, double p);
+
+// Wall-clock time on the steady clock, in nanoseconds
+uint64_t steadyNowNs();
+
+// --- Controllers ---
+
+// Hardware a VirtualPad has beyond the standard gamepad layout
+struct VirtualPadOptions {
+    bool gyro = false;     // Reports at kVirtualGyroRate
+    bool touchpad = false; // One touchpad tracking two fingers
+};
+
+constexpr float kVirtualGyroRate = 200.0f;
+
+// An SDL virtual joystick with the standard gamepad layout. SDL reports it
+// like a physical gamepad, so the core opens and maps it the same way.
+// SDL must be initialized (the controller manager does this).
+class VirtualPad {
+public:
+    explicit VirtualPad(const char* name = "JoyCursor Test Pad", VirtualPadOptions options = VirtualPadOptions());
+    ~VirtualPad();
+    VirtualPad(const VirtualPad&) = delete;
+    VirtualPad& operator=(const VirtualPad&) = delete;
+
+    SDL_JoystickID id() const { return m_id; }
+
+    void setAxis(SDL_GamepadAxis axis, Sint16 value);
+    // Trigger pull in the gamepad range 0..32767
+    void setTrigger(SDL_GamepadAxis axis, int pull);
+    void setButton(SDL_GamepadButton button, bool down);
+    // One gyro reading in degrees per second around the pad's x (pitch) and
+    // y (yaw) axes, stamped with the sensor's own clock
+    void sendGyro(uint64_t sensor_timestamp_ns, float pitch, float yaw);
+    // Puts a finger down on the touchpad, moves it or lifts it; x and y are 0..1
+    void setFinger(int finger, bool down, float x, float y);
+    // Removes the device; the destructor then does nothing
+    void detach();
+
+private:
+    SDL_JoystickID m_id = 0;
+    SDL_Joystick* m_joystick = nullptr;
+};
+
+// A controller manager that records its output and runs on a simulated
+// clock. Each frame() advances the clock and polls once. Recorded output is
+// also passed on to forward_to when one is given.
+class CoreDriver {
+public:
+    explicit CoreDriver(std::unique_ptr<OutputSink> forward_to = nullptr);
+    ~CoreDriver();
+
+    ControllerManager& manager() { return *m_manager; }
+    ManualClock& clock() { return *m_clock; }
+    const std::vector<OutputCommand>& output() const { return m_output->recorded(); }
+    void clearOutput() { m_output->clearRecorded(); }
+
+    void frame(uint64_t ms);
+    void frames(int count, uint64_t ms);
+
+    // Sum of a and b over the recorded commands of one type
+    int sumA(OutputCommandType type) const;
+    int sumB(OutputCommandType type) const;
+    size_t count(OutputCommandType type) const;
+    size_t count(OutputCommandType type, int a) const;
+
+private:
+    std::unique_ptr<ControllerManager> m_manager;
+    std::shared_ptr<ManualClock> m_clock;
+    RecordingOutputSink* m_output = nullptr; // Owned by the manager
+};
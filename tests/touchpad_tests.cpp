@@ -0,0 +1,140 @@
+// touchpad_tests.cpp
+// Trackpad mode fed through a virtual pad's touchpad: one finger moves the
+// cursor, two fingers scroll, and short touches that stay put click.
+
+#include "test_support.h"
+#include <cstdlib>
+
+namespace {
+
+constexpr uint64_t kFrameMs = 10;
+constexpr float kSensitivity = 1000.0f;      // Pixels per pad width
+constexpr float kScrollSensitivity = 1200.0f; // Scroll units per pad height
+// The pad is half as tall as it is wide; see TOUCHPAD_ASPECT
+constexpr float kPadAspect = 0.5f;
+
+// Without acceleration, motion depends only on how far a finger travels
+nlohmann::json touchpadProfile(bool tap_to_click) {
+    return {{"touchpad", {{"enabled", true}, {"sensitivity", kSensitivity}, {"acceleration", 0.0},
+                          {"scroll_sensitivity", kScrollSensitivity}, {"tap_to_click", tap_to_click},
+                          {"tap_time", 180}, {"tap_distance", 0.02}}}};
+}
+
+class TouchRig {
+public:
+    explicit TouchRig(bool tap_to_click = true) {
+        writeJsonFile("settings.json", testSettings());
+        writeMappings(touchpadProfile(tap_to_click));
+        m_core = std::make_unique<CoreDriver>();
+        VirtualPadOptions options;
+        options.touchpad = true;
+        m_pad = std::make_unique<VirtualPad>("JoyCursor Touch Pad", options);
+        m_core->frame(kFrameMs);
+        m_core->clearOutput();
+    }
+
+    CoreDriver& core() { return *m_core; }
+
+    // Sets the fingers that are down and polls once
+    void touch(std::initializer_list<std::pair<float, float>> fingers) {
+        int finger = 0;
+        for (const auto& [x, y] : fingers) {
+            m_pad->setFinger(finger++, true, x, y);
+        }
+        for (; finger < 2; ++finger) {
+            m_pad->setFinger(finger, false, 0.0f, 0.0f);
+        }
+        m_core->frame(kFrameMs);
+    }
+
+    // Slides the given fingers together by (dx, dy) in steps, one poll each
+    void slide(std::initializer_list<std::pair<float, float>> fingers, float dx, float dy, int steps) {
+        for (int step = 1; step <= steps; ++step) {
+            int finger = 0;
+            for (const auto& [x, y] : fingers) {
+                m_pad->setFinger(finger++, true, x + dx * step / steps, y + dy * step / steps);
+            }
+            m_core->frame(kFrameMs);
+        }
+    }
+
+    void lift() { touch({}); }
+
+    size_t clicks(MouseClickType click) const {
+        return m_core->count(OutputCommandType::MOUSE_BUTTON_DOWN, static_cast<int>(click));
+    }
+
+private:
+    std::unique_ptr<CoreDriver> m_core;
+    std::unique_ptr<VirtualPad> m_pad;
+};
+
+} // namespace
+
+JOYCURSOR_TEST(touchpad_one_finger_cursor) {
+    ScratchDirectory scratch;
+    TouchRig rig;
+    rig.touch({{0.2f, 0.3f}});
+    rig.slide({{0.2f, 0.3f}}, 0.1f, 0.0f, 10);
+    rig.slide({{0.3f, 0.3f}}, 0.0f, 0.2f, 10);
+    rig.lift();
+
+    // Both axes move the same distance per unit of finger travel on the glass
+    const int expected_x = static_cast<int>(0.1f * kSensitivity);
+    const int expected_y = static_cast<int>(0.2f * kPadAspect * kSensitivity);
+    CHECK(std::abs(rig.core().sumA(OutputCommandType::MOUSE_MOVE) - expected_x) <= 1);
+    CHECK(std::abs(rig.core().sumB(OutputCommandType::MOUSE_MOVE) - expected_y) <= 1);
+    // A drag is not a tap
+    CHECK_EQ(rig.core().count(OutputCommandType::MOUSE_BUTTON_DOWN), 0u);
+    CHECK_EQ(rig.core().count(OutputCommandType::SCROLL_VERTICAL), 0u);
+}
+
+JOYCURSOR_TEST(touchpad_two_finger_scroll) {
+    ScratchDirectory scratch;
+    TouchRig rig;
+    rig.touch({{0.4f, 0.2f}, {0.6f, 0.2f}});
+    rig.slide({{0.4f, 0.2f}, {0.6f, 0.2f}}, 0.0f, 0.5f, 10);
+    rig.lift();
+
+    // Content follows the fingers: dragging down scrolls up, by the share of
+    // the pad's height the fingers travelled
+    const int expected = static_cast<int>(0.5f * kScrollSensitivity);
+    CHECK(std::abs(rig.core().sumA(OutputCommandType::SCROLL_VERTICAL) - expected) <= 1);
+    CHECK_EQ(rig.core().sumA(OutputCommandType::SCROLL_HORIZONTAL), 0);
+    CHECK_EQ(rig.core().count(OutputCommandType::MOUSE_MOVE), 0u);
+    CHECK_EQ(rig.core().count(OutputCommandType::MOUSE_BUTTON_DOWN), 0u);
+}
+
+JOYCURSOR_TEST(touchpad_tap_to_click) {
+    ScratchDirectory scratch;
+    {
+        TouchRig rig;
+        // A one-finger tap left clicks, with a little jitter under tap_distance
+        rig.touch({{0.5f, 0.5f}});
+        rig.touch({{0.505f, 0.505f}});
+        rig.lift();
+        CHECK_EQ(rig.clicks(MouseClickType::LEFT_CLICK), 1u);
+        CHECK_EQ(rig.core().count(OutputCommandType::MOUSE_BUTTON_UP), 1u);
+        rig.core().clearOutput();
+
+        // Two fingers tapping right click, even when they land and lift apart
+        rig.touch({{0.3f, 0.5f}});
+        rig.touch({{0.3f, 0.5f}, {0.6f, 0.5f}});
+        rig.touch({{0.3f, 0.5f}});
+        rig.lift();
+        CHECK_EQ(rig.clicks(MouseClickType::RIGHT_CLICK), 1u);
+        CHECK_EQ(rig.clicks(MouseClickType::LEFT_CLICK), 0u);
+        rig.core().clearOutput();
+
+        // A touch that moves past tap_distance is a drag
+        rig.touch({{0.5f, 0.5f}});
+        rig.touch({{0.55f, 0.5f}});
+        rig.lift();
+        CHECK_EQ(rig.core().count(OutputCommandType::MOUSE_BUTTON_DOWN), 0u);
+    }
+
+    TouchRig rig(false);
+    rig.touch({{0.5f, 0.5f}});
+    rig.lift();
+    CHECK_EQ(rig.core().count(OutputCommandType::MOUSE_BUTTON_DOWN), 0u);
+}
@@ -0,0 +1,119 @@
+// trigger_tests.cpp
+// Replays recorded trigger pulls, one value per 10 ms frame, through the
+// button (with hysteresis), two-stage and brake trigger modes and checks
+// the output of every frame.
+
+#include "test_support.h"
+#include <cstdlib>
+#include <iterator>
+
+namespace {
+
+constexpr uint64_t kFrameMs = 10;
+
+nlohmann::json keyButton(const char* action) {
+    return {{"enabled", true}, {"actions", {{{"action_type", action}, {"enabled", true}}}}};
+}
+
+std::string keyName(int key) {
+    switch (static_cast<KeyboardKeyType>(key)) {
+        case KeyboardKeyType::ENTER: return "enter";
+        case KeyboardKeyType::ESCAPE: return "escape";
+        default: return std::to_string(key);
+    }
+}
+
+// Plays trace on the left trigger and lists the key edges it produced, as
+// "<frame>:<down|up> <key>" joined with commas
+std::string playKeyTrace(const nlohmann::json& trigger, const std::vector<int>& trace) {
+    ScratchDirectory scratch;
+    writeJsonFile("settings.json", testSettings());
+    writeMappings({{"triggers", {{"left_trigger", trigger}}}});
+    CoreDriver core;
+    VirtualPad pad;
+    core.frame(kFrameMs);
+    core.clearOutput();
+
+    std::string edges;
+    for (size_t frame = 0; frame < trace.size(); ++frame) {
+        pad.setTrigger(SDL_GAMEPAD_AXIS_LEFT_TRIGGER, trace[frame]);
+        core.frame(kFrameMs);
+        for (const OutputCommand& command : core.output()) {
+            bool down = command.type == OutputCommandType::KEYBOARD_DOWN;
+            if (!down && command.type != OutputCommandType::KEYBOARD_UP) {
+                continue;
+            }
+            edges += (edges.empty() ? "" : ",") + std::to_string(frame) + (down ? ":down " : ":up ") +
+                     keyName(command.a);
+        }
+        core.clearOutput();
+    }
+    return edges;
+}
+
+// A slow pull that hovers around the threshold before letting go, with the
+// sensor noise of a worn trigger
+const std::vector<int> kHoverTrace = {
+    0, 8000, 15500, 16200, 15800, 16100, 15000, 13000, 12500, 16300, 12100, 11900, 12500, 15900, 16050, 0
+};
+
+} // namespace
+
+JOYCURSOR_TEST(trigger_hysteresis_trace) {
+    nlohmann::json trigger = {{"enabled", true}, {"action_type", "button"}, {"threshold", 16000},
+                              {"button_action", keyButton("keyboard_enter")}};
+
+    // With the default release point just under the threshold the noise
+    // around it presses and releases the key again
+    CHECK(playKeyTrace(trigger, kHoverTrace) ==
+          "3:down enter,7:up enter,9:down enter,10:up enter,14:down enter,15:up enter");
+
+    // A release threshold well below it holds the key until the trigger is let go
+    trigger["release_threshold"] = 12000;
+    CHECK(playKeyTrace(trigger, kHoverTrace) ==
+          "3:down enter,11:up enter,14:down enter,15:up enter");
+}
+
+JOYCURSOR_TEST(trigger_two_stage_trace) {
+    nlohmann::json trigger = {{"enabled", true}, {"action_type", "button"}, {"threshold", 8000},
+                              {"full_pull_threshold", 30000},
+                              {"button_action", keyButton("keyboard_enter")},
+                              {"full_pull_action", keyButton("keyboard_escape")}};
+    // Half pull, full pull with a wobble at the top, back to half, out, then
+    // a snap to full and release within single frames
+    std::vector<int> trace = {0, 9000, 20000, 30500, 29500, 28500, 31000, 20000, 7500, 6500, 32767, 0};
+
+    // The second stage nests inside the first: it presses after and releases before it
+    CHECK(playKeyTrace(trigger, trace) ==
+          "1:down enter,3:down escape,5:up escape,6:down escape,7:up escape,9:up enter,"
+          "10:down enter,10:down escape,11:up escape,11:up enter");
+}
+
+JOYCURSOR_TEST(trigger_brake_trace) {
+    ScratchDirectory scratch;
+    writeJsonFile("settings.json", testSettings());
+    // Full tilt moves 6000 pixels per second, 60 per frame, without smoothing or acceleration
+    writeMappings({
+        {"left_stick", {{"enabled", true}, {"action_type", "cursor"}, {"deadzone", 8000}, {"calibrate", false},
+                        {"cursor_action", {{"sensitivity", 1.0}, {"smoothing", 1.0},
+                                           {"acceleration", {{"curve", "linear"}, {"ramp_time", 0.0}}}}}}},
+        {"triggers", {{"right_trigger", {{"enabled", true}, {"action_type", "brake"}, {"threshold", 4000},
+                                         {"brake_strength", 0.75}}}}}
+    });
+    CoreDriver core;
+    VirtualPad pad;
+    core.frame(kFrameMs);
+    pad.setAxis(SDL_GAMEPAD_AXIS_LEFTX, 32767);
+    core.frames(5, kFrameMs);
+
+    // Pull and release; the brake scales speed by 1 - strength * pressure past the threshold
+    const int pulls[] = {0, 2000, 4000, 18384, 32767, 32767, 18384, 0};
+    const double expected[] = {60, 60, 60, 37.5, 15, 15, 37.5, 60};
+    for (size_t frame = 0; frame < std::size(pulls); ++frame) {
+        pad.setTrigger(SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, pulls[frame]);
+        core.clearOutput();
+        core.frame(kFrameMs);
+        int moved = core.sumA(OutputCommandType::MOUSE_MOVE);
+        CHECK(std::abs(moved - expected[frame]) <= 1.0);
+    }
+}
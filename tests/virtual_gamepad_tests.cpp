@@ -0,0 +1,205 @@
+// virtual_gamepad_tests.cpp
+// Forwards an SDL virtual joystick to the uinput virtual gamepad and reads
+// the forwarded values back from the evdev node the kernel creates for it.
+
+#include "test_support.h"
+
+#ifdef __linux__
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <map>
+#include <poll.h>
+#include <set>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr int kSamples = 300;
+constexpr uint64_t kReportTimeoutNs = 500 * kNsPerMs;
+constexpr uint64_t kNodeTimeoutNs = 2 * kNsPerSecond;
+
+// Forwards every input unchanged: no stick deadzone or response curve
+nlohmann::json forwardingProfile() {
+    nlohmann::json stick = {{"deadzone", 0}, {"response_exponent", 1.0}};
+    return {{"gamepad_output", {{"enabled", true}}}, {"left_stick", stick}, {"right_stick", stick}};
+}
+
+std::set<std::string> eventNodes() {
+    std::set<std::string> nodes;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/dev/input", ec)) {
+        if (entry.path().filename().string().rfind("event", 0) == 0) {
+            nodes.insert(entry.path().string());
+        }
+    }
+    return nodes;
+}
+
+// One evdev report: the values it changed, keyed by event type and code,
+// and when the kernel received it on the steady clock
+struct Report {
+    std::map<std::pair<int, int>, int> values;
+    uint64_t time_ns = 0;
+};
+
+// The evdev node of a virtual gamepad, read without grabbing it
+class EvdevReader {
+public:
+    explicit EvdevReader(int fd) : m_fd(fd) {
+        // Timestamp events on the clock steadyNowNs() reads
+        int clock = CLOCK_MONOTONIC;
+        ioctl(m_fd, EVIOCSCLOCKID, &clock);
+    }
+    ~EvdevReader() { close(m_fd); }
+    EvdevReader(const EvdevReader&) = delete;
+    EvdevReader& operator=(const EvdevReader&) = delete;
+
+    // Waits for the next complete report; false if none arrives in time
+    bool read(Report& report) {
+        report = Report();
+        uint64_t deadline = steadyNowNs() + kReportTimeoutNs;
+        for (;;) {
+            input_event event;
+            ssize_t n = ::read(m_fd, &event, sizeof(event));
+            if (n == sizeof(event)) {
+                if (event.type == EV_SYN && event.code == SYN_REPORT) {
+                    report.time_ns = event.input_event_sec * kNsPerSecond + event.input_event_usec * 1000ull;
+                    return true;
+                }
+                report.values[{event.type, event.code}] = event.value;
+                continue;
+            }
+            if (n < 0 && errno != EAGAIN) {
+                return false;
+            }
+            uint64_t now = steadyNowNs();
+            if (now >= deadline) {
+                return false;
+            }
+            pollfd pending = {m_fd, POLLIN, 0};
+            poll(&pending, 1, static_cast<int>((deadline - now) / kNsPerMs) + 1);
+        }
+    }
+
+private:
+    int m_fd;
+};
+
+// Opens the virtual gamepad node that appeared since before was listed
+int openGamepadNode(const std::set<std::string>& before) {
+    uint64_t deadline = steadyNowNs() + kNodeTimeoutNs;
+    bool denied = false;
+    do {
+        for (const std::string& node : eventNodes()) {
+            if (before.count(node)) {
+                continue;
+            }
+            int fd = open(node.c_str(), O_RDONLY | O_NONBLOCK);
+            if (fd < 0) {
+                denied = denied || errno == EACCES;
+                continue;
+            }
+            char name[256] = {};
+            if (ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name) >= 0 && std::strcmp(name, kVirtualGamepadName) == 0) {
+                return fd;
+            }
+            close(fd);
+        }
+        usleep(10000);
+    } while (steadyNowNs() < deadline);
+    if (denied) {
+        throw TestSkipped("the new /dev/input nodes are not readable");
+    }
+    return -1;
+}
+
+// Value of the last command sent for a virtual gamepad axis
+int recordedAxis(const CoreDriver& core, SDL_GamepadAxis axis) {
+    int value = -1;
+    for (const OutputCommand& command : core.output()) {
+        if (command.type == OutputCommandType::GAMEPAD_AXIS && command.a == axis) {
+            value = command.b;
+        }
+    }
+    return value;
+}
+
+} // namespace
+
+JOYCURSOR_TEST(virtual_gamepad_forwarding) {
+    if (access("/dev/uinput", W_OK) != 0) {
+        throw TestSkipped("/dev/uinput is not writable");
+    }
+    ScratchDirectory scratch;
+    writeJsonFile("settings.json", testSettings());
+    writeMappings(forwardingProfile());
+
+    std::set<std::string> before = eventNodes();
+    CoreDriver core(createPlatformOutputSink());
+    VirtualPad pad;
+    core.manager().pollEvents();
+    CHECK(core.manager().hasActiveController());
+    int fd = openGamepadNode(before);
+    CHECK(fd >= 0);
+    EvdevReader device(fd);
+    core.clearOutput();
+
+    std::vector<double> evdev_latency_us;
+    for (int i = 0; i < kSamples; ++i) {
+        // Every input changes each sample, since evdev drops values that repeat
+        int pull = (i * 2311 + 1000) % 32768;
+        int stick = (i * 7919) % 65534 - 32767;
+        bool pressed = i % 2 == 0;
+
+        uint64_t input_ns = steadyNowNs();
+        pad.setTrigger(SDL_GAMEPAD_AXIS_RIGHT_TRIGGER, pull);
+        pad.setAxis(SDL_GAMEPAD_AXIS_LEFTX, static_cast<Sint16>(stick));
+        pad.setButton(SDL_GAMEPAD_BUTTON_SOUTH, pressed);
+        core.manager().pollEvents();
+
+        Report report;
+        Report merged;
+        auto complete = [&merged] {
+            return merged.values.count({EV_ABS, ABS_RZ}) && merged.values.count({EV_ABS, ABS_X}) &&
+                   merged.values.count({EV_KEY, BTN_SOUTH});
+        };
+        while (!complete() && device.read(report)) {
+            for (const auto& [code, value] : report.values) {
+                merged.values[code] = value;
+            }
+            merged.time_ns = report.time_ns;
+        }
+        CHECK(complete());
+        evdev_latency_us.push_back(merged.time_ns > input_ns ? (merged.time_ns - input_ns) / 1e3 : 0.0);
+
+        // The device reports exactly what the core sent, and that matches the input
+        int trigger = merged.values[{EV_ABS, ABS_RZ}];
+        int stick_x = merged.values[{EV_ABS, ABS_X}];
+        int button = merged.values[{EV_KEY, BTN_SOUTH}];
+        CHECK_EQ(trigger, recordedAxis(core, SDL_GAMEPAD_AXIS_RIGHT_TRIGGER));
+        CHECK(std::abs(trigger - pull) <= 1); // SDL rescales the trigger's joystick range
+        CHECK_EQ(stick_x, stick);
+        CHECK_EQ(button, pressed ? 1 : 0);
+        core.clearOutput();
+    }
+
+    // Every forwarded event is timed from its dequeue on the core's own clock;
+    // the simulated clock does not move within a poll
+    CoreStats stats = core.manager().getStats();
+    CHECK(stats.gamepad_latency.count >= uint64_t(kSamples) * 3);
+    CHECK_EQ(stats.gamepad_latency.buckets[0], stats.gamepad_latency.count);
+    std::printf("gamepad latency p99 to evdev: %.1f us\n", percentile(evdev_latency_us, 99));
+
+    pad.detach();
+    core.manager().pollEvents();
+    CHECK(!core.manager().hasActiveController());
+}
+
+#endif // __linux__